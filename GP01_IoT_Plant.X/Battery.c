@@ -0,0 +1,335 @@
+/*******************************************************************************
+ * File: Battery.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Battery charge and runtime estimate. See Battery.h
+ *
+ * Hardware Description: Pack voltage divider on AN2 (RB0)
+ *
+ * Created October 20th, 2026, 11:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "IoT_Plant_Specific.h"
+#include "adc.h"
+#include "Classifier.h"
+#include "Low_Power.h"
+#include "Battery.h"
+
+#define BATTERY_TICKS_PER_S (FCY / TMR1_TIMESTAMP_PRESCALER)
+
+// Full charge in mA seconds
+#define BATTERY_CAPACITY_MAS ((uint32_t)BATTERY_CAPACITY_MAH * 3600)
+
+// Charge below the voltage estimate by more than this is corrected
+#define BATTERY_CORRECT_PCT 10
+
+// Ni-MH cell voltage under light load against charge left, every 10 %
+static const uint16_t battery_curve[11] =
+{
+    1100, 1180, 1200, 1215, 1225, 1235, 1245, 1260, 1280, 1310, 1370
+};
+
+static uint32_t battery_charge;         // mA seconds left
+static uint32_t battery_used;           // mA seconds since start up
+static uint32_t battery_seconds;        // seconds since start up
+static uint32_t battery_last;           // timestamp accounted up to
+static uint32_t battery_slept;          // sleep ticks accounted up to
+static uint32_t battery_sample;         // timestamp of the next voltage sample
+static uint16_t battery_load = BATTERY_ACTIVE_MA;
+static uint16_t battery_mv;
+
+static const uint16_t battery_edges[] = {BATTERY_CRITICAL_PCT, BATTERY_LOW_PCT};
+static const CLASSIFIER_CONFIG battery_config =
+{
+    battery_edges, 3, 2, 1, 1, 0
+};
+static CLASSIFIER battery_level;
+
+/*******************************************************************************
+ * Function:        static uint16_t Battery_ReadMillivolts(void)
+ *
+ * Overview:        Pack voltage from the latest ADC result
+ ******************************************************************************/
+static uint16_t Battery_ReadMillivolts(void)
+{
+    uint32_t counts = ADC_Read(ADC_CHANNEL_BATTERY);
+
+    return counts * BATTERY_VDD_MV * BATTERY_DIVIDER / ADC_FULL_SCALE;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Battery_VoltagePercent(uint16_t mv)
+ *
+ * Overview:        Charge left from the pack voltage, interpolated on the
+ *                  cell curve
+ ******************************************************************************/
+static uint8_t Battery_VoltagePercent(uint16_t mv)
+{
+    uint16_t cell = mv / BATTERY_CELLS;
+    uint8_t i;
+
+    if (cell <= battery_curve[0])
+    {
+        return 0;
+    }
+
+    for (i = 1; i < 11; i++)
+    {
+        if (cell < battery_curve[i])
+        {
+            return (i - 1) * 10 + (cell - battery_curve[i - 1]) * 10 /
+                   (battery_curve[i] - battery_curve[i - 1]);
+        }
+    }
+
+    return 100;
+}
+
+/*******************************************************************************
+ * Function:        void Battery_Init(void)
+ *
+ * PreCondition:    ADC_SetMode() should have been called and a first result
+ *                  be available
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Starts the charge count from the pack voltage
+ *
+ * Usage:           Battery_Init();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Battery_Init(void)
+{
+    battery_mv = Battery_ReadMillivolts();
+    battery_charge = BATTERY_CAPACITY_MAS / 100 *
+                     Battery_VoltagePercent(battery_mv);
+    battery_used = 0;
+    battery_seconds = 0;
+    battery_last = TMR1_TimestampGet();
+    battery_slept = Low_Power_SleepTicks();
+    battery_sample = battery_last + (uint32_t)BATTERY_SAMPLE_S *
+                     BATTERY_TICKS_PER_S;
+
+    Classifier_Init(&battery_level, &battery_config);
+    Classifier_Update(&battery_level, Battery_Percent(), battery_last);
+}
+
+/*******************************************************************************
+ * Function:        bool Battery_Tasks(void)
+ *
+ * PreCondition:    Battery_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          true when a new voltage sample was taken
+ *
+ * Overview:        Counts down the charge used since the last call at the
+ *                  present load, less the MCU current while asleep, and
+ *                  samples the voltage when it is due
+ *
+ * Usage:           if (Battery_Tasks()) printf(...);
+ *
+ * Note:            Call at least once every 9 hours so the tick count
+ *                  does not wrap between calls
+ ******************************************************************************/
+bool Battery_Tasks(void)
+{
+    uint32_t now = TMR1_TimestampGet();
+    uint32_t seconds = (now - battery_last) / BATTERY_TICKS_PER_S;
+    uint32_t slept = (Low_Power_SleepTicks() - battery_slept) /
+                     BATTERY_TICKS_PER_S;
+    uint32_t used;
+    uint32_t floor;
+
+    if (slept > seconds)
+    {
+        slept = seconds;
+    }
+    used = seconds * battery_load - slept * BATTERY_MCU_MA;
+
+    // Whole seconds only, the rest is counted on a later call
+    battery_last += seconds * BATTERY_TICKS_PER_S;
+    battery_slept += slept * BATTERY_TICKS_PER_S;
+    battery_seconds += seconds;
+    battery_used += used;
+    battery_charge = (battery_charge > used) ? battery_charge - used : 0;
+
+    if ((int32_t)(now - battery_sample) < 0)
+    {
+        return false;
+    }
+
+    battery_sample += (uint32_t)BATTERY_SAMPLE_S * BATTERY_TICKS_PER_S;
+    battery_mv = Battery_ReadMillivolts();
+
+    // The count drifts with the configured currents, the voltage shows
+    // when the pack is emptier than counted
+    floor = BATTERY_CAPACITY_MAS / 100 *
+            (Battery_VoltagePercent(battery_mv) + BATTERY_CORRECT_PCT);
+    if (battery_charge > floor)
+    {
+        battery_charge = floor;
+    }
+
+    Classifier_Update(&battery_level, Battery_Percent(), now);
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        void Battery_SetLoad(uint16_t milliamps)
+ *
+ * PreCondition:    Battery_Init() should have been called
+ *
+ * Input:           Current drawn in the power mode being entered
+ *
+ * Output:          None
+ *
+ * Overview:        Accounts for the time at the old load and switches to
+ *                  the new one
+ *
+ * Usage:           Battery_SetLoad(BATTERY_SAVER_MA);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Battery_SetLoad(uint16_t milliamps)
+{
+    Battery_Tasks();
+    battery_load = milliamps;
+}
+
+/*******************************************************************************
+ * Function:        uint16_t Battery_Millivolts(void)
+ *
+ * PreCondition:    Battery_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          Pack voltage at the last sample, in mV
+ *
+ * Overview:        Returns the last voltage sample
+ *
+ * Usage:           mv = Battery_Millivolts();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint16_t Battery_Millivolts(void)
+{
+    return battery_mv;
+}
+
+/*******************************************************************************
+ * Function:        uint8_t Battery_Percent(void)
+ *
+ * PreCondition:    Battery_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          Charge left, 0 to 100 %
+ *
+ * Overview:        Returns the counted charge as a percentage
+ *
+ * Usage:           pct = Battery_Percent();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint8_t Battery_Percent(void)
+{
+    uint32_t pct = battery_charge / (BATTERY_CAPACITY_MAS / 100);
+
+    return (pct > 100) ? 100 : pct;
+}
+
+/*******************************************************************************
+ * Function:        uint16_t Battery_RuntimeMinutes(void)
+ *
+ * PreCondition:    Battery_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          Minutes until the pack is empty
+ *
+ * Overview:        Divides the charge left by the average current since
+ *                  start up, or the present load until a minute has passed
+ *
+ * Usage:           minutes = Battery_RuntimeMinutes();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint16_t Battery_RuntimeMinutes(void)
+{
+    uint32_t average = battery_load;
+    uint32_t minutes;
+
+    if (battery_seconds >= 60)
+    {
+        average = battery_used / battery_seconds;
+    }
+
+    if (average == 0)
+    {
+        return UINT16_MAX;
+    }
+
+    minutes = battery_charge / average / 60;
+
+    return (minutes > UINT16_MAX) ? UINT16_MAX : minutes;
+}
+
+/*******************************************************************************
+ * Function:        BatteryLevel Battery_Level(void)
+ *
+ * PreCondition:    Battery_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          BATTERY_OK, BATTERY_LOW or BATTERY_CRITICAL
+ *
+ * Overview:        Charge level against BATTERY_LOW_PCT and
+ *                  BATTERY_CRITICAL_PCT, with a 2 % hysteresis
+ *
+ * Usage:           if (Battery_Level() != BATTERY_OK) ...
+ *
+ * Note:            None
+ ******************************************************************************/
+BatteryLevel Battery_Level(void)
+{
+    return (BatteryLevel)Classifier_State(&battery_level);
+}
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * File: Battery.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Battery charge and runtime estimate for the Ni-MH
+ *                      pack.
+ *
+ *                      The charge is counted down from the current drawn in
+ *                      each power mode (Battery_SetLoad()) and the time spent
+ *                      in it. The pack voltage is sampled every
+ *                      BATTERY_SAMPLE_S, it sets the charge at start up and
+ *                      pulls the count down when the pack is emptier than
+ *                      counted. The remaining runtime uses the average
+ *                      current since start up.
+ *
+ * Hardware Description: Pack voltage through a 1:BATTERY_DIVIDER divider on
+ *                       AN2 (RB0). The ADC is referenced to AVDD, so the
+ *                       reading is only valid while the 3.3V regulator is in
+ *                       regulation
+ *
+ * Created October 20th, 2026, 11:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef BATTERY_H
+#define BATTERY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Charge levels, the power mode follows them
+typedef enum
+{
+    BATTERY_CRITICAL,
+    BATTERY_LOW,
+    BATTERY_OK
+} BatteryLevel;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Battery_Init(void);
+bool Battery_Tasks(void);
+void Battery_SetLoad(uint16_t milliamps);
+uint16_t Battery_Millivolts(void);
+uint8_t Battery_Percent(void);
+uint16_t Battery_RuntimeMinutes(void);
+BatteryLevel Battery_Level(void);
+
+#endif  // BATTERY_H
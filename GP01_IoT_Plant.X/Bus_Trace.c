@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * File: Bus_Trace.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Ring buffer and UART1 dump for the bus transaction
+ *                      tracer. See Bus_Trace.h
+ *
+ * Hardware Description: Dump is sent over UART1 (HC-05 Bluetooth module)
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Bus_Trace.h"
+
+#if BUS_TRACE_ENABLE
+
+// Dump header: "BTRC", version, record size, count, dropped, tick rate
+#define BUS_TRACE_VERSION  1
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static BusTraceRecord trace_buffer[BUS_TRACE_DEPTH];
+static uint16_t trace_head;      // index of next record to write
+static uint16_t trace_count;     // valid records in buffer
+static uint16_t trace_dropped;   // records overwritten since last clear
+
+/*******************************************************************************
+ * Function:        void Bus_Trace_Log(uint8_t bus, uint8_t device,
+ *                  uint8_t direction, uint16_t length, uint32_t start,
+ *                  int8_t status)
+ *
+ * PreCondition:    TMR1 should have been initialized
+ *
+ * Input:           Bus, device, direction, length, start timestamp and status
+ *
+ * Output:          None
+ *
+ * Overview:        Stores a completed transaction in the ring buffer,
+ *                  overwriting the oldest record when full
+ *
+ * Usage:           Use the BUS_TRACE_START()/BUS_TRACE_LOG() macros
+ *
+ * Note:            Called from main line code only
+ ******************************************************************************/
+void Bus_Trace_Log(uint8_t bus, uint8_t device, uint8_t direction,
+                   uint16_t length, uint32_t start, int8_t status)
+{
+    BusTraceRecord *rec = &trace_buffer[trace_head];
+    uint32_t elapsed = TMR1_TimestampGet() - start;
+
+    rec->start     = start;
+    rec->duration  = (elapsed > 0xFFFF) ? 0xFFFF : (uint16_t)elapsed;
+    rec->length    = length;
+    rec->bus       = bus;
+    rec->device    = device;
+    rec->direction = direction;
+    rec->status    = status;
+
+    trace_head = (trace_head + 1) & (BUS_TRACE_DEPTH - 1);
+
+    if (trace_count < BUS_TRACE_DEPTH)
+    {
+        trace_count++;
+    }
+    else
+    {
+        trace_dropped++;
+    }
+}
+
+/*******************************************************************************
+ * Function:        void Bus_Trace_Clear(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Empties the ring buffer
+ *
+ * Usage:           Bus_Trace_Clear();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Bus_Trace_Clear(void)
+{
+    trace_head = 0;
+    trace_count = 0;
+    trace_dropped = 0;
+}
+
+/*******************************************************************************
+ * Function:        static void Bus_Trace_Put16(uint16_t value)
+ *                  static void Bus_Trace_Put32(uint32_t value)
+ *
+ * Overview:        Sends a value over UART1, least significant byte first
+ ******************************************************************************/
+static void Bus_Trace_Put16(uint16_t value)
+{
+    UART1_Write(value & 0xFF);
+    UART1_Write(value >> 8);
+}
+
+static void Bus_Trace_Put32(uint32_t value)
+{
+    Bus_Trace_Put16(value & 0xFFFF);
+    Bus_Trace_Put16(value >> 16);
+}
+
+/*******************************************************************************
+ * Function:        void Bus_Trace_Dump(uint16_t max)
+ *
+ * PreCondition:    UART1 should have been initialized
+ *
+ * Input:           Most records to send
+ *
+ * Output:          None
+ *
+ * Overview:        Sends the header followed by up to max of the oldest
+ *                  records in binary over UART1 and removes them from the
+ *                  buffer. Sends nothing when there is nothing to report
+ *
+ * Usage:           Bus_Trace_Dump(BUS_TRACE_DUMP_RECORDS);
+ *
+ * Note:            Header is "BTRC", version (1 byte), record size (1 byte),
+ *                  record count (2 bytes), dropped count (2 bytes) and
+ *                  timestamp rate in Hz (4 bytes). UART1 output blocks,
+ *                  each record takes about 12 ms at 9600 baud
+ ******************************************************************************/
+void Bus_Trace_Dump(uint16_t max)
+{
+    uint16_t count = (trace_count < max) ? trace_count : max;
+    uint16_t i;
+    uint16_t index;
+
+    if ((count == 0) && (trace_dropped == 0))
+    {
+        return;
+    }
+
+    UART1_Write('B');
+    UART1_Write('T');
+    UART1_Write('R');
+    UART1_Write('C');
+    UART1_Write(BUS_TRACE_VERSION);
+    UART1_Write(sizeof(BusTraceRecord));
+    Bus_Trace_Put16(count);
+    Bus_Trace_Put16(trace_dropped);
+    Bus_Trace_Put32(FCY / TMR1_TIMESTAMP_PRESCALER);
+
+    // Oldest record sits trace_count entries behind the head
+    index = (trace_head - trace_count) & (BUS_TRACE_DEPTH - 1);
+
+    for (i = 0; i < count; i++)
+    {
+        BusTraceRecord *rec = &trace_buffer[index];
+
+        Bus_Trace_Put32(rec->start);
+        Bus_Trace_Put16(rec->duration);
+        Bus_Trace_Put16(rec->length);
+        UART1_Write(rec->bus);
+        UART1_Write(rec->device);
+        UART1_Write(rec->direction);
+        UART1_Write((uint8_t)rec->status);
+
+        index = (index + 1) & (BUS_TRACE_DEPTH - 1);
+    }
+
+    // Records still waiting stay, the drops are reported once
+    trace_count -= count;
+    trace_dropped = 0;
+}
+
+#endif  // BUS_TRACE_ENABLE
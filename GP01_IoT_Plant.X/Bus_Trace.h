@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * File: Bus_Trace.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Optional bus transaction tracer for the I2C1 and SPI2
+ *                      drivers. Each transaction is stored in a fixed size
+ *                      RAM ring buffer which can be dumped in binary over
+ *                      UART1 and decoded on the host with
+ *                      tools/bus_trace_decode.py
+ *
+ *                      Tracing is compiled in only when BUS_TRACE_ENABLE is
+ *                      defined to 1 (e.g. in the project preprocessor macros),
+ *                      otherwise the trace macros expand to nothing.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef BUS_TRACE_H
+#define BUS_TRACE_H
+
+#include <stdint.h>
+#include "mcc_generated_files/tmr1.h"
+
+// Set to 1 to compile the tracer into the drivers
+#ifndef BUS_TRACE_ENABLE
+#define BUS_TRACE_ENABLE 0
+#endif
+
+// Number of records kept in the ring buffer (power of two)
+#define BUS_TRACE_DEPTH  64
+
+// Records sent per Bus_Trace_Dump() call from the logging task, 8 records
+// take about 115 ms at 9600 baud
+#ifndef BUS_TRACE_DUMP_RECORDS
+#define BUS_TRACE_DUMP_RECORDS 8
+#endif
+
+// Bus identifiers
+#define BUS_TRACE_I2C1   0
+#define BUS_TRACE_SPI2   1
+
+// Transfer direction
+#define BUS_TRACE_WRITE  0
+#define BUS_TRACE_READ   1
+
+// SPI2 device identifiers (chip select lines)
+#define BUS_TRACE_DEV_DS1722 0
+#define BUS_TRACE_DEV_FLASH  1
+
+/*******************************************************************************
+ * Record layout, 12 bytes little endian, as sent by Bus_Trace_Dump()
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t start;      // TMR1 timestamp at start of transaction
+    uint16_t duration;   // TMR1 counts until the stop condition / CS release
+    uint16_t length;     // Payload bytes including register address
+    uint8_t  bus;        // BUS_TRACE_I2C1 or BUS_TRACE_SPI2
+    uint8_t  device;     // 7-bit I2C address or SPI device identifier
+    uint8_t  direction;  // BUS_TRACE_WRITE or BUS_TRACE_READ
+    int8_t   status;     // 0 on success, negative driver error code
+} BusTraceRecord;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Bus_Trace_Log(uint8_t bus, uint8_t device, uint8_t direction,
+                   uint16_t length, uint32_t start, int8_t status);
+void Bus_Trace_Clear(void);
+void Bus_Trace_Dump(uint16_t max);
+
+/*******************************************************************************
+ * Instrumentation macros used by the drivers
+ ******************************************************************************/
+#if BUS_TRACE_ENABLE
+#define BUS_TRACE_START(t)   uint32_t t = TMR1_TimestampGet()
+#define BUS_TRACE_LOG(bus, dev, dir, len, t, status) \
+        Bus_Trace_Log((bus), (dev), (dir), (len), (t), (status))
+#else
+#define BUS_TRACE_START(t)
+#define BUS_TRACE_LOG(bus, dev, dir, len, t, status)
+#endif
+
+#endif  // BUS_TRACE_H
@@ -0,0 +1,187 @@
+/*******************************************************************************
+ * File: Classifier.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Hysteresis and debounce classifier. See Classifier.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 10:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "Classifier.h"
+
+/*******************************************************************************
+ * Function:        static uint8_t Classifier_Band(const CLASSIFIER *c,
+ *                  uint16_t value)
+ *
+ * Overview:        Band of a single reading. Starting from the current
+ *                  state an edge is only crossed by more than the margin,
+ *                  with no state yet the edges are used as they are
+ ******************************************************************************/
+static uint8_t Classifier_Band(const CLASSIFIER *c, uint16_t value)
+{
+    const CLASSIFIER_CONFIG *cfg = c->config;
+    uint16_t margin = cfg->hysteresis;
+    uint8_t band = c->state;
+
+    if (band == CLASSIFIER_UNKNOWN)
+    {
+        band = 0;
+        margin = 0;
+    }
+
+    while ((band < cfg->classes - 1) &&
+           ((uint32_t)value >= (uint32_t)cfg->edges[band] + margin))
+    {
+        band++;
+    }
+
+    while ((band > 0) &&
+           ((int32_t)value < (int32_t)cfg->edges[band - 1] - margin))
+    {
+        band--;
+    }
+
+    return band;
+}
+
+/*******************************************************************************
+ * Function:        void Classifier_Init(CLASSIFIER *c,
+ *                  const CLASSIFIER_CONFIG *config)
+ *
+ * PreCondition:    config->window is at most CLASSIFIER_WINDOW_MAX and
+ *                  config->votes at most config->window
+ *
+ * Input:           Classifier and its settings
+ *
+ * Output:          None
+ *
+ * Overview:        Starts the classifier with no state, the first reading
+ *                  sets it
+ *
+ * Usage:           Classifier_Init(&light, &Light_Config);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Classifier_Init(CLASSIFIER *c, const CLASSIFIER_CONFIG *config)
+{
+    c->config = config;
+    c->state = CLASSIFIER_UNKNOWN;
+    c->history = 0;
+    c->since = 0;
+}
+
+/*******************************************************************************
+ * Function:        bool Classifier_Update(CLASSIFIER *c, uint16_t value,
+ *                  uint32_t now)
+ *
+ * PreCondition:    Classifier_Init() should have been called
+ *
+ * Input:           Classifier, new reading and TMR1 timestamp
+ *
+ * Output:          true when the state changed
+ *
+ * Overview:        Votes the reading into the window and moves to its band
+ *                  once enough readings disagree with the state and the
+ *                  dwell time has passed
+ *
+ * Usage:           if (Classifier_Update(&light, lux, TMR1_TimestampGet()))
+ *
+ * Note:            The first reading always changes the state
+ ******************************************************************************/
+bool Classifier_Update(CLASSIFIER *c, uint16_t value, uint32_t now)
+{
+    const CLASSIFIER_CONFIG *cfg = c->config;
+    uint8_t band = Classifier_Band(c, value);
+    uint16_t votes;
+    uint8_t count = 0;
+
+    if (c->state == CLASSIFIER_UNKNOWN)
+    {
+        c->state = band;
+        c->history = 0;
+        c->since = now;
+        return true;
+    }
+
+    c->history <<= 1;
+    if (band != c->state)
+    {
+        c->history |= 1;
+    }
+
+    if (cfg->window < CLASSIFIER_WINDOW_MAX)
+    {
+        c->history &= (1u << cfg->window) - 1;
+    }
+
+    for (votes = c->history; votes != 0; votes &= votes - 1)
+    {
+        count++;
+    }
+
+    if ((band == c->state) || (count < cfg->votes) ||
+        ((now - c->since) < cfg->dwell))
+    {
+        return false;
+    }
+
+    c->state = band;
+    c->history = 0;
+    c->since = now;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        uint8_t Classifier_State(const CLASSIFIER *c)
+ *
+ * PreCondition:    Classifier_Init() should have been called
+ *
+ * Input:           Classifier
+ *
+ * Output:          Current band, CLASSIFIER_UNKNOWN before the first reading
+ *
+ * Overview:        Returns the debounced state
+ *
+ * Usage:           if (Classifier_State(&light) == LIGHT_GOOD)
+ *
+ * Note:            None
+ ******************************************************************************/
+uint8_t Classifier_State(const CLASSIFIER *c)
+{
+    return c->state;
+}
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * File: Classifier.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Debounced classification of a sensor reading into
+ *                      bands (e.g. poor, fair, good light).
+ *
+ *                      A reading only leaves the current band once it is
+ *                      past the band edge by the hysteresis margin. The
+ *                      state then changes when N of the last M readings
+ *                      asked for it and the state has been held for the
+ *                      minimum dwell time. Classifier_Update() returns true
+ *                      only for these changes.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 10:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef CLASSIFIER_H
+#define CLASSIFIER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// State before the first reading
+#define CLASSIFIER_UNKNOWN  0xFF
+
+// Longest voting window, one bit per reading
+#define CLASSIFIER_WINDOW_MAX 16
+
+/*******************************************************************************
+ * Per signal settings, normally const
+ ******************************************************************************/
+typedef struct
+{
+    const uint16_t *edges;      // ascending band edges, classes - 1 of them
+    uint8_t  classes;           // number of bands
+    uint16_t hysteresis;        // margin past an edge needed to cross it
+    uint8_t  votes;             // N, readings needed out of the window
+    uint8_t  window;            // M, readings in the voting window
+    uint32_t dwell;             // TMR1 timestamp ticks to hold a state
+} CLASSIFIER_CONFIG;
+
+typedef struct
+{
+    const CLASSIFIER_CONFIG *config;
+    uint8_t  state;             // debounced band, 0 is the lowest
+    uint16_t history;           // bit set for each reading outside state
+    uint32_t since;             // timestamp of the last change
+} CLASSIFIER;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Classifier_Init(CLASSIFIER *c, const CLASSIFIER_CONFIG *config);
+bool Classifier_Update(CLASSIFIER *c, uint16_t value, uint32_t now);
+uint8_t Classifier_State(const CLASSIFIER *c);
+
+#endif  // CLASSIFIER_H
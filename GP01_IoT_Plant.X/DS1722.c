@@ -0,0 +1,311 @@
+/*******************************************************************************
+ * File: DS1722.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Driver for the DS1722 digital thermometer. See DS1722.h
+ *
+ * Hardware Description: DS1722 on SPI2, CE on RB7
+ *
+ * Created October 19th, 2026, 3:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "DS1722.h"
+#include "Bus_Trace.h"
+#include "SPI_Bus.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+// SPI mode 1 (data out on rising edge, sampled on falling) at FCY/8, the
+// DS1722 allows at most 5 MHz
+static const SPI_DEVICE ds1722_spi =
+{
+    &DS1722_CE_LAT, DS1722_CE_MASK, true,
+    SPI_CON1(SPI_MODE1, SPI_PPRE_4, 2), BUS_TRACE_DEV_DS1722
+};
+
+static uint8_t  ds1722_config;      // last configuration written
+static uint32_t ds1722_conv_ticks;  // conversion time in TMR1 timestamp ticks
+static uint32_t ds1722_started;     // TMR1 timestamp of the one-shot trigger
+static bool     ds1722_pending;     // one-shot conversion in progress
+
+/*******************************************************************************
+ * Function:        void DS1722_Config(uint8_t config)
+ *
+ * PreCondition:    SPI module should have been enabled
+ *
+ * Input:           Configuration register value
+ *
+ * Output:          None
+ *
+ * Overview:        Writes the DS1722 configuration register
+ * 
+ * Usage:           DS1722_Config(0xE8);
+ *
+ * Note:            None
+ ******************************************************************************/
+void DS1722_Config(uint8_t config)
+{
+    // Address and data as one burst, as per datasheet
+    SPI_Bus_WriteRegisters(&ds1722_spi, DS1722_WRITE | DS1722_REG_CONFIG,
+                           &config, 1);
+    
+    ds1722_config = config & ~DS1722_CFG_1SHOT;
+}
+
+/*******************************************************************************
+ * Function:        void DS1722_ReadRegisters(uint8_t reg, uint8_t *data,
+ *                  uint8_t count)
+ *
+ * PreCondition:    SPI module should have been enabled
+ *
+ * Input:           First register, destination and number of registers
+ *
+ * Output:          None
+ *
+ * Overview:        Reads consecutive DS1722 registers, the address auto
+ *                  increments after each byte
+ * 
+ * Usage:           DS1722_ReadRegisters(DS1722_REG_CONFIG, regs, 3);
+ *
+ * Note:            None
+ ******************************************************************************/
+void DS1722_ReadRegisters(uint8_t reg, uint8_t *data, uint8_t count)
+{
+    SPI_Bus_ReadRegisters(&ds1722_spi, reg, data, count);
+}
+
+/*******************************************************************************
+ * Function:        int16_t DS1722_Read(void)
+ *
+ * PreCondition:    SPI module should have been enabled and DS1722 initialized
+ *
+ * Input:           None
+ *
+ * Output:          Temperature in 1/256 degrees C
+ *
+ * Overview:        Reads the DS1722 temperature sensor as per Table 4 of 
+ *                  datasheet 
+ * 
+ * Usage:           int16_t temp = DS1722_Read();
+ *
+ * Note:            Returns the last completed conversion
+ ******************************************************************************/
+int16_t DS1722_Read(void)
+{
+    uint8_t data[2];
+    
+    // LSB address then LSByte and MSByte in one burst
+    DS1722_ReadRegisters(DS1722_REG_TEMP_LSB, data, 2);
+    
+    return ((data[1]<<8) | data[0]);   // return raw temp values
+}
+
+/*******************************************************************************
+ * Function:        void DS1722_Init(uint8_t bits, bool oneShot)
+ *
+ * PreCondition:    SPI module and TMR1 should have been enabled
+ *
+ * Input:           Resolution (8 to 12 bits) and conversion mode
+ *
+ * Output:          None
+ *
+ * Overview:        Configures resolution and mode. In one-shot mode the
+ *                  sensor stays shut down between DS1722_StartConversion()
+ *                  calls, only drawing conversion current while converting
+ * 
+ * Usage:           DS1722_Init(12, true);
+ *
+ * Note:            Conversion time is 75 ms at 8 bits up to 1.2 s at 12 bits
+ ******************************************************************************/
+void DS1722_Init(uint8_t bits, bool oneShot)
+{
+    SPI_Bus_DeviceInit(&ds1722_spi);
+    
+    if (bits < 8)
+    {
+        bits = 8;
+    }
+    else if (bits > 12)
+    {
+        bits = 12;
+    }
+    
+    ds1722_conv_ticks = DS1722_CONV_MS(bits) * (FCY / TMR1_TIMESTAMP_PRESCALER)
+                        / 1000;
+    ds1722_pending = false;
+    
+    DS1722_Config(DS1722_CFG_FIXED | DS1722_CFG_RES(bits) |
+                  (oneShot ? DS1722_CFG_SD : 0));
+}
+
+/*******************************************************************************
+ * Function:        bool DS1722_StartConversion(void)
+ *
+ * PreCondition:    DS1722_Init() should have been called in one-shot mode
+ *
+ * Input:           None
+ *
+ * Output:          false if a conversion is already in progress
+ *
+ * Overview:        Triggers a single conversion and returns immediately
+ * 
+ * Usage:           DS1722_StartConversion();
+ *
+ * Note:            None
+ ******************************************************************************/
+bool DS1722_StartConversion(void)
+{
+    if (ds1722_pending)
+    {
+        return false;
+    }
+    
+    DS1722_Config(ds1722_config | DS1722_CFG_1SHOT);
+    ds1722_started = TMR1_TimestampGet();
+    ds1722_pending = true;
+    
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        bool DS1722_ConversionReady(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          true once the conversion time has passed
+ *
+ * Overview:        Checks whether a one-shot result can be collected
+ * 
+ * Usage:           if (DS1722_ConversionReady()) ...
+ *
+ * Note:            Always true in continuous mode
+ ******************************************************************************/
+bool DS1722_ConversionReady(void)
+{
+    if (!ds1722_pending)
+    {
+        return true;
+    }
+    
+    return (TMR1_TimestampGet() - ds1722_started) >= ds1722_conv_ticks;
+}
+
+/*******************************************************************************
+ * Function:        bool DS1722_GetResult(int16_t *temp)
+ *
+ * PreCondition:    DS1722_Init() should have been called
+ *
+ * Input:           Destination for the temperature in 1/256 degrees C
+ *
+ * Output:          false if the conversion is still running
+ *
+ * Overview:        Collects a finished conversion without waiting
+ * 
+ * Usage:           if (DS1722_GetResult(&temp)) DS1722_StartConversion();
+ *
+ * Note:            None
+ ******************************************************************************/
+bool DS1722_GetResult(int16_t *temp)
+{
+    if (!DS1722_ConversionReady())
+    {
+        return false;
+    }
+    
+    *temp = DS1722_Read();
+    ds1722_pending = false;
+    
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        char *DS1722_Format(char *buffer, int16_t temp,
+ *                  bool fahrenheit)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Buffer of at least DS1722_FORMAT_SIZE characters,
+ *                  temperature in degrees C, Q8.8, and the unit to print
+ *
+ * Output:          buffer
+ *
+ * Overview:        Writes the temperature in C or F with two decimals, e.g.
+ *                  "-12.06", without floating point. The hundredths are
+ *                  computed straight from the Q8.8 reading and rounded half
+ *                  to even, as printf("%.2f") rounds the exact value
+ *
+ * Usage:           DS1722_Format(buff, Temp_Reading, false);
+ *
+ * Note:            Same text as the old float code for every C reading and
+ *                  every F reading but the exact halves, where the float
+ *                  rounding of C * 9 / 5 + 32 decides
+ ******************************************************************************/
+char *DS1722_Format(char *buffer, int16_t temp, bool fahrenheit)
+{
+    int32_t scaled;
+    uint32_t hundredths;
+    uint8_t remainder;
+
+    // Hundredths of a degree times 256
+    if (fahrenheit)
+    {
+        scaled = (int32_t)temp * 180 + 3200L * 256;
+    }
+    else
+    {
+        scaled = (int32_t)temp * 100;
+    }
+
+    hundredths = (scaled < 0) ? (uint32_t)-scaled : (uint32_t)scaled;
+    remainder = hundredths & 0xFF;
+    hundredths >>= 8;
+
+    if ((remainder > 128) || ((remainder == 128) && (hundredths & 1)))
+    {
+        hundredths++;
+    }
+
+    // Keeps the sign of a reading that rounds to zero, "-0.00" like printf
+    sprintf(buffer, "%s%u.%02u", (scaled < 0) ? "-" : "",
+            (unsigned int)(hundredths / 100), (unsigned int)(hundredths % 100));
+
+    return buffer;
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * File: DS1722.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Driver for the DS1722 digital thermometer on SPI2.
+ *                      Supports continuous conversion as well as one-shot
+ *                      mode, where a conversion is triggered, the sensor
+ *                      shuts down again by itself and the result is collected
+ *                      once the conversion time of the selected resolution
+ *                      has passed, without blocking the caller.
+ *
+ * Hardware Description: DS1722 on SPI2, CE on RB7 (active high), SERMODE
+ *                       tied high for SPI
+ *
+ * Created October 19th, 2026, 3:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef DS1722_H
+#define DS1722_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Chip enable on RB7, active high
+#define DS1722_CE_LAT       LATB
+#define DS1722_CE_MASK      (1 << 7)
+
+// Register addresses, write addresses have bit 7 set
+#define DS1722_REG_CONFIG   0x00
+#define DS1722_REG_TEMP_LSB 0x01
+#define DS1722_REG_TEMP_MSB 0x02
+#define DS1722_WRITE        0x80
+
+// Configuration register bits, bits 7..5 must be written as 1
+#define DS1722_CFG_SD       0x01        // shutdown, no continuous conversion
+#define DS1722_CFG_RES(b)   (((b) - 8) << 1)   // 8..12 bits
+#define DS1722_CFG_1SHOT    0x10        // start one conversion, self clearing
+#define DS1722_CFG_FIXED    0xE0
+
+// Worst case conversion time in ms, 75 ms at 8 bits doubling per bit
+#define DS1722_CONV_MS(b)   (75UL << ((b) - 8))
+
+// Temperatures are Q8.8 (1/256 degree), constant in degrees to Q8.8
+#define DS1722_Q8_8(deg)    ((int32_t)((deg) * 256L))
+
+// Q8.8 offset to unsigned in the same order, for Classifier_Update()
+#define DS1722_ORDERED(t)   ((uint16_t)((int32_t)(t) + 0x8000))
+
+// Buffer size for DS1722_Format(), "-67.00" or "248.00" plus terminator
+#define DS1722_FORMAT_SIZE  8
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void DS1722_Config(uint8_t config);
+void DS1722_ReadRegisters(uint8_t reg, uint8_t *data, uint8_t count);
+int16_t DS1722_Read(void);
+void DS1722_Init(uint8_t bits, bool oneShot);
+bool DS1722_StartConversion(void);
+bool DS1722_ConversionReady(void);
+bool DS1722_GetResult(int16_t *temp);
+char *DS1722_Format(char *buffer, int16_t temp, bool fahrenheit);
+
+#endif  // DS1722_H
@@ -0,0 +1,261 @@
+/*******************************************************************************
+ * File: DSP_Filter.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Fixed point sensor filters. See DSP_Filter.h
+ *
+ * Hardware Description: DSP engine (accumulator A)
+ *
+ * Created October 19th, 2026, 8:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "DSP_Filter.h"
+
+#if (DSP_AVERAGE_N & (DSP_AVERAGE_N - 1)) != 0
+#error "DSP_AVERAGE_N must be a power of two"
+#endif
+
+#if (DSP_MEDIAN_N % 2) == 0
+#error "DSP_MEDIAN_N must be odd"
+#endif
+
+/*******************************************************************************
+ * Function:        void DSP_Filter_Init(void)
+ *
+ * PreCondition:    SYSTEM_Initialize() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Sets up the DSP engine for the filters: signed fractional
+ *                  multiplies, accumulator and data space write saturation,
+ *                  conventional rounding
+ *
+ * Usage:           DSP_Filter_Init();
+ *
+ * Note:            SYSTEM_Initialize() leaves CORCON at its POR values with
+ *                  saturation off
+ ******************************************************************************/
+void DSP_Filter_Init(void)
+{
+    CORCON_ModeOperatingSet(CORCON_MODE_ENABLEALLSATNORMAL_ROUNDBIASED);
+}
+
+/*******************************************************************************
+ * Function:        void DSP_Average_Init(DSP_AVERAGE *f, int16_t initial)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Filter and value to fill the window with
+ *
+ * Output:          None
+ *
+ * Overview:        Starts a moving average as if initial had been seen
+ *                  DSP_AVERAGE_N times
+ *
+ * Usage:           DSP_Average_Init(&avg, DSP_FROM_ADC(reading));
+ *
+ * Note:            None
+ ******************************************************************************/
+void DSP_Average_Init(DSP_AVERAGE *f, int16_t initial)
+{
+    uint8_t i;
+
+    for (i = 0; i < DSP_AVERAGE_N; i++)
+    {
+        f->samples[i] = initial;
+    }
+
+    f->sum = (int32_t)initial * DSP_AVERAGE_N;
+    f->index = 0;
+}
+
+/*******************************************************************************
+ * Function:        int16_t DSP_Average_Update(DSP_AVERAGE *f, int16_t x)
+ *
+ * PreCondition:    DSP_Average_Init() should have been called
+ *
+ * Input:           Filter and new sample
+ *
+ * Output:          Average of the last DSP_AVERAGE_N samples
+ *
+ * Overview:        Keeps a running sum, so each update is one add, one
+ *                  subtract and a shift whatever the window length
+ *
+ * Usage:           y = DSP_Average_Update(&avg, x);
+ *
+ * Note:            None
+ ******************************************************************************/
+int16_t DSP_Average_Update(DSP_AVERAGE *f, int16_t x)
+{
+    f->sum += x - f->samples[f->index];
+    f->samples[f->index] = x;
+    f->index = (f->index + 1) & (DSP_AVERAGE_N - 1);
+
+    return f->sum / DSP_AVERAGE_N;
+}
+
+/*******************************************************************************
+ * Function:        void DSP_IIR_Init(DSP_IIR *f, int16_t alpha,
+ *                  int16_t initial)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Filter, smoothing factor (Q15, 0 < alpha < 1) and
+ *                  initial output
+ *
+ * Output:          None
+ *
+ * Overview:        Starts a first order low-pass, y += alpha * (x - y)
+ *
+ * Usage:           DSP_IIR_Init(&lp, DSP_Q15(0.25), DSP_FROM_ADC(reading));
+ *
+ * Note:            The time constant is about 1 / alpha samples
+ ******************************************************************************/
+void DSP_IIR_Init(DSP_IIR *f, int16_t alpha, int16_t initial)
+{
+    f->alpha = alpha;
+    f->y = initial;
+}
+
+/*******************************************************************************
+ * Function:        int16_t DSP_IIR_Update(DSP_IIR *f, int16_t x)
+ *
+ * PreCondition:    DSP_IIR_Init() and DSP_Filter_Init() should have been
+ *                  called
+ *
+ * Input:           Filter and new sample
+ *
+ * Output:          Filtered value
+ *
+ * Overview:        Computes y - alpha * y + alpha * x in accumulator A, so
+ *                  no intermediate can overflow, and stores it rounded
+ *
+ * Usage:           y = DSP_IIR_Update(&lp, x);
+ *
+ * Note:            The portable path rounds the same way as the DSP engine
+ *                  in conventional rounding mode
+ ******************************************************************************/
+int16_t DSP_IIR_Update(DSP_IIR *f, int16_t x)
+{
+#if defined(__dsPIC33E__)
+    register int acc asm("A");
+
+    acc = __builtin_lac(f->y, 0);
+    acc = __builtin_msc(acc, f->alpha, f->y, NULL, NULL, 0, NULL, NULL, 0,
+                        NULL, 0);
+    acc = __builtin_mac(acc, f->alpha, x, NULL, NULL, 0, NULL, NULL, 0,
+                        NULL, 0);
+    f->y = __builtin_sacr(acc, 0);
+#else
+    int32_t acc;
+
+    // Half the accumulator scale, 1.30 instead of 1.31
+    acc = ((int32_t)f->y << 15) - (int32_t)f->alpha * f->y +
+          (int32_t)f->alpha * x;
+    f->y = (int16_t)((acc + 0x4000) >> 15);
+#endif
+
+    return f->y;
+}
+
+/*******************************************************************************
+ * Function:        void DSP_Median_Init(DSP_MEDIAN *f, int16_t initial)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Filter and value to fill the window with
+ *
+ * Output:          None
+ *
+ * Overview:        Starts a median of DSP_MEDIAN_N filter
+ *
+ * Usage:           DSP_Median_Init(&med, DSP_FROM_ADC(reading));
+ *
+ * Note:            None
+ ******************************************************************************/
+void DSP_Median_Init(DSP_MEDIAN *f, int16_t initial)
+{
+    uint8_t i;
+
+    for (i = 0; i < DSP_MEDIAN_N; i++)
+    {
+        f->samples[i] = initial;
+    }
+
+    f->index = 0;
+}
+
+/*******************************************************************************
+ * Function:        int16_t DSP_Median_Update(DSP_MEDIAN *f, int16_t x)
+ *
+ * PreCondition:    DSP_Median_Init() should have been called
+ *
+ * Input:           Filter and new sample
+ *
+ * Output:          Median of the last DSP_MEDIAN_N samples
+ *
+ * Overview:        Insertion sorts a copy of the window, a single spike
+ *                  (up to half the window) never reaches the output
+ *
+ * Usage:           y = DSP_Median_Update(&med, x);
+ *
+ * Note:            Meant for short windows, cost grows with N squared
+ ******************************************************************************/
+int16_t DSP_Median_Update(DSP_MEDIAN *f, int16_t x)
+{
+    int16_t sorted[DSP_MEDIAN_N];
+    uint8_t i;
+    uint8_t j;
+
+    f->samples[f->index] = x;
+    f->index = (f->index + 1) % DSP_MEDIAN_N;
+
+    for (i = 0; i < DSP_MEDIAN_N; i++)
+    {
+        int16_t v = f->samples[i];
+
+        for (j = i; j > 0 && sorted[j - 1] > v; j--)
+        {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = v;
+    }
+
+    return sorted[DSP_MEDIAN_N / 2];
+}
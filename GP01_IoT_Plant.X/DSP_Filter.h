@@ -0,0 +1,100 @@
+/*******************************************************************************
+ * File: DSP_Filter.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Fixed point filters for the sensor readings, a moving
+ *                      average, a first order IIR low-pass running on the DSP
+ *                      accumulator and a median of N for spike rejection.
+ *
+ *                      Samples are Q15 fractions, DSP_FROM_ADC() and
+ *                      DSP_TO_ADC() convert from and to ADC counts. On the
+ *                      dsPIC33E the IIR uses the MAC unit through the XC16
+ *                      DSP builtins, elsewhere a portable C path gives the
+ *                      same results.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 8:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef DSP_FILTER_H
+#define DSP_FILTER_H
+
+#include <stdint.h>
+
+// Q15 constant from a fraction, e.g. DSP_Q15(0.25)
+#define DSP_Q15(f)          ((int16_t)((f) * 32768.0 + 0.5))
+
+// ADC counts of ADC1_RESULT_BITS to Q15 and back
+#define DSP_ADC_SHIFT       (15 - ADC1_RESULT_BITS)
+#define DSP_FROM_ADC(x)     ((int16_t)((x) << DSP_ADC_SHIFT))
+#define DSP_TO_ADC(q)       ((uint16_t)((q) >> DSP_ADC_SHIFT))
+
+// Moving average length (power of two)
+#define DSP_AVERAGE_N       8
+
+// Median window length (odd)
+#define DSP_MEDIAN_N        5
+
+/*******************************************************************************
+ * Filter state
+ ******************************************************************************/
+typedef struct
+{
+    int16_t samples[DSP_AVERAGE_N];
+    int32_t sum;
+    uint8_t index;
+} DSP_AVERAGE;
+
+typedef struct
+{
+    int16_t y;                      // last output, Q15
+    int16_t alpha;                  // smoothing factor, Q15
+} DSP_IIR;
+
+typedef struct
+{
+    int16_t samples[DSP_MEDIAN_N];
+    uint8_t index;
+} DSP_MEDIAN;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void DSP_Filter_Init(void);
+void DSP_Average_Init(DSP_AVERAGE *f, int16_t initial);
+int16_t DSP_Average_Update(DSP_AVERAGE *f, int16_t x);
+void DSP_IIR_Init(DSP_IIR *f, int16_t alpha, int16_t initial);
+int16_t DSP_IIR_Update(DSP_IIR *f, int16_t x);
+void DSP_Median_Init(DSP_MEDIAN *f, int16_t initial);
+int16_t DSP_Median_Update(DSP_MEDIAN *f, int16_t x);
+
+#endif  // DSP_FILTER_H
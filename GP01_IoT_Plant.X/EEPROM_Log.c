@@ -0,0 +1,617 @@
+/*******************************************************************************
+ * File: EEPROM_Log.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Page aligned, write combining sensor logger on the
+ *                      LD/HD serial EEPROM functions, run as I2C bus jobs.
+ *                      See EEPROM_Log.h
+ *
+ * Hardware Description: 24LC series EEPROM on I2C1
+ *
+ * Created October 19th, 2026, 11:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "PIC24_PIC33_I2C.h"
+#include "I2C_Bus.h"
+#include "EEPROM_Log.h"
+#include <string.h>
+
+#if (EE_LOG_PAGE_SIZE % EE_LOG_RECORD_SIZE) != 0
+#error "EEPROM page size must be a multiple of the record size"
+#endif
+
+#if (EE_LOG_RECORDS % EE_LOG_SEQ_MODULO) == 0
+#error "Record count must not be a multiple of the sequence modulo"
+#endif
+
+// Bytes fetched per sequential read while scanning or exporting
+#define EE_LOG_READ_CHUNK   64
+
+/*******************************************************************************
+ * Transfer run by the log's I2C bus job, one page write or read chunk per
+ * step. Every transfer starts by ACK polling the device, which also waits
+ * out the write cycle of the previous page
+ ******************************************************************************/
+typedef struct
+{
+    uint16_t address;      // next EEPROM address
+    uint8_t  *data;        // next byte to write or read into
+    uint16_t length;       // bytes left
+    bool     write;
+    bool     polling;      // waiting for the device to acknowledge
+    uint16_t attempts;     // ACK polls so far
+    bool     ok;           // false once a poll timed out or a write failed
+} EE_LOG_XFER;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static bool     ee_present;                   // device answered at boot
+static uint16_t ee_head;                      // record index of next write
+static uint16_t ee_count;                     // records held, incl. pending
+static uint8_t  ee_seq;                       // next sequence number
+
+static uint8_t  ee_page[EE_LOG_PAGE_SIZE];    // write combining buffer
+static uint16_t ee_page_addr;                 // EEPROM address of ee_page
+static uint8_t  ee_page_fill;                 // bytes valid in ee_page
+static uint8_t  ee_page_flushed;              // bytes already in EEPROM
+
+static I2C_BUS_JOB ee_job;                    // runs ee_xfer on the bus
+static EE_LOG_XFER ee_xfer;
+static uint8_t  ee_job_data[EE_LOG_PAGE_SIZE]; // bytes being written by ee_job
+static bool     ee_write_failed;              // a queued write failed
+
+/*******************************************************************************
+ * Function:        static uint8_t EE_Log_Control(uint16_t address)
+ *
+ * Overview:        Returns the control byte addressing a byte in the device,
+ *                  low density parts take the block number in bits 3..1
+ ******************************************************************************/
+static uint8_t EE_Log_Control(uint16_t address)
+{
+#if EE_LOG_HIGH_DENSITY
+    (void)address;
+    return EE_LOG_CONTROL;
+#else
+    return EE_LOG_CONTROL | (((address >> 8) & 0x07) << 1);
+#endif
+}
+
+/*******************************************************************************
+ * Function:        static bool EE_Log_Probe(uint8_t control)
+ *
+ * Overview:        Addresses the device once, true if it acknowledged. The
+ *                  EEPROM ignores its address during a write cycle
+ ******************************************************************************/
+static bool EE_Log_Probe(uint8_t control)
+{
+    bool ack;
+
+    IdleI2C1();
+    StartI2C1();
+    WriteI2C1(control);
+    IdleI2C1();
+    ack = !I2C1STATbits.ACKSTAT;
+    StopI2C1();
+
+    return ack;
+}
+
+/*******************************************************************************
+ * Function:        static bool EE_Log_Step(void *context)
+ *
+ * PreCondition:    I2C1 should have been initialized
+ *
+ * Input:           Transfer
+ *
+ * Output:          true once the transfer has completed or failed
+ *
+ * Overview:        I2C bus job step. Polls the device once, or writes one
+ *                  page, or reads up to EE_LOG_READ_CHUNK bytes. Writes are
+ *                  split at page boundaries so the device never wraps
+ *                  within a page, reads at block boundaries
+ *
+ * Usage:           None
+ *
+ * Note:            Gives up after EE_ACK_POLL_LIMIT polls. The job ends
+ *                  after the last page write, its write cycle is waited
+ *                  out by the poll starting the next transfer
+ ******************************************************************************/
+static bool EE_Log_Step(void *context)
+{
+    EE_LOG_XFER *x = context;
+    uint16_t chunk;
+
+    if (x->polling)
+    {
+        // One poll per step so other jobs get the bus meanwhile
+        if (!EE_Log_Probe(EE_Log_Control(x->address)))
+        {
+            if (++x->attempts < EE_ACK_POLL_LIMIT)
+            {
+                return false;
+            }
+
+            x->ok = false;
+            return true;
+        }
+
+        x->polling = false;
+        x->attempts = 0;
+
+        if (x->length == 0)
+        {
+            return true;
+        }
+    }
+
+    if (x->write)
+    {
+        uint8_t status;
+
+        chunk = EE_LOG_PAGE_SIZE - (x->address % EE_LOG_PAGE_SIZE);
+        if (chunk > x->length)
+        {
+            chunk = x->length;
+        }
+
+#if EE_LOG_HIGH_DENSITY
+        status = HDPageWriteI2C1(EE_Log_Control(x->address),
+                                 x->address >> 8, x->address & 0xFF,
+                                 x->data, chunk);
+#else
+        status = LDPageWriteI2C1(EE_Log_Control(x->address),
+                                 x->address & 0xFF, x->data, chunk);
+#endif
+
+        if (status)
+        {
+            x->ok = false;
+            return true;
+        }
+
+        // The next page waits for this one's write cycle
+        x->polling = true;
+    }
+    else
+    {
+        chunk = 256 - (x->address & 0xFF);
+        if (chunk > EE_LOG_READ_CHUNK)
+        {
+            chunk = EE_LOG_READ_CHUNK;
+        }
+        if (chunk > x->length)
+        {
+            chunk = x->length;
+        }
+
+#if EE_LOG_HIGH_DENSITY
+        HDSequentialReadI2C(EE_Log_Control(x->address), x->address >> 8,
+                            x->address & 0xFF, x->data, chunk);
+#else
+        LDSequentialReadI2C(EE_Log_Control(x->address), x->address & 0xFF,
+                            x->data, chunk);
+#endif
+    }
+
+    x->address += chunk;
+    x->data += chunk;
+    x->length -= chunk;
+
+    return x->length == 0;
+}
+
+/*******************************************************************************
+ * Function:        static void EE_Log_Start(uint16_t address, uint8_t *data,
+ *                  uint16_t length, bool write)
+ *
+ * Overview:        Queues a transfer on the log's bus job once the previous
+ *                  one has completed. A failed write is remembered for
+ *                  EE_Log_Append() to report
+ ******************************************************************************/
+static void EE_Log_Start(uint16_t address, uint8_t *data, uint16_t length,
+                         bool write)
+{
+    I2C_Bus_Wait(&ee_job);
+
+    if (!ee_xfer.ok)
+    {
+        ee_write_failed = true;
+    }
+
+    ee_xfer.address = address;
+    ee_xfer.data = data;
+    ee_xfer.length = length;
+    ee_xfer.write = write;
+    ee_xfer.polling = true;
+    ee_xfer.attempts = 0;
+    ee_xfer.ok = true;
+
+    I2C_Bus_Submit(&ee_job);
+}
+
+/*******************************************************************************
+ * Function:        static void EE_Log_WriteSpan(uint16_t address,
+ *                  uint8_t *data, uint8_t length)
+ *
+ * PreCondition:    EE_Log_Init() should have been called
+ *
+ * Input:           EEPROM address, data and number of bytes, at most one
+ *                  page
+ *
+ * Output:          None
+ *
+ * Overview:        Copies the data and queues its write, the main loop
+ *                  writes it through I2C_Bus_Tasks()
+ *
+ * Usage:           EE_Log_WriteSpan(0x0010, buf, 8);
+ *
+ * Note:            Waits only while the previous transfer is still running
+ ******************************************************************************/
+static void EE_Log_WriteSpan(uint16_t address, uint8_t *data, uint8_t length)
+{
+    // Finish the previous write before its data is replaced
+    I2C_Bus_Wait(&ee_job);
+
+    memcpy(ee_job_data, data, length);
+    EE_Log_Start(address, ee_job_data, length, true);
+}
+
+/*******************************************************************************
+ * Function:        static void EE_Log_ReadSpan(uint16_t address,
+ *                  uint8_t *data, uint16_t length)
+ *
+ * PreCondition:    EE_Log_Init() should have been called
+ *
+ * Input:           EEPROM address, destination and number of bytes
+ *
+ * Output:          None
+ *
+ * Overview:        Bulk sequential read through the log's bus job, returns
+ *                  once the data has been read
+ *
+ * Usage:           EE_Log_ReadSpan(0x0000, buf, 64);
+ *
+ * Note:            Higher priority bus jobs run between the chunks
+ ******************************************************************************/
+static void EE_Log_ReadSpan(uint16_t address, uint8_t *data, uint16_t length)
+{
+    EE_Log_Start(address, data, length, false);
+    I2C_Bus_Wait(&ee_job);
+}
+
+/*******************************************************************************
+ * Function:        static void EE_Log_StartPage(void)
+ *
+ * Overview:        Points the write combining buffer at the page holding the
+ *                  head record, bytes before the head are already in EEPROM
+ ******************************************************************************/
+static void EE_Log_StartPage(void)
+{
+    uint16_t address = ee_head * EE_LOG_RECORD_SIZE;
+
+    ee_page_addr = address - (address % EE_LOG_PAGE_SIZE);
+    ee_page_fill = address - ee_page_addr;
+    ee_page_flushed = ee_page_fill;
+}
+
+/*******************************************************************************
+ * Function:        bool EE_Log_Init(void)
+ *
+ * PreCondition:    I2C1 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          true if the EEPROM is fitted
+ *
+ * Overview:        Checks that the EEPROM answers then scans the sequence
+ *                  numbers to find where the log stopped. The head is the
+ *                  first record which does not follow its predecessor
+ *
+ * Usage:           EE_Log_Init();
+ *
+ * Note:            Logging is disabled when no EEPROM answers. Takes about
+ *                  0.2 s on a 24LC16B at 100 kHz
+ ******************************************************************************/
+bool EE_Log_Init(void)
+{
+    uint8_t chunk[EE_LOG_READ_CHUNK];
+    uint16_t index = 0;
+    uint8_t prev = EE_LOG_ERASED;
+
+    if (ee_job.step == NULL)
+    {
+        I2C_Bus_JobInit(&ee_job, EE_Log_Step, &ee_xfer, I2C_BUS_PRIO_NORMAL,
+                        I2C_BUS_CLIENT_LOG);
+        ee_xfer.ok = true;
+    }
+
+    // Empty transfer, only checks the device answers
+    EE_Log_Start(0, NULL, 0, false);
+    I2C_Bus_Wait(&ee_job);
+
+    ee_present = ee_xfer.ok;
+    ee_write_failed = false;
+    ee_head = 0;
+    ee_count = 0;
+    ee_seq = 0;
+
+    if (!ee_present)
+    {
+        return false;
+    }
+
+    while (index < EE_LOG_RECORDS)
+    {
+        uint8_t i;
+
+        EE_Log_ReadSpan(index * EE_LOG_RECORD_SIZE, chunk, sizeof(chunk));
+
+        for (i = 0; i < sizeof(chunk); i += EE_LOG_RECORD_SIZE, index++)
+        {
+            uint8_t seq = chunk[i];
+
+            if (index == 0)
+            {
+                if (seq == EE_LOG_ERASED)
+                {
+                    // Blank device
+                    EE_Log_StartPage();
+                    return true;
+                }
+            }
+            else if (seq != (prev + 1) % EE_LOG_SEQ_MODULO)
+            {
+                // Older records follow unless the rest is still erased
+                ee_head = index;
+                ee_count = (seq == EE_LOG_ERASED) ? index : EE_LOG_RECORDS;
+                ee_seq = (prev + 1) % EE_LOG_SEQ_MODULO;
+                EE_Log_StartPage();
+                return true;
+            }
+
+            prev = seq;
+        }
+    }
+
+    // Log ended exactly at the top of the device
+    ee_head = 0;
+    ee_count = EE_LOG_RECORDS;
+    ee_seq = (prev + 1) % EE_LOG_SEQ_MODULO;
+    EE_Log_StartPage();
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        bool EE_Log_Append(const EELogRecord *record)
+ *
+ * PreCondition:    EE_Log_Init() should have been called
+ *
+ * Input:           Record to store, the sequence number is filled in here
+ *
+ * Output:          false if no EEPROM is fitted or a page write failed
+ *
+ * Overview:        Adds a record to the write combining buffer and queues
+ *                  the page write once it is full, overwriting the oldest
+ *                  records when the device is full
+ *
+ * Usage:           EE_Log_Append(&rec);
+ *
+ * Note:            Up to one page of records is held in RAM, call
+ *                  EE_Log_Flush() to write them early. Pages are written by
+ *                  I2C_Bus_Tasks(), a failed write is reported by the call
+ *                  after it
+ ******************************************************************************/
+bool EE_Log_Append(const EELogRecord *record)
+{
+    bool ok;
+
+    if (!ee_present)
+    {
+        return false;
+    }
+
+    memcpy(&ee_page[ee_page_fill], record, EE_LOG_RECORD_SIZE);
+    ee_page[ee_page_fill] = ee_seq;
+    ee_page_fill += EE_LOG_RECORD_SIZE;
+
+    ee_seq = (ee_seq + 1) % EE_LOG_SEQ_MODULO;
+    ee_head = (ee_head + 1) % EE_LOG_RECORDS;
+
+    if (ee_count < EE_LOG_RECORDS)
+    {
+        ee_count++;
+    }
+
+    if (ee_page_fill == EE_LOG_PAGE_SIZE)
+    {
+        EE_Log_WriteSpan(ee_page_addr + ee_page_flushed,
+                         &ee_page[ee_page_flushed],
+                         ee_page_fill - ee_page_flushed);
+        EE_Log_StartPage();
+    }
+
+    // Report a failed write once
+    ok = !ee_write_failed;
+    ee_write_failed = false;
+
+    return ok;
+}
+
+/*******************************************************************************
+ * Function:        void EE_Log_Flush(void)
+ *
+ * PreCondition:    EE_Log_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Queues the write of records still held in the page
+ *                  buffer, I2C_Bus_Tasks() writes them
+ *
+ * Usage:           EE_Log_Flush();
+ *
+ * Note:            Only bytes not yet written are sent, so a page is written
+ *                  at most once more than when it fills normally
+ ******************************************************************************/
+void EE_Log_Flush(void)
+{
+    if (!ee_present || ee_page_flushed == ee_page_fill)
+    {
+        return;
+    }
+
+    EE_Log_WriteSpan(ee_page_addr + ee_page_flushed,
+                     &ee_page[ee_page_flushed],
+                     ee_page_fill - ee_page_flushed);
+    ee_page_flushed = ee_page_fill;
+}
+
+/*******************************************************************************
+ * Function:        uint16_t EE_Log_Count(void)
+ *
+ * PreCondition:    EE_Log_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          Number of records held in the log
+ *
+ * Overview:        Returns the number of records held in the log
+ *
+ * Usage:           n = EE_Log_Count();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint16_t EE_Log_Count(void)
+{
+    return ee_count;
+}
+
+/*******************************************************************************
+ * Function:        uint16_t EE_Log_Read(uint16_t index,
+ *                  EELogRecord *records, uint16_t count)
+ *
+ * PreCondition:    EE_Log_Init() should have been called
+ *
+ * Input:           Index of the first record (0 = oldest), destination and
+ *                  number of records
+ *
+ * Output:          Number of records read
+ *
+ * Overview:        Flushes pending records then reads them back with bulk
+ *                  sequential reads, following the log around the end of
+ *                  the device
+ *
+ * Usage:           n = EE_Log_Read(0, recs, 8);
+ *
+ * Note:            None
+ ******************************************************************************/
+uint16_t EE_Log_Read(uint16_t index, EELogRecord *records, uint16_t count)
+{
+    uint16_t slot;
+    uint16_t done = 0;
+
+    if (!ee_present || index >= ee_count)
+    {
+        return 0;
+    }
+
+    if (count > ee_count - index)
+    {
+        count = ee_count - index;
+    }
+
+    EE_Log_Flush();
+
+    slot = (ee_head + EE_LOG_RECORDS - ee_count + index) % EE_LOG_RECORDS;
+
+    while (done < count)
+    {
+        uint16_t run = EE_LOG_RECORDS - slot;
+
+        if (run > count - done)
+        {
+            run = count - done;
+        }
+
+        EE_Log_ReadSpan(slot * EE_LOG_RECORD_SIZE, (uint8_t *)&records[done],
+                        run * EE_LOG_RECORD_SIZE);
+
+        done += run;
+        slot = 0;
+    }
+
+    return done;
+}
+
+/*******************************************************************************
+ * Function:        void EE_Log_Export(void)
+ *
+ * PreCondition:    EE_Log_Init() and UART1 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Prints the whole log, oldest first, as CSV
+ *
+ * Usage:           EE_Log_Export();
+ *
+ * Note:            Temperature is printed raw in 1/256 degrees C
+ ******************************************************************************/
+void EE_Log_Export(void)
+{
+    EELogRecord records[EE_LOG_READ_CHUNK / EE_LOG_RECORD_SIZE];
+    uint16_t index = 0;
+    uint16_t n;
+    uint16_t i;
+
+    printf("seq,flags,light,moisture,temp_raw\n");
+
+    while ((n = EE_Log_Read(index, records, sizeof(records) / sizeof(records[0]))) != 0)
+    {
+        for (i = 0; i < n; i++)
+        {
+            printf("%u,%u,%u,%u,%d\n", records[i].seq, records[i].flags,
+                   records[i].light, records[i].moisture,
+                   records[i].temperature);
+        }
+
+        index += n;
+    }
+}
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * File: EEPROM_Log.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Sensor history logger for a 24LC series serial EEPROM.
+ *                      Records are combined in a page sized RAM buffer and
+ *                      written one aligned page at a time, the log wraps
+ *                      around the device and the write position is recovered
+ *                      at boot from the record sequence numbers. Transfers
+ *                      run as I2C bus jobs, page writes complete from
+ *                      I2C_Bus_Tasks() in the main loop.
+ *
+ * Hardware Description: 24LC16B (or 24LC256 with EE_LOG_HIGH_DENSITY = 1)
+ *                       on I2C1 with A2..A0 tied to ground, sharing SDA1/SCL1
+ *                       with the SSD1306
+ *
+ * Created October 19th, 2026, 11:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef EEPROM_LOG_H
+#define EEPROM_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "PIC24_PIC33_I2C.h"
+
+// Set to 1 for parts with a two byte word address (24LC32 and up)
+#ifndef EE_LOG_HIGH_DENSITY
+#define EE_LOG_HIGH_DENSITY 0
+#endif
+
+// Control byte with A2..A0 low
+#define EE_LOG_CONTROL      0xA0
+
+#if EE_LOG_HIGH_DENSITY
+#define EE_LOG_SIZE         32768U     // 24LC256
+#define EE_LOG_PAGE_SIZE    64
+#else
+#define EE_LOG_SIZE         2048U      // 24LC16B, 8 blocks of 256 bytes
+#define EE_LOG_PAGE_SIZE    PAGESIZE
+#endif
+
+// Record geometry
+#define EE_LOG_RECORD_SIZE  8
+#define EE_LOG_RECORDS      (EE_LOG_SIZE / EE_LOG_RECORD_SIZE)
+
+// Sequence numbers count modulo 255 so a record never starts with the
+// erased value 0xFF
+#define EE_LOG_SEQ_MODULO   255
+#define EE_LOG_ERASED       0xFF
+
+// Print the whole log as CSV over UART1 at boot, off by default as it is
+// one line per record
+#ifndef EE_LOG_EXPORT_AT_BOOT
+#define EE_LOG_EXPORT_AT_BOOT 0
+#endif
+
+// Record flags
+#define EE_LOG_FLAG_LIGHT_GOOD     0x01
+#define EE_LOG_FLAG_MOISTURE_GOOD  0x02
+#define EE_LOG_FLAG_MOISTURE_NEW   0x04   // moisture was sampled this cycle
+#define EE_LOG_FLAG_TEMP_GOOD      0x10   // same bits as the flash log flags
+
+/*******************************************************************************
+ * Record layout, stored little endian as laid out in RAM
+ ******************************************************************************/
+typedef struct
+{
+    uint8_t  seq;          // assigned by the logger
+    uint8_t  flags;        // EE_LOG_FLAG_xxx
+    uint16_t light;        // AN0 conversion
+    uint16_t moisture;     // AN1 conversion
+    int16_t  temperature;  // DS1722 reading in 1/256 degrees C
+} EELogRecord;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+bool EE_Log_Init(void);
+bool EE_Log_Append(const EELogRecord *record);
+void EE_Log_Flush(void);
+uint16_t EE_Log_Count(void);
+uint16_t EE_Log_Read(uint16_t index, EELogRecord *records, uint16_t count);
+void EE_Log_Export(void);
+
+#endif  // EEPROM_LOG_H
@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * File: Event_Queue.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Interrupt to main loop event queue. See
+ *                      Event_Queue.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 20th, 2026, 2:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include <stddef.h>
+#include "Event_Queue.h"
+
+#if (EVENT_QUEUE_SIZE & (EVENT_QUEUE_SIZE - 1)) != 0
+#error "EVENT_QUEUE_SIZE must be a power of two"
+#endif
+
+#define EVENT_QUEUE_MASK    (EVENT_QUEUE_SIZE - 1)
+
+typedef struct
+{
+    uint16_t id;
+    uint16_t data;
+} EVENT;
+
+static volatile EVENT event_queue[EVENT_QUEUE_SIZE];
+static volatile uint16_t event_head;    // next free slot, producer only
+static volatile uint16_t event_tail;    // next event, consumer only
+static volatile uint16_t event_dropped; // producer only
+
+static EVENT_HANDLER event_handlers[EVENT_COUNT];
+
+/*******************************************************************************
+ * Function:        void Event_Register(EVENT_ID id, EVENT_HANDLER handler)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Event and the function to run for it, NULL to ignore
+ *                  the event
+ *
+ * Output:          None
+ *
+ * Overview:        Sets the handler Event_Dispatch() calls for an event
+ *
+ * Usage:           Event_Register(EVENT_SOIL_CHECK, Soil_Check_Event);
+ *
+ * Note:            Register before the event is first posted
+ ******************************************************************************/
+void Event_Register(EVENT_ID id, EVENT_HANDLER handler)
+{
+    if (id < EVENT_COUNT)
+    {
+        event_handlers[id] = handler;
+    }
+}
+
+/*******************************************************************************
+ * Function:        bool Event_Post(EVENT_ID id, uint16_t data)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Event and a value passed to its handler
+ *
+ * Output:          false if the queue was full and the event dropped
+ *
+ * Overview:        Queues an event for the main loop, a few instructions
+ *                  and never waits
+ *
+ * Usage:           Event_Post(EVENT_SOIL_CHECK, 0);
+ *
+ * Note:            Producer side, only from interrupts of one priority
+ ******************************************************************************/
+bool Event_Post(EVENT_ID id, uint16_t data)
+{
+    uint16_t head = event_head;
+    uint16_t next = (head + 1) & EVENT_QUEUE_MASK;
+
+    if (next == event_tail)
+    {
+        event_dropped++;
+        return false;
+    }
+
+    event_queue[head].id = id;
+    event_queue[head].data = data;
+
+    // Publish only once the slot is written
+    event_head = next;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        void Event_Dispatch(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Runs the handler of every queued event in order
+ *
+ * Usage:           Event_Dispatch();
+ *
+ * Note:            Consumer side, only from the main loop
+ ******************************************************************************/
+void Event_Dispatch(void)
+{
+    uint16_t tail = event_tail;
+    uint16_t id;
+    uint16_t data;
+
+    while (tail != event_head)
+    {
+        id = event_queue[tail].id;
+        data = event_queue[tail].data;
+
+        // Free the slot before the handler runs, it may take a while
+        tail = (tail + 1) & EVENT_QUEUE_MASK;
+        event_tail = tail;
+
+        if ((id < EVENT_COUNT) && (event_handlers[id] != NULL))
+        {
+            event_handlers[id](data);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        uint16_t Event_Dropped(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Events lost to a full queue since start up
+ *
+ * Overview:        Returns the drop count
+ *
+ * Usage:           printf("Dropped: %u\n", Event_Dropped());
+ *
+ * Note:            None
+ ******************************************************************************/
+uint16_t Event_Dropped(void)
+{
+    return event_dropped;
+}
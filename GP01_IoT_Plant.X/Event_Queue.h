@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * File: Event_Queue.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Lock free single producer, single consumer event
+ *                      queue. Interrupts post events with Event_Post() and
+ *                      return, the main loop runs the registered handler of
+ *                      each event from Event_Dispatch().
+ *
+ *                      The producer only writes the head and the consumer
+ *                      only the tail, both 16 bit so every access is
+ *                      atomic. An event is stored before the head moves
+ *                      past it, and as all of it is volatile the compiler
+ *                      keeps that order (the dsPIC does not reorder memory
+ *                      accesses). Only interrupts of one priority may post,
+ *                      a second producer needs its own queue.
+ *
+ * Hardware Description: None
+ *
+ * Created October 20th, 2026, 2:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef EVENT_QUEUE_H
+#define EVENT_QUEUE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Events queued at once (power of two), one slot is kept free
+#define EVENT_QUEUE_SIZE    8
+
+// Events, each has at most one handler
+typedef enum
+{
+    EVENT_SOIL_CHECK,                   // TMR1, time for a soil reading
+    EVENT_COUNT
+} EVENT_ID;
+
+typedef void (*EVENT_HANDLER)(uint16_t data);
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Event_Register(EVENT_ID id, EVENT_HANDLER handler);
+bool Event_Post(EVENT_ID id, uint16_t data);
+void Event_Dispatch(void);
+uint16_t Event_Dropped(void);
+
+#endif  // EVENT_QUEUE_H
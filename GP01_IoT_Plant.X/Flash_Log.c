@@ -0,0 +1,854 @@
+/*******************************************************************************
+ * File: Flash_Log.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Log structured sample store in SPI NOR flash. See
+ *                      Flash_Log.h for the on-flash format
+ *
+ * Hardware Description: 25 series SPI NOR flash on SPI2, /CS on RB10
+ *
+ * Created October 19th, 2026, 6:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Flash_Log.h"
+#include "SPI_Bus.h"
+#include "Bus_Trace.h"
+#include <string.h>
+
+// 25 series commands
+#define FLASH_CMD_WRITE_ENABLE  0x06
+#define FLASH_CMD_READ_STATUS   0x05
+#define FLASH_CMD_READ          0x03
+#define FLASH_CMD_PAGE_PROGRAM  0x02
+#define FLASH_CMD_SECTOR_ERASE  0x20
+#define FLASH_CMD_JEDEC_ID      0x9F
+
+// Status register write in progress
+#define FLASH_STATUS_WIP        0x01
+
+#define FLASH_LOG_MAGIC0        'F'
+#define FLASH_LOG_MAGIC1        'L'
+#define FLASH_LOG_ERASED        0xFF
+
+// No sector open yet
+#define FLASH_LOG_NONE          0xFFFF
+
+// Command and 24 bit address, largest span moved in one transaction
+#define FLASH_LOG_CMD_SIZE      4
+#define FLASH_LOG_SPAN_MAX      FLASH_LOG_HEADER_SIZE
+
+#define FLASH_LOG_SECTOR_ADDR(s) \
+        (FLASH_LOG_BASE + (uint32_t)(s) * FLASH_LOG_SECTOR_SIZE)
+
+#define FLASH_LOG_BUSY_TICKS \
+        ((uint32_t)FLASH_LOG_BUSY_MS * (FCY / TMR1_TIMESTAMP_PRESCALER) / 1000)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+// SPI mode 0 at FCY/4, /CS active low
+static const SPI_DEVICE flash_spi =
+{
+    &FLASH_LOG_CS_LAT, FLASH_LOG_CS_MASK, false,
+    SPI_CON1(SPI_MODE0, SPI_PPRE_4, 1), BUS_TRACE_DEV_FLASH
+};
+
+static bool     fl_present;                   // answered at boot, never hung
+static uint16_t fl_active;                    // sector being filled
+static uint16_t fl_offset;                    // next free byte in fl_active
+static uint16_t fl_used;                      // sectors holding samples
+static uint16_t fl_next;                      // sector erased ahead
+static uint32_t fl_seq;                       // sequence number of fl_active
+static FlashLogSample fl_last;                // last sample, delta base
+static bool     fl_empty;                     // nothing logged yet
+
+// Base time of every sector, for time range queries
+static uint32_t fl_start[FLASH_LOG_SECTORS];
+
+// Reads and programs go through the bus queue, longer ones by DMA, so the
+// command and data are staged in RAM until the transaction has run
+static SPI_TRANSACTION fl_txn;
+static uint8_t fl_xfer[FLASH_LOG_CMD_SIZE + FLASH_LOG_SPAN_MAX];
+
+/*******************************************************************************
+ * Function:        static uint8_t Flash_Log_Crc8(const uint8_t *data,
+ *                  uint8_t length)
+ *
+ * Overview:        CRC-8, polynomial 0x07, initial value 0
+ ******************************************************************************/
+static uint8_t Flash_Log_Crc8(const uint8_t *data, uint8_t length)
+{
+    uint8_t crc = 0;
+    uint8_t bit;
+
+    while (length--)
+    {
+        crc ^= *data++;
+
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+        }
+    }
+
+    return crc;
+}
+
+/*******************************************************************************
+ * Function:        static void Flash_Log_Command(uint8_t command,
+ *                  uint32_t address)
+ *
+ * Overview:        Selects the flash and sends a command with a 24 bit
+ *                  address, the chip select stays asserted
+ ******************************************************************************/
+static void Flash_Log_Command(uint8_t command, uint32_t address)
+{
+    uint8_t cmd[4];
+
+    cmd[0] = command;
+    cmd[1] = address >> 16;
+    cmd[2] = address >> 8;
+    cmd[3] = address;
+
+    SPI_Bus_Begin(&flash_spi);
+    SPI_Bus_Exchange(cmd, NULL, sizeof(cmd));
+}
+
+/*******************************************************************************
+ * Function:        static void Flash_Log_Submit(uint8_t command,
+ *                  uint32_t address, const uint8_t *data, uint8_t length)
+ *
+ * Overview:        Queues a command with a 24 bit address and up to
+ *                  FLASH_LOG_SPAN_MAX data bytes as one bus transaction.
+ *                  Without data dummy bytes are sent and the bytes read
+ *                  back land in fl_xfer after the command
+ ******************************************************************************/
+static void Flash_Log_Submit(uint8_t command, uint32_t address,
+                             const uint8_t *data, uint8_t length)
+{
+    fl_xfer[0] = command;
+    fl_xfer[1] = address >> 16;
+    fl_xfer[2] = address >> 8;
+    fl_xfer[3] = address;
+
+    if (data)
+    {
+        memcpy(&fl_xfer[FLASH_LOG_CMD_SIZE], data, length);
+    }
+    else
+    {
+        memset(&fl_xfer[FLASH_LOG_CMD_SIZE], SPI2_DUMMY_DATA, length);
+    }
+
+    // Reads are exchanged in place, byte n is always sent before it is
+    // received
+    fl_txn.device = &flash_spi;
+    fl_txn.tx = fl_xfer;
+    fl_txn.rx = data ? NULL : fl_xfer;
+    fl_txn.length = FLASH_LOG_CMD_SIZE + length;
+    fl_txn.done = NULL;
+
+    SPI_Bus_Submit(&fl_txn);
+}
+
+/*******************************************************************************
+ * Function:        static bool Flash_Log_WaitReady(void)
+ *
+ * Overview:        Lets a queued transaction run, then polls the status
+ *                  register until a program or erase has finished. A flash
+ *                  still busy after FLASH_LOG_BUSY_MS has hung or gone,
+ *                  logging stops until the next reset and false is returned,
+ *                  at once on every later call
+ ******************************************************************************/
+static bool Flash_Log_WaitReady(void)
+{
+    uint32_t start;
+    uint8_t status;
+
+    SPI_Bus_Wait(&fl_txn);
+
+    start = TMR1_TimestampGet();
+
+    while (fl_present)
+    {
+        SPI_Bus_Begin(&flash_spi);
+        SPI_Bus_Transfer(FLASH_CMD_READ_STATUS);
+        status = SPI_Bus_Transfer(0x00);
+        SPI_Bus_End();
+
+        if (!(status & FLASH_STATUS_WIP))
+        {
+            return true;
+        }
+
+        if (TMR1_TimestampGet() - start >= FLASH_LOG_BUSY_TICKS)
+        {
+            fl_present = false;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+ * Function:        static bool Flash_Log_WriteEnable(void)
+ *
+ * Overview:        Waits for the flash then sets its write enable latch,
+ *                  false if it never became ready
+ ******************************************************************************/
+static bool Flash_Log_WriteEnable(void)
+{
+    if (!Flash_Log_WaitReady())
+    {
+        return false;
+    }
+
+    SPI_Bus_Begin(&flash_spi);
+    SPI_Bus_Transfer(FLASH_CMD_WRITE_ENABLE);
+    SPI_Bus_End();
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static bool Flash_Log_ReadSpan(uint32_t address,
+ *                  uint8_t *data, uint16_t length)
+ *
+ * Overview:        Reads any number of bytes from any address, through
+ *                  the bus queue in spans of FLASH_LOG_SPAN_MAX bytes.
+ *                  false if the flash never became ready
+ ******************************************************************************/
+static bool Flash_Log_ReadSpan(uint32_t address, uint8_t *data, uint16_t length)
+{
+    while (length)
+    {
+        uint8_t chunk = (length > FLASH_LOG_SPAN_MAX) ?
+                        FLASH_LOG_SPAN_MAX : length;
+
+        if (!Flash_Log_WaitReady())
+        {
+            return false;
+        }
+
+        Flash_Log_Submit(FLASH_CMD_READ, address, NULL, chunk);
+        SPI_Bus_Wait(&fl_txn);
+        memcpy(data, &fl_xfer[FLASH_LOG_CMD_SIZE], chunk);
+
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static bool Flash_Log_WriteSpan(uint32_t address,
+ *                  const uint8_t *data, uint16_t length)
+ *
+ * Overview:        Programs data, split at page boundaries so the flash
+ *                  never wraps within a page. Returns once the last page
+ *                  program is queued, SPI_Bus_Tasks() sends it and the next
+ *                  access waits for it to finish. false if the flash never
+ *                  became ready
+ ******************************************************************************/
+static bool Flash_Log_WriteSpan(uint32_t address, const uint8_t *data,
+                                uint16_t length)
+{
+    while (length)
+    {
+        uint16_t chunk = FLASH_LOG_PAGE_SIZE - (address % FLASH_LOG_PAGE_SIZE);
+
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+        if (chunk > FLASH_LOG_SPAN_MAX)
+        {
+            chunk = FLASH_LOG_SPAN_MAX;
+        }
+
+        if (!Flash_Log_WriteEnable())
+        {
+            return false;
+        }
+        Flash_Log_Submit(FLASH_CMD_PAGE_PROGRAM, address, data, chunk);
+
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static bool Flash_Log_EraseAhead(void)
+ *
+ * Overview:        Starts erasing fl_next without waiting, the 45..400 ms
+ *                  erase runs while the sector before it is being filled.
+ *                  The oldest sector is dropped when the ring is full.
+ *                  false if the flash never became ready
+ ******************************************************************************/
+static bool Flash_Log_EraseAhead(void)
+{
+    if (fl_used == FLASH_LOG_SECTORS)
+    {
+        fl_used--;
+    }
+
+    if (!Flash_Log_WriteEnable())
+    {
+        return false;
+    }
+    Flash_Log_Command(FLASH_CMD_SECTOR_ERASE, FLASH_LOG_SECTOR_ADDR(fl_next));
+    SPI_Bus_End();
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Flash_Log_PutVarint(uint8_t *out,
+ *                  uint32_t value)
+ *
+ * Overview:        Stores a value 7 bits per byte, low bits first, bit 7 set
+ *                  on all but the last byte. Returns the bytes used
+ ******************************************************************************/
+static uint8_t Flash_Log_PutVarint(uint8_t *out, uint32_t value)
+{
+    uint8_t n = 0;
+
+    while (value >= 0x80)
+    {
+        out[n++] = (value & 0x7F) | 0x80;
+        value >>= 7;
+    }
+    out[n++] = value;
+
+    return n;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Flash_Log_GetVarint(const uint8_t *in,
+ *                  uint8_t avail, uint32_t *value)
+ *
+ * Overview:        Reverse of Flash_Log_PutVarint(), returns the bytes used
+ *                  or 0 if the value runs past avail or over 5 bytes
+ ******************************************************************************/
+static uint8_t Flash_Log_GetVarint(const uint8_t *in, uint8_t avail,
+                                   uint32_t *value)
+{
+    uint8_t n = 0;
+
+    *value = 0;
+
+    while (n < avail && n < 5)
+    {
+        *value |= (uint32_t)(in[n] & 0x7F) << (7 * n);
+
+        if (!(in[n++] & 0x80))
+        {
+            return n;
+        }
+    }
+
+    return 0;
+}
+
+// Zig zag mapping of signed deltas, small magnitudes give small values
+#define FLASH_LOG_ZIGZAG(d)     (((uint32_t)(d) << 1) ^ (uint32_t)((d) >> 31))
+#define FLASH_LOG_UNZIGZAG(v)   ((int32_t)((v) >> 1) ^ -(int32_t)((v) & 1))
+
+/*******************************************************************************
+ * Function:        static uint8_t Flash_Log_Encode(uint8_t *out,
+ *                  const FlashLogSample *sample)
+ *
+ * Overview:        Encodes a sample as deltas from fl_last, returns the
+ *                  record length
+ ******************************************************************************/
+static uint8_t Flash_Log_Encode(uint8_t *out, const FlashLogSample *sample)
+{
+    uint8_t n = 0;
+
+    out[n++] = sample->flags & 0x7F;
+    n += Flash_Log_PutVarint(&out[n], sample->time - fl_last.time);
+    n += Flash_Log_PutVarint(&out[n],
+         FLASH_LOG_ZIGZAG((int32_t)sample->light - fl_last.light));
+    n += Flash_Log_PutVarint(&out[n],
+         FLASH_LOG_ZIGZAG((int32_t)sample->moisture - fl_last.moisture));
+    n += Flash_Log_PutVarint(&out[n],
+         FLASH_LOG_ZIGZAG((int32_t)sample->temperature - fl_last.temperature));
+    out[n] = Flash_Log_Crc8(out, n);
+
+    return n + 1;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Flash_Log_Decode(const uint8_t *in,
+ *                  uint8_t avail, FlashLogSample *sample)
+ *
+ * Overview:        Applies the record at in to sample. Returns the record
+ *                  length, or 0 for erased flash or a torn or corrupt record
+ ******************************************************************************/
+static uint8_t Flash_Log_Decode(const uint8_t *in, uint8_t avail,
+                                FlashLogSample *sample)
+{
+    uint32_t delta[4];
+    uint8_t n = 1;
+    uint8_t i;
+
+    if (avail == 0 || (in[0] & 0x80))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < 4; i++)
+    {
+        uint8_t used = Flash_Log_GetVarint(&in[n], avail - n, &delta[i]);
+
+        if (used == 0)
+        {
+            return 0;
+        }
+        n += used;
+    }
+
+    if (n >= avail || Flash_Log_Crc8(in, n) != in[n])
+    {
+        return 0;
+    }
+
+    sample->flags = in[0];
+    sample->time += delta[0];
+    sample->light += FLASH_LOG_UNZIGZAG(delta[1]);
+    sample->moisture += FLASH_LOG_UNZIGZAG(delta[2]);
+    sample->temperature += FLASH_LOG_UNZIGZAG(delta[3]);
+
+    return n + 1;
+}
+
+/*******************************************************************************
+ * Function:        static bool Flash_Log_ReadHeader(uint16_t sector,
+ *                  uint32_t *seq, FlashLogSample *base)
+ *
+ * Overview:        Reads a sector header, false if the sector is erased, the
+ *                  header is torn or the flash never became ready
+ ******************************************************************************/
+static bool Flash_Log_ReadHeader(uint16_t sector, uint32_t *seq,
+                                 FlashLogSample *base)
+{
+    uint8_t hdr[FLASH_LOG_HEADER_SIZE];
+
+    if (!Flash_Log_ReadSpan(FLASH_LOG_SECTOR_ADDR(sector), hdr, sizeof(hdr)) ||
+        hdr[0] != FLASH_LOG_MAGIC0 || hdr[1] != FLASH_LOG_MAGIC1 ||
+        Flash_Log_Crc8(hdr, FLASH_LOG_HEADER_SIZE - 1) != hdr[16])
+    {
+        return false;
+    }
+
+    *seq = hdr[2] | ((uint32_t)hdr[3] << 8) | ((uint32_t)hdr[4] << 16) |
+           ((uint32_t)hdr[5] << 24);
+    base->time = hdr[6] | ((uint32_t)hdr[7] << 8) | ((uint32_t)hdr[8] << 16) |
+                 ((uint32_t)hdr[9] << 24);
+    base->flags = 0;
+    base->light = hdr[10] | (hdr[11] << 8);
+    base->moisture = hdr[12] | (hdr[13] << 8);
+    base->temperature = (int16_t)(hdr[14] | (hdr[15] << 8));
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static bool Flash_Log_OpenSector(uint32_t time)
+ *
+ * Overview:        Writes the header of the erased ahead sector, carrying
+ *                  the last sample as delta base, and makes the sector after
+ *                  it the next to erase. false if the flash never became
+ *                  ready
+ ******************************************************************************/
+static bool Flash_Log_OpenSector(uint32_t time)
+{
+    uint8_t hdr[FLASH_LOG_HEADER_SIZE];
+
+    if (fl_empty)
+    {
+        memset(&fl_last, 0, sizeof(fl_last));
+        fl_last.time = time;
+        fl_seq = 0;
+    }
+    else
+    {
+        fl_seq++;
+    }
+
+    hdr[0] = FLASH_LOG_MAGIC0;
+    hdr[1] = FLASH_LOG_MAGIC1;
+    hdr[2] = fl_seq;
+    hdr[3] = fl_seq >> 8;
+    hdr[4] = fl_seq >> 16;
+    hdr[5] = fl_seq >> 24;
+    hdr[6] = fl_last.time;
+    hdr[7] = fl_last.time >> 8;
+    hdr[8] = fl_last.time >> 16;
+    hdr[9] = fl_last.time >> 24;
+    hdr[10] = fl_last.light;
+    hdr[11] = fl_last.light >> 8;
+    hdr[12] = fl_last.moisture;
+    hdr[13] = fl_last.moisture >> 8;
+    hdr[14] = fl_last.temperature;
+    hdr[15] = (uint16_t)fl_last.temperature >> 8;
+    hdr[16] = Flash_Log_Crc8(hdr, FLASH_LOG_HEADER_SIZE - 1);
+
+    // Waits for the erase started when the previous sector was opened
+    if (!Flash_Log_WriteSpan(FLASH_LOG_SECTOR_ADDR(fl_next), hdr, sizeof(hdr)))
+    {
+        return false;
+    }
+
+    fl_active = fl_next;
+    fl_offset = FLASH_LOG_HEADER_SIZE;
+    fl_start[fl_active] = fl_last.time;
+    fl_used++;
+    fl_empty = false;
+
+    fl_next = (fl_active + 1) % FLASH_LOG_SECTORS;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static uint16_t Flash_Log_Walk(uint16_t sector,
+ *                  FlashLogSample *sample, uint32_t from, uint32_t to,
+ *                  FLASH_LOG_CALLBACK callback, uint32_t *count)
+ *
+ * Overview:        Decodes the records of a sector starting from the header
+ *                  values in sample, passing those within from..to to the
+ *                  callback. Stops at erased flash, a bad record, the
+ *                  first sample after to or a flash that never became
+ *                  ready. Returns the offset it stopped at
+ ******************************************************************************/
+static uint16_t Flash_Log_Walk(uint16_t sector, FlashLogSample *sample,
+                               uint32_t from, uint32_t to,
+                               FLASH_LOG_CALLBACK callback, uint32_t *count)
+{
+    uint8_t rec[FLASH_LOG_RECORD_MAX];
+    uint16_t offset = FLASH_LOG_HEADER_SIZE;
+    uint16_t end = (sector == fl_active && !fl_empty) ?
+                   fl_offset : FLASH_LOG_SECTOR_SIZE;
+
+    while (offset < end)
+    {
+        FlashLogSample next = *sample;
+        uint8_t avail = (end - offset > sizeof(rec)) ? sizeof(rec) : end - offset;
+        uint8_t used;
+
+        if (!Flash_Log_ReadSpan(FLASH_LOG_SECTOR_ADDR(sector) + offset,
+                                rec, avail))
+        {
+            break;
+        }
+
+        used = Flash_Log_Decode(rec, avail, &next);
+        if (used == 0 || next.time > to)
+        {
+            break;
+        }
+
+        *sample = next;
+        offset += used;
+
+        if (callback && sample->time >= from)
+        {
+            callback(sample);
+            (*count)++;
+        }
+    }
+
+    return offset;
+}
+
+/*******************************************************************************
+ * Function:        bool Flash_Log_Init(void)
+ *
+ * PreCondition:    SPI2 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          true if the flash is fitted and working
+ *
+ * Overview:        Finds the newest sector from the header sequence numbers,
+ *                  follows the chain of older sectors back to build the time
+ *                  index, then walks the newest sector to the last good
+ *                  record. A record torn by a power failure closes that
+ *                  sector, appending continues in the next one. The sector
+ *                  after the newest is erased again since a reset may have
+ *                  cut its erase short
+ *
+ * Usage:           Flash_Log_Init();
+ *
+ * Note:            Logging is disabled when no flash answers or it stays
+ *                  busy for FLASH_LOG_BUSY_MS
+ ******************************************************************************/
+bool Flash_Log_Init(void)
+{
+    uint8_t id[3];
+    uint32_t seq;
+    uint32_t newest = 0;
+    FlashLogSample base;
+    uint16_t sector;
+    uint32_t count = 0;
+
+    FLASH_LOG_CS_LAT |= FLASH_LOG_CS_MASK;
+    FLASH_LOG_CS_TRIS &= ~FLASH_LOG_CS_MASK;
+    SPI_Bus_DeviceInit(&flash_spi);
+
+    fl_used = 0;
+    fl_next = 0;
+    fl_empty = true;
+    fl_active = FLASH_LOG_NONE;
+
+    // JEDEC manufacturer ID reads 0x00 or 0xFF with no flash fitted
+    SPI_Bus_Begin(&flash_spi);
+    SPI_Bus_Transfer(FLASH_CMD_JEDEC_ID);
+    SPI_Bus_Exchange(NULL, id, sizeof(id));
+    SPI_Bus_End();
+
+    fl_present = (id[0] != 0x00 && id[0] != 0xFF);
+    if (!fl_present)
+    {
+        return false;
+    }
+
+    for (sector = 0; sector < FLASH_LOG_SECTORS; sector++)
+    {
+        if (Flash_Log_ReadHeader(sector, &seq, &base) &&
+            (fl_active == FLASH_LOG_NONE || seq > newest))
+        {
+            fl_active = sector;
+            newest = seq;
+        }
+    }
+
+    if (fl_active != FLASH_LOG_NONE)
+    {
+        // Sectors were filled in order, each one seq higher
+        sector = fl_active;
+        while (fl_used < FLASH_LOG_SECTORS &&
+               Flash_Log_ReadHeader(sector, &seq, &base) &&
+               seq == newest - fl_used)
+        {
+            fl_start[sector] = base.time;
+            fl_used++;
+            sector = (sector + FLASH_LOG_SECTORS - 1) % FLASH_LOG_SECTORS;
+        }
+
+        Flash_Log_ReadHeader(fl_active, &fl_seq, &fl_last);
+        fl_offset = Flash_Log_Walk(fl_active, &fl_last, 0, UINT32_MAX,
+                                   NULL, &count);
+        fl_empty = false;
+
+        // Append in the next sector if this one ended in a bad record
+        if (fl_offset < FLASH_LOG_SECTOR_SIZE)
+        {
+            uint8_t flags = 0;
+
+            Flash_Log_ReadSpan(FLASH_LOG_SECTOR_ADDR(fl_active) + fl_offset,
+                               &flags, 1);
+            if (flags != FLASH_LOG_ERASED)
+            {
+                fl_offset = FLASH_LOG_SECTOR_SIZE;
+            }
+        }
+
+        fl_next = (fl_active + 1) % FLASH_LOG_SECTORS;
+    }
+
+    return Flash_Log_EraseAhead();
+}
+
+/*******************************************************************************
+ * Function:        bool Flash_Log_Append(const FlashLogSample *sample)
+ *
+ * PreCondition:    Flash_Log_Init() should have been called
+ *
+ * Input:           Sample to store
+ *
+ * Output:          false if no flash is fitted or it stopped answering,
+ *                  the sample is not stored
+ *
+ * Overview:        Encodes the sample as deltas from the previous one and
+ *                  programs it after the last record, opening the erased
+ *                  ahead sector when the current one is full. The erase of
+ *                  the sector after that starts last, so the record does
+ *                  not wait for it
+ *
+ * Usage:           Flash_Log_Append(&sample);
+ *
+ * Note:            Only waits when the flash is still busy with the erase
+ *                  ahead or the previous program, for FLASH_LOG_BUSY_MS at
+ *                  most. After that logging stays off until Flash_Log_Init()
+ *                  recovers what reached the flash
+ ******************************************************************************/
+bool Flash_Log_Append(const FlashLogSample *sample)
+{
+    uint8_t rec[FLASH_LOG_RECORD_MAX];
+    uint8_t length;
+    bool opened = false;
+
+    if (!fl_present)
+    {
+        return false;
+    }
+
+    if (fl_empty)
+    {
+        if (!Flash_Log_OpenSector(sample->time))
+        {
+            return false;
+        }
+        opened = true;
+    }
+
+    length = Flash_Log_Encode(rec, sample);
+
+    // The new header carries fl_last so the encoding stays the same
+    if (fl_offset + length > FLASH_LOG_SECTOR_SIZE)
+    {
+        if (!Flash_Log_OpenSector(sample->time))
+        {
+            return false;
+        }
+        opened = true;
+    }
+
+    if (!Flash_Log_WriteSpan(FLASH_LOG_SECTOR_ADDR(fl_active) + fl_offset,
+                             rec, length))
+    {
+        return false;
+    }
+
+    fl_offset += length;
+    fl_last = *sample;
+    fl_last.flags &= 0x7F;
+
+    return !opened || Flash_Log_EraseAhead();
+}
+
+/*******************************************************************************
+ * Function:        uint32_t Flash_Log_LastTime(void)
+ *
+ * PreCondition:    Flash_Log_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          Time of the newest sample, 0 if none
+ *
+ * Overview:        Lets the caller carry the log time on across a reset
+ *
+ * Usage:           Log_Time = Flash_Log_LastTime();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint32_t Flash_Log_LastTime(void)
+{
+    return fl_empty ? 0 : fl_last.time;
+}
+
+/*******************************************************************************
+ * Function:        uint32_t Flash_Log_Query(uint32_t from, uint32_t to,
+ *                  FLASH_LOG_CALLBACK callback)
+ *
+ * PreCondition:    Flash_Log_Init() should have been called
+ *
+ * Input:           Time range, inclusive, and callback
+ *
+ * Output:          Number of samples passed to the callback
+ *
+ * Overview:        Binary searches the sector index for the last sector
+ *                  starting at or before from, then decodes forward until
+ *                  a sample after to
+ *
+ * Usage:           n = Flash_Log_Query(t - 3600, t, Print_Sample);
+ *
+ * Note:            Only the sectors covering the range are read
+ ******************************************************************************/
+uint32_t Flash_Log_Query(uint32_t from, uint32_t to,
+                         FLASH_LOG_CALLBACK callback)
+{
+    uint16_t oldest;
+    uint16_t low = 0;
+    uint16_t high;
+    uint32_t count = 0;
+
+    if (!fl_present || fl_empty || from > to)
+    {
+        return 0;
+    }
+
+    oldest = (fl_active + 1 + FLASH_LOG_SECTORS - fl_used) % FLASH_LOG_SECTORS;
+    high = fl_used - 1;
+
+    while (low < high)
+    {
+        uint16_t mid = (low + high + 1) / 2;
+
+        if (fl_start[(oldest + mid) % FLASH_LOG_SECTORS] <= from)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    for (; low < fl_used; low++)
+    {
+        uint16_t sector = (oldest + low) % FLASH_LOG_SECTORS;
+        FlashLogSample sample;
+        uint32_t seq;
+
+        if (fl_start[sector] > to || !Flash_Log_ReadHeader(sector, &seq, &sample))
+        {
+            break;
+        }
+
+        Flash_Log_Walk(sector, &sample, from, to, callback, &count);
+    }
+
+    return count;
+}
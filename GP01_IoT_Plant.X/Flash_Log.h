@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * File: Flash_Log.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Long term sensor history in SPI NOR flash. Samples are
+ *                      appended to a ring of 4 KB sectors as delta encoded
+ *                      records, the sector after the one being filled is
+ *                      erased ahead of time and the write position is
+ *                      recovered at boot from the sector headers and the
+ *                      record checksums.
+ *
+ *                      Sector layout: a FLASH_LOG_HEADER_SIZE byte header
+ *                      ("FL", sector sequence number, base time and values,
+ *                      CRC-8) followed by records of
+ *
+ *                        flags, time delta, light delta, moisture delta,
+ *                        temperature delta, CRC-8
+ *
+ *                      where the deltas are LEB128 varints (signed ones zig
+ *                      zag encoded) from the previous record, or from the
+ *                      header for the first record. A steady reading takes
+ *                      6 bytes. Erased flash (flags 0xFF) ends a sector.
+ *
+ * Hardware Description: 25 series SPI NOR flash (W25Q32 or similar, 4 KB
+ *                       sector erase, 256 byte pages) on SPI2 with /CS on
+ *                       RB10
+ *
+ * Created October 19th, 2026, 6:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Chip select on RB10, active low
+#define FLASH_LOG_CS_LAT        LATB
+#define FLASH_LOG_CS_TRIS       TRISB
+#define FLASH_LOG_CS_MASK       (1 << 10)
+
+// Flash geometry
+#define FLASH_LOG_SECTOR_SIZE   4096U
+#define FLASH_LOG_PAGE_SIZE     256U
+
+// Region used by the log, each sector costs 4 bytes of RAM for the index.
+// 128 sectors hold about 80000 samples, 55 days at one per minute
+#define FLASH_LOG_BASE          0x000000UL
+#define FLASH_LOG_SECTORS       128U
+
+// Longest the flash may stay busy before logging gives up, a sector erase
+// takes 400 ms worst case
+#define FLASH_LOG_BUSY_MS       500
+
+// Sector header and largest record in bytes
+#define FLASH_LOG_HEADER_SIZE   17
+#define FLASH_LOG_RECORD_MAX    17
+
+// Record flags, bit 7 must stay clear
+#define FLASH_LOG_FLAG_LIGHT_GOOD     0x01
+#define FLASH_LOG_FLAG_MOISTURE_GOOD  0x02
+#define FLASH_LOG_FLAG_MOISTURE_NEW   0x04
+#define FLASH_LOG_FLAG_BOOT           0x08   // first sample after a reset
+#define FLASH_LOG_FLAG_TEMP_GOOD      0x10
+
+/*******************************************************************************
+ * Sample as stored and returned by queries
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t time;         // seconds of logging, must not go backwards
+    uint8_t  flags;        // FLASH_LOG_FLAG_xxx
+    uint16_t light;        // AN0 conversion
+    uint16_t moisture;     // AN1 conversion
+    int16_t  temperature;  // DS1722 reading, Q8.8 degrees C
+} FlashLogSample;
+
+// Called for every sample found by Flash_Log_Query()
+typedef void (*FLASH_LOG_CALLBACK)(const FlashLogSample *sample);
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+bool Flash_Log_Init(void);
+bool Flash_Log_Append(const FlashLogSample *sample);
+uint32_t Flash_Log_LastTime(void);
+uint32_t Flash_Log_Query(uint32_t from, uint32_t to,
+                         FLASH_LOG_CALLBACK callback);
+
+#endif  // FLASH_LOG_H
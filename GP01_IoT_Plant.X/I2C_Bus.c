@@ -0,0 +1,344 @@
+/*******************************************************************************
+ * File: I2C_Bus.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Priority arbiter for the I2C1 bus. See I2C_Bus.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 2:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "I2C_Bus.h"
+#include <string.h>
+
+// Timestamp ticks are 256 / FCY, about 8 us
+#define I2C_BUS_TICKS_TO_US(t) \
+        ((unsigned long)((uint64_t)(t) * TMR1_TIMESTAMP_PRESCALER * 1000000UL / FCY))
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static I2C_BUS_JOB * volatile i2c_bus_head[I2C_BUS_PRIO_COUNT];
+static I2C_BUS_JOB * volatile i2c_bus_tail[I2C_BUS_PRIO_COUNT];
+static I2C_BUS_STATS i2c_bus_stats[I2C_BUS_CLIENTS];
+
+/*******************************************************************************
+ * Function:        void I2C_Bus_JobInit(I2C_BUS_JOB *job, I2C_BUS_STEP step,
+ *                  void *context, uint8_t priority, uint8_t client)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Job, step function and its argument, priority and client
+ *
+ * Output:          None
+ *
+ * Overview:        Prepares a job control block for submission
+ *
+ * Usage:           I2C_Bus_JobInit(&job, Read_Step, NULL,
+ *                                  I2C_BUS_PRIO_HIGH, I2C_BUS_CLIENT_SENSOR);
+ *
+ * Note:            Must not be called while the job is busy
+ ******************************************************************************/
+void I2C_Bus_JobInit(I2C_BUS_JOB *job, I2C_BUS_STEP step, void *context,
+                     uint8_t priority, uint8_t client)
+{
+    job->step = step;
+    job->context = context;
+    job->priority = priority;
+    job->client = client;
+    job->busy = false;
+    job->started = false;
+    job->next = NULL;
+}
+
+/*******************************************************************************
+ * Function:        bool I2C_Bus_Submit(I2C_BUS_JOB *job)
+ *
+ * PreCondition:    Job initialized with I2C_Bus_JobInit()
+ *
+ * Input:           Job
+ *
+ * Output:          false if the job is already queued or running
+ *
+ * Overview:        Queues a job behind others of the same priority
+ *
+ * Usage:           I2C_Bus_Submit(&job);
+ *
+ * Note:            Safe to call from interrupts
+ ******************************************************************************/
+bool I2C_Bus_Submit(I2C_BUS_JOB *job)
+{
+    uint8_t p = job->priority;
+    uint32_t now = TMR1_TimestampGet();
+
+    // Test and set together, an interrupt could submit the same job
+    INTERRUPT_GlobalDisable();
+
+    if (job->busy)
+    {
+        INTERRUPT_GlobalEnable();
+        return false;
+    }
+
+    job->busy = true;
+    job->started = false;
+    job->next = NULL;
+    job->submitted = now;
+
+    if (i2c_bus_head[p] == NULL)
+    {
+        i2c_bus_head[p] = job;
+    }
+    else
+    {
+        i2c_bus_tail[p]->next = job;
+    }
+    i2c_bus_tail[p] = job;
+
+    INTERRUPT_GlobalEnable();
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        bool I2C_Bus_Tasks(void)
+ *
+ * PreCondition:    I2C1 and TMR1 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          true if a step was run
+ *
+ * Overview:        Runs one step of the highest priority queued job and
+ *                  charges the bus time to its client
+ *
+ * Usage:           while (I2C_Bus_Tasks());
+ *
+ * Note:            Call from main line code only
+ ******************************************************************************/
+bool I2C_Bus_Tasks(void)
+{
+    I2C_BUS_JOB *job = NULL;
+    I2C_BUS_STATS *stats;
+    uint32_t start;
+    int8_t p;
+    bool done;
+
+    for (p = I2C_BUS_PRIO_COUNT - 1; p >= 0; p--)
+    {
+        job = i2c_bus_head[p];
+
+        if (job)
+        {
+            break;
+        }
+    }
+
+    if (job == NULL)
+    {
+        return false;
+    }
+
+    stats = &i2c_bus_stats[job->client];
+    start = TMR1_TimestampGet();
+
+    if (!job->started)
+    {
+        uint32_t wait = start - job->submitted;
+
+        job->started = true;
+        if (wait > stats->maxWait)
+        {
+            stats->maxWait = wait;
+        }
+    }
+
+    done = job->step(job->context);
+
+    stats->busyTicks += TMR1_TimestampGet() - start;
+    stats->steps++;
+
+    if (done)
+    {
+        INTERRUPT_GlobalDisable();
+
+        i2c_bus_head[p] = job->next;
+        if (i2c_bus_head[p] == NULL)
+        {
+            i2c_bus_tail[p] = NULL;
+        }
+
+        INTERRUPT_GlobalEnable();
+
+        stats->jobs++;
+        job->busy = false;
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        void I2C_Bus_Wait(I2C_BUS_JOB *job)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Job
+ *
+ * Output:          None
+ *
+ * Overview:        Runs the bus until the job has completed, higher priority
+ *                  jobs submitted meanwhile run between its steps
+ *
+ * Usage:           I2C_Bus_Wait(&job);
+ *
+ * Note:            Call from main line code only
+ ******************************************************************************/
+void I2C_Bus_Wait(I2C_BUS_JOB *job)
+{
+    while (job->busy)
+    {
+        I2C_Bus_Tasks();
+    }
+}
+
+/*******************************************************************************
+ * Function:        bool I2C_Bus_Busy(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          true while any job is queued or running
+ *
+ * Overview:        Tells whether the bus still has work, I2C1 stops in
+ *                  Sleep so the CPU may only sleep once this is false
+ *
+ * Usage:           if (!I2C_Bus_Busy()) ...
+ *
+ * Note:            None
+ ******************************************************************************/
+bool I2C_Bus_Busy(void)
+{
+    uint8_t p;
+
+    for (p = 0; p < I2C_BUS_PRIO_COUNT; p++)
+    {
+        if (i2c_bus_head[p] != NULL)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+ * Function:        const I2C_BUS_STATS *I2C_Bus_Stats(uint8_t client)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Client
+ *
+ * Output:          Statistics of the client
+ *
+ * Overview:        Returns the bus time accounting of a client
+ *
+ * Usage:           ticks = I2C_Bus_Stats(I2C_BUS_CLIENT_DISPLAY)->busyTicks;
+ *
+ * Note:            None
+ ******************************************************************************/
+const I2C_BUS_STATS *I2C_Bus_Stats(uint8_t client)
+{
+    return &i2c_bus_stats[client];
+}
+
+/*******************************************************************************
+ * Function:        void I2C_Bus_StatsReset(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Clears the statistics of every client
+ *
+ * Usage:           I2C_Bus_StatsReset();
+ *
+ * Note:            None
+ ******************************************************************************/
+void I2C_Bus_StatsReset(void)
+{
+    memset(i2c_bus_stats, 0, sizeof(i2c_bus_stats));
+}
+
+/*******************************************************************************
+ * Function:        void I2C_Bus_Report(void)
+ *
+ * PreCondition:    UART1 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Prints bus time and worst queueing delay per client in
+ *                  microseconds then clears the statistics
+ *
+ * Usage:           I2C_Bus_Report();
+ *
+ * Note:            Does nothing unless I2C_BUS_REPORT is 1
+ ******************************************************************************/
+void I2C_Bus_Report(void)
+{
+#if I2C_BUS_REPORT
+    static const char *names[I2C_BUS_CLIENTS] = {"display", "log", "sensor"};
+    uint8_t i;
+
+    for (i = 0; i < I2C_BUS_CLIENTS; i++)
+    {
+        const I2C_BUS_STATS *s = &i2c_bus_stats[i];
+
+        printf("I2C %s: %u jobs %u steps busy %lu us max wait %lu us\n",
+               names[i], s->jobs, s->steps,
+               I2C_BUS_TICKS_TO_US(s->busyTicks),
+               I2C_BUS_TICKS_TO_US(s->maxWait));
+    }
+
+    I2C_Bus_StatsReset();
+#endif
+}
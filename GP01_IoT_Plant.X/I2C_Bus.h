@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * File: I2C_Bus.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Priority arbiter for the I2C1 bus. Clients submit jobs
+ *                      made of short steps, each step performs one complete
+ *                      bus transaction. Between steps the highest priority
+ *                      queued job runs next, so a long display flush can be
+ *                      cut into by a sensor read after at most one step.
+ *                      Bus time and queueing delay are accounted per client.
+ *
+ *                      Jobs may be submitted from interrupts, steps always
+ *                      run from main line code in I2C_Bus_Tasks().
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 2:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Print per client statistics from I2C_Bus_Report()
+#ifndef I2C_BUS_REPORT
+#define I2C_BUS_REPORT 0
+#endif
+
+// Job priorities, higher runs first
+typedef enum
+{
+    I2C_BUS_PRIO_LOW,          // display flushes
+    I2C_BUS_PRIO_NORMAL,       // logging
+    I2C_BUS_PRIO_HIGH,         // time critical sensor reads
+    I2C_BUS_PRIO_COUNT
+} I2C_BUS_PRIORITY;
+
+// Clients, used for bus time accounting
+typedef enum
+{
+    I2C_BUS_CLIENT_DISPLAY,
+    I2C_BUS_CLIENT_LOG,
+    I2C_BUS_CLIENT_SENSOR,
+    I2C_BUS_CLIENTS
+} I2C_BUS_CLIENT;
+
+// Performs one bus transaction, returns true once the job is complete
+typedef bool (*I2C_BUS_STEP)(void *context);
+
+// Job control block, owned by the client
+typedef struct I2C_BUS_JOB
+{
+    I2C_BUS_STEP step;
+    void *context;
+    uint8_t priority;              // I2C_BUS_PRIORITY
+    uint8_t client;                // I2C_BUS_CLIENT
+    volatile bool busy;            // queued or running
+    bool started;                  // first step has run
+    uint32_t submitted;            // TMR1 timestamp at submit
+    struct I2C_BUS_JOB *next;
+} I2C_BUS_JOB;
+
+// Per client statistics, times in TMR1 timestamp ticks (FCY/256)
+typedef struct
+{
+    uint32_t busyTicks;            // time spent in steps
+    uint32_t maxWait;              // worst submit to first step delay
+    uint16_t jobs;                 // jobs completed
+    uint16_t steps;                // steps run
+} I2C_BUS_STATS;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void I2C_Bus_JobInit(I2C_BUS_JOB *job, I2C_BUS_STEP step, void *context,
+                     uint8_t priority, uint8_t client);
+bool I2C_Bus_Submit(I2C_BUS_JOB *job);
+bool I2C_Bus_Tasks(void);
+void I2C_Bus_Wait(I2C_BUS_JOB *job);
+bool I2C_Bus_Busy(void);
+const I2C_BUS_STATS *I2C_Bus_Stats(uint8_t client);
+void I2C_Bus_StatsReset(void);
+void I2C_Bus_Report(void);
+
+#endif  // I2C_BUS_H
@@ -3,5 +3,98 @@
 // tmr1.c
 //////////////////////////////
 
+// TMR1 periods since the last soil check, counted by the ISR
+extern volatile uint16_t msCount;
+
 // power pin for soil moisture sensor
-#define POWER_PIN LATBbits.LATB15
\ No newline at end of file
+#define POWER_PIN LATBbits.LATB15
+
+// Interval between EEPROM log records, in seconds and in TMR1 timestamp
+// ticks (FCY/256)
+#define LOG_INTERVAL_S      60
+#define LOG_INTERVAL_TICKS  ((uint32_t)LOG_INTERVAL_S * (FCY / TMR1_TIMESTAMP_PRESCALER))
+
+// Longest a record waits in the EEPROM page buffer, records are also
+// written when the battery level drops
+#define LOG_FLUSH_S         300
+#define LOG_FLUSH_TICKS     ((uint32_t)LOG_FLUSH_S * (FCY / TMR1_TIMESTAMP_PRESCALER))
+
+// Time the logo stays up at boot, in TMR1 timestamp ticks
+#define LOGO_TICKS          (3UL * (FCY / TMR1_TIMESTAMP_PRESCALER))
+
+// DS1722 resolution in bits (8 to 12), conversion takes 75 ms at 8 bits
+// doubling per extra bit up to 1.2 s at 12 bits
+#define DS1722_RESOLUTION   12
+
+// Rate of the Timer3 triggers, ADC1_OVERSAMPLE triggers make one snapshot
+// of all analog inputs (1024 Hz / 16 = 64 snapshots per second)
+#define ADC_TRIGGER_RATE_HZ 1024
+
+// Thresholds are given in 10 bit counts, scaled to the oversampled result
+#define ADC_COUNTS(x)       ((uint16_t)(x) << ADC1_OVERSAMPLE_BITS)
+
+// Light classification in lux, the defaults match the old 10 bit thresholds
+// (500 and 300) on the nominal table in Lux_Cal_Table.h
+
+#define LIGHT_GOOD_LUX      16
+#define LIGHT_FAIR_LUX      5
+
+// Light band debounce, a band edge must be passed by the hysteresis, then
+// LIGHT_VOTES of the last LIGHT_WINDOW readings must agree and the band must
+// have been held for LIGHT_DWELL_S
+#define LIGHT_HYSTERESIS_LUX 1
+#define LIGHT_VOTES         3
+#define LIGHT_WINDOW        5
+#define LIGHT_DWELL_S       30
+#define LIGHT_DWELL_TICKS   ((uint32_t)LIGHT_DWELL_S * (FCY / TMR1_TIMESTAMP_PRESCALER))
+
+// Soil moisture band, read once per soil check so only the hysteresis
+// applies
+#define MOISTURE_GOOD_COUNTS       ADC_COUNTS(400)
+#define MOISTURE_HYSTERESIS_COUNTS ADC_COUNTS(20)
+
+// Temperature band the plant is comfortable in, Q8.8 degrees C, an edge
+// must be passed by the hysteresis to leave a band
+#define TEMP_COLD_Q8_8       DS1722_Q8_8(15)
+#define TEMP_HOT_Q8_8        DS1722_Q8_8(30)
+#define TEMP_HYSTERESIS_Q8_8 DS1722_Q8_8(0.5)
+
+// Moisture probe sequence, powered for PROBE_SETTLE_MS then sampled every
+// PROBE_SAMPLE_MS (longer than one ADC snapshot)
+#define PROBE_SETTLE_MS     250
+#define PROBE_SAMPLE_MS     20
+
+// Task periods in ms, the probe task must run at least every
+// PROBE_SAMPLE_MS during a reading and is suspended between readings
+#define PROBE_PERIOD_MS     10
+#define LIGHT_PERIOD_MS     1000
+#define TEMP_PERIOD_MS      2000
+#define MOISTURE_PERIOD_MS  1000
+#define BATTERY_PERIOD_MS   1000
+#define DISPLAY_PERIOD_MS   1000
+#define TELEMETRY_PERIOD_MS 1000
+
+// Battery pack, 4 Ni-MH AA cells of 2500 mAh through a 1:2 divider on AN2,
+// ADC referenced to the 3.3V rail
+#define BATTERY_CELLS          4
+#define BATTERY_CAPACITY_MAH   2500
+#define BATTERY_DIVIDER        2
+#define BATTERY_VDD_MV         3300
+#define BATTERY_SAMPLE_S       60
+
+// Current drawn in each power mode, normal, OLED off and OLED off with
+// slow ADC triggers
+#define BATTERY_ACTIVE_MA      50
+#define BATTERY_LOW_MA         35
+#define BATTERY_CRITICAL_MA    30
+
+// Part of each of them drawn by the dsPIC33 running, not drawn while it
+// sleeps
+#define BATTERY_MCU_MA         10
+
+// Charge left that enters the low and critical power modes
+#define BATTERY_LOW_PCT        20
+#define BATTERY_CRITICAL_PCT   5
+
+// ADC trigger rate in the critical power mode
+#define ADC_CRITICAL_RATE_HZ   128
\ No newline at end of file
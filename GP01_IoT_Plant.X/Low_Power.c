@@ -0,0 +1,217 @@
+/*******************************************************************************
+ * File: Low_Power.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Tickless Idle and Sleep between tasks. See
+ *                      Low_Power.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 20th, 2026, 5:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include <stdio.h>
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Low_Power.h"
+#include "SPI_Bus.h"
+#include "I2C_Bus.h"
+
+// Milliseconds to TMR1 timestamp ticks
+#define LOW_POWER_TICKS(ms) ((uint32_t)(ms) * (FCY / TMR1_TIMESTAMP_PRESCALER) / 1000)
+
+static uint32_t low_power_slept;        // ticks asleep since start up
+static uint32_t low_power_start;        // timestamp the report counts from
+static uint32_t low_power_idle;         // ticks idle since then
+static uint32_t low_power_asleep;       // low_power_slept at that time
+
+/*******************************************************************************
+ * Function:        void Low_Power_Init(void)
+ *
+ * PreCondition:    TMR1 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Starts counting the time spent awake, idle and asleep
+ *
+ * Usage:           Low_Power_Init();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Low_Power_Init(void)
+{
+    low_power_start = TMR1_TimestampGet();
+    low_power_idle = 0;
+    low_power_asleep = low_power_slept;
+}
+
+/*******************************************************************************
+ * Function:        void Low_Power_Wait(uint32_t ticks, bool sleep)
+ *
+ * PreCondition:    Low_Power_Init() should have been called
+ *
+ * Input:           Ticks until the next task is due, whether the
+ *                  peripherals that stop in Sleep may be stopped
+ *
+ * Output:          None
+ *
+ * Overview:        Sleeps one watchdog timeout when allowed and the wait
+ *                  is long enough, otherwise idles until the TMR1
+ *                  interrupt at the end of the wait or any interrupt
+ *                  before it. Never sleeps while the SPI or I2C bus has
+ *                  work, their modules and DMA stop in Sleep
+ *
+ * Usage:           Low_Power_Wait(Scheduler_NextDue(), !Probe_IsBusy());
+ *
+ * Note:            Returns after one wake up, call again with the new
+ *                  wait once pending work has been done
+ ******************************************************************************/
+void Low_Power_Wait(uint32_t ticks, bool sleep)
+{
+    uint32_t start;
+    bool held;
+
+    if (ticks == 0)
+    {
+        return;
+    }
+
+    // A transfer cut off by Sleep would stall until the next wake up
+    if (SPI_Bus_Busy() || I2C_Bus_Busy())
+    {
+        sleep = false;
+    }
+
+    if (sleep && (ticks >= LOW_POWER_TICKS(LOW_POWER_SLEEP_MIN_MS)))
+    {
+        // ADC clock and Timer3 stop in Sleep, finish the sequence being
+        // converted first
+        held = ADC1_TriggeredAcquisitionHold();
+
+        // Characters still shifting out would be cut short
+        while (!U1STAbits.TRMT);
+
+        RCONbits.WDTO = 0;
+        ClrWdt();
+        _SWDTEN = 1;
+        Sleep();
+        _SWDTEN = 0;
+
+        if (held)
+        {
+            ADC1_TriggeredAcquisitionResume();
+        }
+
+        // Nothing but the watchdog runs in Sleep, no timeout means an
+        // interrupt was pending and the CPU did not sleep at all
+        if (RCONbits.WDTO)
+        {
+            RCONbits.WDTO = 0;
+            TMR1_TimestampAdvance(LOW_POWER_TICKS(LOW_POWER_WDT_MS));
+            low_power_slept += LOW_POWER_TICKS(LOW_POWER_WDT_MS);
+        }
+
+        return;
+    }
+
+    // TMR1 continues in Idle, its next interrupt is the end of the wait
+    TMR1_WakeSet(ticks);
+
+    start = TMR1_TimestampGet();
+    Idle();
+    low_power_idle += TMR1_TimestampGet() - start;
+}
+
+/*******************************************************************************
+ * Function:        uint32_t Low_Power_SleepTicks(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Ticks spent asleep since start up
+ *
+ * Overview:        Returns the total time asleep, wraps like the TMR1
+ *                  timestamp
+ *
+ * Usage:           slept = Low_Power_SleepTicks() - last;
+ *
+ * Note:            None
+ ******************************************************************************/
+uint32_t Low_Power_SleepTicks(void)
+{
+    return low_power_slept;
+}
+
+/*******************************************************************************
+ * Function:        void Low_Power_Report(void)
+ *
+ * PreCondition:    UART1 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Prints the share of time awake, idle and asleep since
+ *                  the last report
+ *
+ * Usage:           Low_Power_Report();
+ *
+ * Note:            Does nothing unless LOW_POWER_REPORT is 1
+ ******************************************************************************/
+void Low_Power_Report(void)
+{
+#if LOW_POWER_REPORT
+    uint32_t total = TMR1_TimestampGet() - low_power_start;
+    uint32_t asleep = low_power_slept - low_power_asleep;
+    uint32_t awake = total - asleep - low_power_idle;
+
+    if (total == 0)
+    {
+        return;
+    }
+
+    printf("Power: awake %lu%% idle %lu%% sleep %lu%%\n",
+           (unsigned long)((uint64_t)awake * 100 / total),
+           (unsigned long)((uint64_t)low_power_idle * 100 / total),
+           (unsigned long)((uint64_t)asleep * 100 / total));
+
+    low_power_start += total;
+    low_power_idle = 0;
+    low_power_asleep = low_power_slept;
+#endif
+}
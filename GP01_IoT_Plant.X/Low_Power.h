@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * File: Low_Power.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Tickless low power wait between scheduled tasks.
+ *                      Short waits Idle with the TMR1 interrupt moved to
+ *                      when the next task is due. Long waits Sleep one
+ *                      watchdog timeout at a time, the 300 ms tick does not
+ *                      run and the TMR1 timestamp is moved on by the time
+ *                      slept.
+ *
+ *                      There is no 32 kHz crystal, the watchdog runs from
+ *                      the LPRC which is far less accurate than the FRC, so
+ *                      time asleep is counted at the nominal timeout.
+ *
+ *                      The time spent awake, idle and asleep is printed by
+ *                      Low_Power_Report() when LOW_POWER_REPORT is defined
+ *                      to 1.
+ *
+ * Hardware Description: None
+ *
+ * Created October 20th, 2026, 5:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef LOW_POWER_H
+#define LOW_POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Set to 1 to print the awake, idle and sleep time from Low_Power_Report()
+#ifndef LOW_POWER_REPORT
+#define LOW_POWER_REPORT 0
+#endif
+
+// Watchdog timeout that ends each Sleep, set by the WDTPRE (1:32) and
+// WDTPOST (1:128) configuration bits
+#define LOW_POWER_WDT_MS        128
+
+// Shortest wait slept through, the timeout plus the time to restart the
+// FRC and relock the PLL
+#define LOW_POWER_SLEEP_MIN_MS  (LOW_POWER_WDT_MS + 2)
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Low_Power_Init(void);
+void Low_Power_Wait(uint32_t ticks, bool sleep);
+uint32_t Low_Power_SleepTicks(void);
+void Low_Power_Report(void);
+
+#endif  // LOW_POWER_H
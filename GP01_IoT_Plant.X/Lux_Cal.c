@@ -0,0 +1,86 @@
+/*******************************************************************************
+ * File: Lux_Cal.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Photoresistor to lux conversion. See Lux_Cal.h
+ *
+ * Hardware Description: Photoresistor divider on AN0
+ *
+ * Created October 19th, 2026, 9:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "Lux_Cal.h"
+#include "Lux_Cal_Table.h"
+
+// ADC counts per table segment
+#define LUX_CAL_SHIFT       (ADC1_RESULT_BITS - LUX_CAL_SEGMENT_BITS)
+
+// const data is placed in program flash and read through the PSV window
+static const uint16_t lux_table[LUX_CAL_SEGMENTS + 1] = LUX_CAL_TABLE;
+
+/*******************************************************************************
+ * Function:        uint16_t Lux_Cal_FromADC(uint16_t counts)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Photoresistor reading in ADC counts (ADC1_RESULT_BITS)
+ *
+ * Output:          Illuminance in lux, at most LUX_CAL_MAX
+ *
+ * Overview:        Picks the table segment from the top bits of the
+ *                  reading and interpolates linearly with the rest
+ *
+ * Usage:           lux = Lux_Cal_FromADC(ADC_Read(ADC_CHANNEL_LIGHT));
+ *
+ * Note:            The table must not decrease
+ ******************************************************************************/
+uint16_t Lux_Cal_FromADC(uint16_t counts)
+{
+    uint16_t index = counts >> LUX_CAL_SHIFT;
+    uint16_t frac = counts & ((1u << LUX_CAL_SHIFT) - 1);
+    uint16_t lo;
+    uint16_t hi;
+
+    if (index >= LUX_CAL_SEGMENTS)
+    {
+        return lux_table[LUX_CAL_SEGMENTS];
+    }
+
+    lo = lux_table[index];
+    hi = lux_table[index + 1];
+
+    return lo + (uint16_t)(((uint32_t)(hi - lo) * frac) >> LUX_CAL_SHIFT);
+}
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * File: Lux_Cal.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Converts photoresistor ADC counts to lux through a
+ *                      per unit piecewise linear table kept in program flash
+ *                      (Lux_Cal_Table.h).
+ *
+ *                      The table has LUX_CAL_SEGMENTS + 1 points evenly
+ *                      spaced over the ADC range, so finding the segment is
+ *                      a shift and interpolating is one multiply.
+ *
+ *                      To calibrate a unit build with LUX_CAL_CAPTURE
+ *                      defined to 1, the counts are then printed with every
+ *                      light reading as "LUXCAL <counts> <lux>". Note the counts against a
+ *                      lux meter at a few light levels and turn them into a
+ *                      new table with tools/lux_cal_table.py
+ *
+ * Hardware Description: Photoresistor divider on AN0
+ *
+ * Created October 19th, 2026, 9:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef LUX_CAL_H
+#define LUX_CAL_H
+
+#include <stdint.h>
+
+// Set to 1 to print the counts for calibration on every light reading
+#ifndef LUX_CAL_CAPTURE
+#define LUX_CAL_CAPTURE     0
+#endif
+
+// Table segments over the ADC range (power of two)
+#define LUX_CAL_SEGMENT_BITS 5
+#define LUX_CAL_SEGMENTS    (1 << LUX_CAL_SEGMENT_BITS)
+
+// Largest value returned, the photoresistor saturates well before this
+#define LUX_CAL_MAX         65535u
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+uint16_t Lux_Cal_FromADC(uint16_t counts);
+
+#endif  // LUX_CAL_H
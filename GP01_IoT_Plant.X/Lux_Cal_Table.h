@@ -0,0 +1,58 @@
+/*******************************************************************************
+ * File: Lux_Cal_Table.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Lux calibration table for this unit, see Lux_Cal.h.
+ *                      Replace with the output of tools/lux_cal_table.py
+ *
+ *                      The default table is the nominal curve of a GL5528
+ *                      (15k at 10 lux, gamma 0.7) over a 10k resistor to
+ *                      ground.
+ *
+ * Hardware Description: Photoresistor divider on AN0
+ *
+ * Created October 19th, 2026, 9:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef LUX_CAL_TABLE_H
+#define LUX_CAL_TABLE_H
+
+// Lux at counts 0, 1/32, 2/32 ... 32/32 of full scale
+#define LUX_CAL_TABLE                                                   \
+{                                                                       \
+        0,     0,     0,     1,     1,     2,     2,     3,           \
+        4,     5,     6,     7,     9,    10,    12,    15,           \
+       18,    21,    26,    31,    37,    45,    55,    68,           \
+       86,   110,   145,   199,   288,   456,   854,  2410,           \
+    65535                                                               \
+}
+
+#endif  // LUX_CAL_TABLE_H
@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * File: Moisture_Probe.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Soil moisture probe sequencer. See Moisture_Probe.h
+ *
+ * Hardware Description: Probe supply on RB15 (POWER_PIN), probe output on
+ *                       AN1
+ *
+ * Created October 20th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "IoT_Plant_Specific.h"
+#include "adc.h"
+#include "Moisture_Probe.h"
+
+// Milliseconds to TMR1 timestamp ticks
+#define PROBE_TICKS(ms)     ((uint32_t)(ms) * (FCY / TMR1_TIMESTAMP_PRESCALER) / 1000)
+
+typedef enum
+{
+    PROBE_IDLE,
+    PROBE_SETTLING,
+    PROBE_SAMPLING
+} ProbeState;
+
+static ProbeState probe_state = PROBE_IDLE;
+static uint32_t   probe_time;           // timestamp of the next step
+static uint8_t    probe_count;          // samples taken in this burst
+static DSP_MEDIAN probe_median;
+static uint16_t   probe_result;
+static bool       probe_ready;
+
+/*******************************************************************************
+ * Function:        void Probe_Init(void)
+ *
+ * PreCondition:    SYSTEM_Initialize() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Makes the probe supply an output and switches it off
+ *
+ * Usage:           Probe_Init();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Probe_Init(void)
+{
+    POWER_PIN = OFF;
+    TRISBbits.TRISB15 = 0;
+
+    probe_state = PROBE_IDLE;
+    probe_ready = false;
+}
+
+/*******************************************************************************
+ * Function:        bool Probe_Start(void)
+ *
+ * PreCondition:    Probe_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          false if a reading is already in progress
+ *
+ * Overview:        Powers the probe and starts the settling time
+ *
+ * Usage:           if (Probe_Start()) printf("Checking soil\n");
+ *
+ * Note:            None
+ ******************************************************************************/
+bool Probe_Start(void)
+{
+    if (probe_state != PROBE_IDLE)
+    {
+        return false;
+    }
+
+    POWER_PIN = ON;
+    probe_time = TMR1_TimestampGet() + PROBE_TICKS(PROBE_SETTLE_MS);
+    probe_state = PROBE_SETTLING;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        void Probe_Tasks(void)
+ *
+ * PreCondition:    Probe_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Takes the next step of the sequence once it is due,
+ *                  returns straight away otherwise
+ *
+ * Usage:           Probe_Tasks();
+ *
+ * Note:            Call often, at least every PROBE_SAMPLE_MS while a
+ *                  reading is in progress, late calls only stretch the
+ *                  time the probe is powered
+ ******************************************************************************/
+void Probe_Tasks(void)
+{
+    int16_t sample;
+    int16_t median;
+
+    if ((probe_state == PROBE_IDLE) ||
+        ((int32_t)(TMR1_TimestampGet() - probe_time) < 0))
+    {
+        return;
+    }
+
+    // Snapshots arrive every ADC1_OVERSAMPLE triggers, PROBE_SAMPLE_MS
+    // apart each sample comes from a new one
+    sample = DSP_FROM_ADC(ADC_Read(ADC_CHANNEL_MOISTURE));
+
+    if (probe_state == PROBE_SETTLING)
+    {
+        DSP_Median_Init(&probe_median, sample);
+        median = sample;
+        probe_count = 1;
+        probe_state = PROBE_SAMPLING;
+    }
+    else
+    {
+        median = DSP_Median_Update(&probe_median, sample);
+        probe_count++;
+    }
+
+    if (probe_count < PROBE_BURST)
+    {
+        probe_time += PROBE_TICKS(PROBE_SAMPLE_MS);
+        return;
+    }
+
+    // Burst done, the window now holds exactly its samples
+    POWER_PIN = OFF;
+    probe_result = DSP_TO_ADC(median);
+    probe_ready = true;
+    probe_state = PROBE_IDLE;
+}
+
+/*******************************************************************************
+ * Function:        bool Probe_IsBusy(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          true while the probe is powered
+ *
+ * Overview:        Reports whether a reading is in progress
+ *
+ * Usage:           if (!Probe_IsBusy()) ...
+ *
+ * Note:            None
+ ******************************************************************************/
+bool Probe_IsBusy(void)
+{
+    return probe_state != PROBE_IDLE;
+}
+
+/*******************************************************************************
+ * Function:        bool Probe_ResultGet(uint16_t *counts)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Where to store the reading, in ADC counts
+ *
+ * Output:          true once for each completed reading
+ *
+ * Overview:        Hands over the median of the last burst
+ *
+ * Usage:           if (Probe_ResultGet(&moisture)) ...
+ *
+ * Note:            None
+ ******************************************************************************/
+bool Probe_ResultGet(uint16_t *counts)
+{
+    if (!probe_ready)
+    {
+        return false;
+    }
+
+    *counts = probe_result;
+    probe_ready = false;
+
+    return true;
+}
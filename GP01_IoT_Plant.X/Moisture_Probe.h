@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * File: Moisture_Probe.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Non-blocking sequencer for the soil moisture probe.
+ *                      A reading powers the probe, waits PROBE_SETTLE_MS,
+ *                      takes a burst of PROBE_BURST samples PROBE_SAMPLE_MS
+ *                      apart and powers the probe off again. The result is
+ *                      the median of the burst.
+ *
+ *                      The steps are timed on the TMR1 timestamp and run
+ *                      from Probe_Tasks() in the main loop, so the probe is
+ *                      only powered for the sequence and nothing waits.
+ *
+ * Hardware Description: Probe supply on RB15 (POWER_PIN), probe output on
+ *                       AN1
+ *
+ * Created October 20th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef MOISTURE_PROBE_H
+#define MOISTURE_PROBE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "DSP_Filter.h"
+
+// Samples in a burst, the median filter window
+#define PROBE_BURST         DSP_MEDIAN_N
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Probe_Init(void);
+bool Probe_Start(void);
+void Probe_Tasks(void);
+bool Probe_IsBusy(void);
+bool Probe_ResultGet(uint16_t *counts);
+
+#endif  // MOISTURE_PROBE_H
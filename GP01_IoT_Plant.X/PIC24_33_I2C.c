@@ -50,6 +50,22 @@
 #include "mcc_generated_files/mcc.h"
 #include "PIC24_PIC33_I2C.h"
 #include "dsPIC33_STD.h"
+#include "Bus_Trace.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Shadow register cache, one slot per attached device
+ ******************************************************************************/
+typedef struct
+{
+    uint8_t devAddr;     // device address as passed to I2C1_Write, 0 = free
+    uint8_t firstReg;    // first shadowed register
+    uint8_t numRegs;     // number of shadowed registers
+    uint8_t *regs;       // last value written or read, caller owned
+    uint8_t *valid;      // one bit per register, caller owned
+} I2C1_SHADOW;
+
+static I2C1_SHADOW i2c1_shadow[I2C1_SHADOW_SLOTS];
 
 
 /*******************************************************************************
@@ -112,12 +128,12 @@ char MasterReadI2C1(void)
 /******************************************************************************/
 void I2C1_INIT()
 {
-    I2C1BRG  =    141;     //400Khz
+    I2C1BRG  =    I2C_BRG(I2C1_DEFAULT_SPEED);
     I2C1STAT = 0x0000;
     I2C1CONbits.I2CSIDL  =   0;
     I2C1CONbits.SCLREL   =   0;
     I2C1CONbits.A10M     =   0;
-    I2C1CONbits.DISSLW   =   0;
+    I2C1CONbits.DISSLW   =   I2C_DISSLW(I2C1_DEFAULT_SPEED);
     I2C1CONbits.SMEN     =   0;
     I2C1CONbits.GCEN     =   0;
     I2C1CONbits.STREN    =   0;
@@ -130,6 +146,235 @@ void I2C1_INIT()
     I2C1CONbits.I2CEN    =   1;
 }
 
+/*******************************************************************************
+ * Function:        void I2C1_SetBaudRate(uint16_t brg, bool disslw)
+ *
+ * PreCondition:    I2C must have been initialized
+ *
+ * Input:           Baud rate generator value and slew rate control disable
+ *
+ * Output:          None
+ *
+ * Overview:        Waits for the bus to go idle then changes the bus speed
+ *                  used from the next start condition
+ *
+ * Usage:           I2C1_SetSpeed(I2C_SPEED_FAST_PLUS);
+ *
+ * Note:            Use the I2C1_SetSpeed() macro so the value is computed at
+ *                  compile time
+ ******************************************************************************/
+void I2C1_SetBaudRate(uint16_t brg, bool disslw)
+{
+    if (I2C1BRG == brg)
+    {
+        return;
+    }
+
+    I2C1_IDLE();
+    I2C1BRG = brg;
+    I2C1CONbits.DISSLW = disslw;
+}
+
+/*******************************************************************************
+ * Function:        static I2C1_SHADOW *I2C1_ShadowFind(uint8_t devAddr,
+ *                  uint8_t regAddr, uint8_t *index)
+ *
+ * Overview:        Returns the cache slot shadowing a register and the
+ *                  register's index in it, or NULL if it is not shadowed
+ ******************************************************************************/
+static I2C1_SHADOW *I2C1_ShadowFind(uint8_t devAddr, uint8_t regAddr,
+                                    uint8_t *index)
+{
+    uint8_t i;
+
+    for (i = 0; i < I2C1_SHADOW_SLOTS; i++)
+    {
+        I2C1_SHADOW *slot = &i2c1_shadow[i];
+
+        if (slot->devAddr == devAddr && devAddr != 0 &&
+            (uint8_t)(regAddr - slot->firstReg) < slot->numRegs)
+        {
+            *index = regAddr - slot->firstReg;
+            return slot;
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function:        static void I2C1_ShadowStore(uint8_t devAddr,
+ *                  uint8_t regAddr, uint8_t data)
+ *
+ * Overview:        Records a value seen on the bus if the register is
+ *                  shadowed
+ ******************************************************************************/
+static void I2C1_ShadowStore(uint8_t devAddr, uint8_t regAddr, uint8_t data)
+{
+    uint8_t index;
+    I2C1_SHADOW *slot = I2C1_ShadowFind(devAddr, regAddr, &index);
+
+    if (slot)
+    {
+        slot->regs[index] = data;
+        slot->valid[index >> 3] |= (1 << (index & 7));
+    }
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t I2C1_ReadShadowed(uint8_t devAddr,
+ *                  uint8_t regAddr)
+ *
+ * Overview:        Returns the shadowed value of a register, reading it
+ *                  from the device only when no valid copy is held
+ ******************************************************************************/
+static uint8_t I2C1_ReadShadowed(uint8_t devAddr, uint8_t regAddr)
+{
+    uint8_t index;
+    I2C1_SHADOW *slot = I2C1_ShadowFind(devAddr, regAddr, &index);
+
+    if (slot && (slot->valid[index >> 3] & (1 << (index & 7))))
+    {
+        return slot->regs[index];
+    }
+
+    return I2C1_Read(devAddr, regAddr);
+}
+
+/*******************************************************************************
+ * Function:        bool I2C1_ShadowAttach(uint8_t devAddr, uint8_t firstReg,
+ *                  uint8_t numRegs, uint8_t *regs, uint8_t *valid)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Device address, first register and number of registers
+ *                  to shadow, storage for the values and a valid bitmap of
+ *                  I2C1_SHADOW_VALID_BYTES(numRegs) bytes
+ *
+ * Output:          false if all I2C1_SHADOW_SLOTS slots are in use
+ *
+ * Overview:        Attaches a shadow register cache to a device. Bit field
+ *                  updates of shadowed registers through I2C1_WriteBit()
+ *                  and I2C1_WriteBits() then need a single write and no
+ *                  bus read once the register has been written or read
+ *
+ * Usage:           I2C1_ShadowAttach(0xD0, 0x00, 32, regs, valid);
+ *
+ * Note:            Only shadow registers the device never changes by itself,
+ *                  use I2C1_ShadowInvalidate() after a device reset
+ ******************************************************************************/
+bool I2C1_ShadowAttach(uint8_t devAddr, uint8_t firstReg, uint8_t numRegs,
+                       uint8_t *regs, uint8_t *valid)
+{
+    uint8_t i;
+
+    I2C1_ShadowDetach(devAddr);
+
+    for (i = 0; i < I2C1_SHADOW_SLOTS; i++)
+    {
+        I2C1_SHADOW *slot = &i2c1_shadow[i];
+
+        if (slot->devAddr == 0)
+        {
+            slot->firstReg = firstReg;
+            slot->numRegs = numRegs;
+            slot->regs = regs;
+            slot->valid = valid;
+            slot->devAddr = devAddr;
+            I2C1_ShadowInvalidate(devAddr);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*******************************************************************************
+ * Function:        void I2C1_ShadowDetach(uint8_t devAddr)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Device address
+ *
+ * Output:          None
+ *
+ * Overview:        Removes the shadow register cache of a device
+ *
+ * Usage:           I2C1_ShadowDetach(0xD0);
+ *
+ * Note:            None
+ ******************************************************************************/
+void I2C1_ShadowDetach(uint8_t devAddr)
+{
+    uint8_t i;
+
+    for (i = 0; i < I2C1_SHADOW_SLOTS; i++)
+    {
+        if (i2c1_shadow[i].devAddr == devAddr)
+        {
+            i2c1_shadow[i].devAddr = 0;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        void I2C1_ShadowInvalidate(uint8_t devAddr)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Device address
+ *
+ * Output:          None
+ *
+ * Overview:        Marks every shadowed register of a device stale so the
+ *                  next read-modify-write reads it back from the device
+ *
+ * Usage:           I2C1_ShadowInvalidate(0xD0);
+ *
+ * Note:            Call after a device reset or power cycle
+ ******************************************************************************/
+void I2C1_ShadowInvalidate(uint8_t devAddr)
+{
+    uint8_t i;
+
+    for (i = 0; i < I2C1_SHADOW_SLOTS; i++)
+    {
+        I2C1_SHADOW *slot = &i2c1_shadow[i];
+
+        if (slot->devAddr == devAddr && devAddr != 0)
+        {
+            memset(slot->valid, 0, I2C1_SHADOW_VALID_BYTES(slot->numRegs));
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        void I2C1_ShadowInvalidateReg(uint8_t devAddr,
+ *                  uint8_t regAddr)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Device address and register
+ *
+ * Output:          None
+ *
+ * Overview:        Marks a single shadowed register stale
+ *
+ * Usage:           I2C1_ShadowInvalidateReg(0xD0, 0x6B);
+ *
+ * Note:            Use for registers with self clearing bits
+ ******************************************************************************/
+void I2C1_ShadowInvalidateReg(uint8_t devAddr, uint8_t regAddr)
+{
+    uint8_t index;
+    I2C1_SHADOW *slot = I2C1_ShadowFind(devAddr, regAddr, &index);
+
+    if (slot)
+    {
+        slot->valid[index >> 3] &= ~(1 << (index & 7));
+    }
+}
+
 /******************************************************************************/
 void I2C1_IDLE(void)
 {
@@ -153,18 +398,27 @@ void I2C1_IDLE(void)
 /*******************************************************************************/
 void I2C1_Write(uint8_t devAddr,uint16_t regAddr,uint8_t data)
 {
+    char status;
+    BUS_TRACE_START(t_start);
     I2C1_IDLE();
     I2C1CONbits.SEN = 1;
     while (I2C1CONbits.SEN);
     IFS1bits.MI2C1IF = 0;
     
-    MasterWriteI2C1(devAddr|0);
-    MasterWriteI2C1(regAddr&0x00FF);
-    MasterWriteI2C1(data);
+    // Stop at the first byte the device does not acknowledge
+    status = MasterWriteI2C1(devAddr|0);
+    if (status == 0) status = MasterWriteI2C1(regAddr&0x00FF);
+    if (status == 0) status = MasterWriteI2C1(data);
 
     I2C1CONbits.PEN = 1;
     while(I2C1CONbits.PEN);                     
     IFS1bits.MI2C1IF = 0;
+    BUS_TRACE_LOG(BUS_TRACE_I2C1, devAddr >> 1, BUS_TRACE_WRITE, 2, t_start,
+                  status);
+    
+    // After a failed write the register may hold the old or the new value
+    if (status == 0) I2C1_ShadowStore(devAddr, regAddr, data);
+    else I2C1_ShadowInvalidateReg(devAddr, regAddr);
     __delay_ms(1);
 }
 
@@ -172,7 +426,7 @@ void I2C1_Write(uint8_t devAddr,uint16_t regAddr,uint8_t data)
 void I2C1_WriteBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data) 
 {
     uint8_t b;
-    b = I2C1_Read(devAddr, regAddr);
+    b = I2C1_ReadShadowed(devAddr, regAddr);
     
     b = (data != 0) ? (b | (1 << bitNum)) : (b & ~(1 << bitNum));
     I2C1_Write(devAddr, regAddr, b);
@@ -188,7 +442,7 @@ bool I2C1_WriteBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t
     // 10101111 original value (sample)
     // 10100011 original & ~mask
     // 10101011 masked | value
-    uint8_t b = I2C1_Read(devAddr, regAddr);
+    uint8_t b = I2C1_ReadShadowed(devAddr, regAddr);
     uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
     data <<= (bitStart - length + 1); // shift data into correct position
     data &= mask; // zero all non-important bits in data
@@ -203,7 +457,7 @@ void I2C1_WriteBytes(uint8_t devAddr,uint8_t regAddr,uint8_t len,uint8_t *dptr)
 {
     while(len--)
     {
-        I2C1_Write(devAddr,regAddr,*dptr++);
+        I2C1_Write(devAddr,regAddr++,*dptr++);
     }
 }
 
@@ -218,24 +472,40 @@ void I2C1_WriteWord(uint8_t devAddr,uint8_t regAddr,uint16_t data)
 uint8_t I2C1_Read(uint8_t devAddr,uint16_t regAddr)
 {
     uint8_t read_data=0;
+    char status;
+    BUS_TRACE_START(t_start);
 
     I2C1CONbits.SEN = 1;
     while (I2C1CONbits.SEN);
     IFS1bits.MI2C1IF = 0; 
     
-    MasterWriteI2C1(devAddr|0);
-    MasterWriteI2C1(regAddr&0x00FF);
+    status = MasterWriteI2C1(devAddr|0);
+    if (status == 0) status = MasterWriteI2C1(regAddr&0x00FF);
     
-    I2C1CONbits.RSEN = 1;
-    while(I2C1CONbits.RSEN);
-    IFS1bits.MI2C1IF = 0;  
+    if (status == 0)
+    {
+        I2C1CONbits.RSEN = 1;
+        while(I2C1CONbits.RSEN);
+        IFS1bits.MI2C1IF = 0;  
+        
+        status = MasterWriteI2C1(devAddr|1);
+    }
     
-    MasterWriteI2C1(devAddr|1);
-    read_data = MasterReadI2C1();
+    if (status == 0)
+    {
+        read_data = MasterReadI2C1();
+        NotAckI2C11();              // last byte must be NACKed before stop
+    }
 
     I2C1CONbits.PEN = 1;
     while(I2C1CONbits.PEN);
     IFS1bits.MI2C1IF = 0;
+    BUS_TRACE_LOG(BUS_TRACE_I2C1, devAddr >> 1, BUS_TRACE_READ, 1, t_start,
+                  status);
+    
+    // Nothing was read on failure, never cache the 0 returned then
+    if (status == 0) I2C1_ShadowStore(devAddr, regAddr, read_data);
+    else I2C1_ShadowInvalidateReg(devAddr, regAddr);
     return  read_data;
 }
 
@@ -243,10 +513,9 @@ uint8_t I2C1_Read(uint8_t devAddr,uint16_t regAddr)
 uint8_t I2C1readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, 
         uint8_t *data) 
 {
-    uint8_t b=0;
-    uint8_t count = I2C1_Read(devAddr, regAddr);
-    *data = b & (1 << bitNum);
-    return count;
+    uint8_t b = I2C1_Read(devAddr, regAddr);
+    *data = (b >> bitNum) & 0x01;
+    return 1;
 }
 
 /******************************************************************************/
@@ -258,7 +527,7 @@ uint8_t I2C1readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart,
     //    xxx   args: bitStart=4, length=3
     //    010   masked
     //   -> 010 shifted
-    uint8_t count=0, b=0;
+    uint8_t count=1, b=0;
     b = I2C1_Read(devAddr, regAddr);
     uint8_t mask = ((1 << length) - 1) << (bitStart - length + 1);
     b &= mask;
@@ -272,7 +541,7 @@ void I2C1readBytes(uint8_t devAddr,uint8_t regAddr,uint8_t len,uint8_t *dptr)
 {
     while(len--)
     {
-        *dptr = I2C1_Read(devAddr,regAddr);
+        *dptr++ = I2C1_Read(devAddr,regAddr++);
     }
 }
 
@@ -398,6 +667,7 @@ uint8_t IdleI2C1(void)
 uint8_t LDByteWriteI2C1(unsigned char ControlByte, unsigned char LowAdd, unsigned char data)
 {
 	uint8_t ErrorCode;
+	BUS_TRACE_START(t_start);
 
 	IdleI2C1();						//Ensure Module is Idle
 	StartI2C1();						//Generate Start COndition
@@ -414,7 +684,9 @@ uint8_t LDByteWriteI2C1(unsigned char ControlByte, unsigned char LowAdd, unsigne
 	WriteI2C1(data);					//Write Data
 	IdleI2C1();
 	StopI2C1();						//Initiate Stop Condition
-//	EEAckPolling(ControlByte);		//Perform ACK polling
+	BUS_TRACE_LOG(BUS_TRACE_I2C1, ControlByte >> 1, BUS_TRACE_WRITE, 2,
+	              t_start, ErrorCode ? 0 : -2);
+	EEAckPolling(ControlByte);		//Perform ACK polling
 	return(ErrorCode);
 }
 
@@ -433,6 +705,7 @@ uint8_t LDByteWriteI2C1(unsigned char ControlByte, unsigned char LowAdd, unsigne
 ********************************************************************/
 uint8_t LDByteReadI2C(unsigned char ControlByte, unsigned char Address, unsigned char *Data, unsigned char Length)
 {
+	BUS_TRACE_START(t_start);
 	IdleI2C1();					//wait for bus Idle
 	StartI2C1();					//Generate Start Condition
 	WriteI2C1(ControlByte);		//Write Control Byte
@@ -447,15 +720,17 @@ uint8_t LDByteReadI2C(unsigned char ControlByte, unsigned char Address, unsigned
 	getsI2C1(Data, Length);		//read Length number of bytes
 	NotAckI2C11();				//Send Not Ack
 	StopI2C1();					//Generate Stop
+	BUS_TRACE_LOG(BUS_TRACE_I2C1, ControlByte >> 1, BUS_TRACE_READ, Length,
+	              t_start, 0);
     return 0;
 }
 
 /*********************************************************************
 * Function:        LDPageWriteI2C1()
 *
-* Input:		ControlByte, LowAdd, *wrptr.
+* Input:		ControlByte, LowAdd, *wrptr, len.
 *
-* Output:		None.
+* Output:		0 on success, (uint8_t)-2 on NACK, (uint8_t)-3 on collision
 *
 * Overview:		Write a page of data from array pointed to be wrptr
 *				starting at LowAdd
@@ -464,16 +739,20 @@ uint8_t LDByteReadI2C(unsigned char ControlByte, unsigned char Address, unsigned
 ********************************************************************/
 uint8_t LDPageWriteI2C1(unsigned char ControlByte, unsigned char LowAdd, unsigned char *wrptr,unsigned char len)
 {
+	uint8_t ErrorCode;
+	BUS_TRACE_START(t_start);
 	IdleI2C1();					//wait for bus Idle
 	StartI2C1();					//Generate Start condition
 	WriteI2C1(ControlByte);		//send controlbyte for a write
 	IdleI2C1();					//wait for bus Idle
 	WriteI2C1(LowAdd);			//send low address
 	IdleI2C1();					//wait for bus Idle
-	putstringI2C1(wrptr,len);		//send data
+	ErrorCode = putstringI2C1(wrptr,len);	//send data
 	IdleI2C1();					//wait for bus Idle
 	StopI2C1();					//Generate Stop
-	return(0);
+	BUS_TRACE_LOG(BUS_TRACE_I2C1, ControlByte >> 1, BUS_TRACE_WRITE, len + 1,
+	              t_start, (int8_t)ErrorCode);
+	return(ErrorCode);
 }
 
 /*********************************************************************
@@ -492,6 +771,7 @@ uint8_t LDSequentialReadI2C(unsigned char ControlByte, unsigned char address, un
 {
     if(length)
     {
+        BUS_TRACE_START(t_start);
         IdleI2C1();						//Ensure Module is Idle
         StartI2C1();						//Initiate start condition
         WriteI2C1(ControlByte);			//write 1 byte
@@ -504,10 +784,178 @@ uint8_t LDSequentialReadI2C(unsigned char ControlByte, unsigned char address, un
         getsI2C1(rdptr, length);			//Read in multiple bytes
         NotAckI2C11();					//Send Not Ack
         StopI2C1();						//Send stop condition
+        BUS_TRACE_LOG(BUS_TRACE_I2C1, ControlByte >> 1, BUS_TRACE_READ,
+                      length, t_start, 0);
     }
 	return(0);
 }
 
+/*********************************************************************
+* Function:        HDByteWriteI2C1()
+*
+* Input:		ControlByte, HighAdd, LowAdd, data.
+*
+* Output:		ACK status of the last address byte.
+*
+* Overview:		Write a byte to high density device at address
+*				HighAdd:LowAdd
+*
+* Note:			None
+********************************************************************/
+uint8_t HDByteWriteI2C1(unsigned char ControlByte, unsigned char HighAdd, unsigned char LowAdd, unsigned char data)
+{
+	uint8_t ErrorCode;
+	BUS_TRACE_START(t_start);
+
+	IdleI2C1();						//Ensure Module is Idle
+	StartI2C1();						//Generate Start Condition
+	WriteI2C1(ControlByte);			//Write Control Byte
+	IdleI2C1();
+	WriteI2C1(HighAdd);				//Write High Address
+	IdleI2C1();
+	WriteI2C1(LowAdd);				//Write Low Address
+	IdleI2C1();
+
+	ErrorCode = ACKStatus1();		//Return ACK Status
+
+	WriteI2C1(data);					//Write Data
+	IdleI2C1();
+	StopI2C1();						//Initiate Stop Condition
+	BUS_TRACE_LOG(BUS_TRACE_I2C1, ControlByte >> 1, BUS_TRACE_WRITE, 3,
+	              t_start, ErrorCode ? 0 : -2);
+	EEAckPolling(ControlByte);		//Perform ACK polling
+	return(ErrorCode);
+}
+
+/*********************************************************************
+* Function:        HDByteReadI2C()
+*
+* Input:		ControlByte, HighAdd, LowAdd, *Data, Length.
+*
+* Output:		None.
+*
+* Overview:		Performs a high density read of Length bytes and stores
+*				in *Data array starting at HighAdd:LowAdd
+*
+* Note:			None
+********************************************************************/
+uint8_t HDByteReadI2C(unsigned char ControlByte, unsigned char HighAdd, unsigned char LowAdd, unsigned char *Data, unsigned char Length)
+{
+	return(HDSequentialReadI2C(ControlByte, HighAdd, LowAdd, Data, Length));
+}
+
+/*********************************************************************
+* Function:        HDPageWriteI2C1()
+*
+* Input:		ControlByte, HighAdd, LowAdd, *wrptr, len.
+*
+* Output:		0 on success, (uint8_t)-2 on NACK, (uint8_t)-3 on collision
+*
+* Overview:		Write len bytes from array pointed to by wrptr
+*				starting at HighAdd:LowAdd
+*
+* Note:			Data must not cross a page boundary, the device wraps
+*				around within the page
+********************************************************************/
+uint8_t HDPageWriteI2C1(unsigned char ControlByte, unsigned char HighAdd, unsigned char LowAdd, unsigned char *wrptr, unsigned char len)
+{
+	uint8_t ErrorCode;
+	BUS_TRACE_START(t_start);
+
+	IdleI2C1();					//wait for bus Idle
+	StartI2C1();					//Generate Start condition
+	WriteI2C1(ControlByte);		//send controlbyte for a write
+	IdleI2C1();					//wait for bus Idle
+	WriteI2C1(HighAdd);			//send high address
+	IdleI2C1();					//wait for bus Idle
+	WriteI2C1(LowAdd);			//send low address
+	IdleI2C1();					//wait for bus Idle
+	ErrorCode = putstringI2C1(wrptr,len);	//send data
+	IdleI2C1();					//wait for bus Idle
+	StopI2C1();					//Generate Stop
+	BUS_TRACE_LOG(BUS_TRACE_I2C1, ControlByte >> 1, BUS_TRACE_WRITE, len + 2,
+	              t_start, (int8_t)ErrorCode);
+	return(ErrorCode);
+}
+
+/*********************************************************************
+* Function:        HDSequentialReadI2C()
+*
+* Input:		ControlByte, HighAdd, LowAdd, *rdptr, length.
+*
+* Output:		None.
+*
+* Overview:		Performs a sequential read of length bytes starting at
+*				HighAdd:LowAdd and places data in array pointed to by
+*				*rdptr
+*
+* Note:			None
+********************************************************************/
+uint8_t HDSequentialReadI2C(unsigned char ControlByte, unsigned char HighAdd, unsigned char LowAdd, unsigned char *rdptr, unsigned char length)
+{
+    if(length)
+    {
+        BUS_TRACE_START(t_start);
+        IdleI2C1();						//Ensure Module is Idle
+        StartI2C1();						//Initiate start condition
+        WriteI2C1(ControlByte);			//write 1 byte
+        IdleI2C1();						//Ensure module is Idle
+        WriteI2C1(HighAdd);				//Write high word address
+        IdleI2C1();						//Ensure module is idle
+        WriteI2C1(LowAdd);				//Write low word address
+        IdleI2C1();						//Ensure module is idle
+        RestartI2C1();					//Generate I2C Restart Condition
+        WriteI2C1(ControlByte | 0x01);	//Write 1 byte - R/W bit should be 1 for read
+        IdleI2C1();						//Ensure bus is idle
+        getsI2C1(rdptr, length);			//Read in multiple bytes
+        NotAckI2C11();					//Send Not Ack
+        StopI2C1();						//Send stop condition
+        BUS_TRACE_LOG(BUS_TRACE_I2C1, ControlByte >> 1, BUS_TRACE_READ,
+                      length, t_start, 0);
+    }
+	return(0);
+}
+
+/*********************************************************************
+* Function:        EEAckPolling()
+*
+* Input:		Control byte.
+*
+* Output:		0 once the device acknowledges, (uint8_t)-1 on bus
+*				collision, (uint8_t)-2 if the device never acknowledges
+*
+* Overview:		Polls an EEPROM with its control byte until it ACKs,
+*				which it does once its internal write cycle is complete
+*
+* Note:			Gives up after EE_ACK_POLL_LIMIT attempts so a missing
+*				device cannot hang the bus
+********************************************************************/
+uint8_t EEAckPolling(unsigned char ControlByte)
+{
+	uint16_t attempts = 0;
+
+	IdleI2C1();						//Ensure Module is Idle
+	StartI2C1();						//Generate Start Condition
+	WriteI2C1(ControlByte);			//Write Control Byte
+	IdleI2C1();
+
+	while(I2C1STATbits.ACKSTAT)		//Device busy while NACKing
+	{
+		if(I2C1STATbits.BCL || ++attempts >= EE_ACK_POLL_LIMIT)
+		{
+			StopI2C1();
+			return(I2C1STATbits.BCL ? -1 : -2);
+		}
+
+		RestartI2C1();				//Generate Restart Condition
+		WriteI2C1(ControlByte);		//Poll again
+		IdleI2C1();
+	}
+
+	StopI2C1();						//Initiate Stop Condition
+	return(0);
+}
+
 /*********************************************************************
 * Function:        ACKStatus1()
 *
@@ -111,7 +111,7 @@ char MasterReadI2C2(void)
 /******************************************************************************/
 void I2C2_INIT()
 {
-    I2C2BRG  =    141;     //400Khz
+    I2C2BRG  =    I2C_BRG(I2C2_SPEED);
     I2C2STAT = 0x0000;
     I2C2CONbits.I2CSIDL  =   0;
     I2C2CONbits.SCLREL   =   0;
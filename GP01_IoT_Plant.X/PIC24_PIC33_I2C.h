@@ -50,9 +50,45 @@
 // Used by writing string to I2C
 #define PAGESIZE 16
 
+// ACK polls before EEAckPolling() gives up, a 5 ms write cycle takes
+// about 50 polls at 100 kHz and 500 at 1 MHz
+#define EE_ACK_POLL_LIMIT 1000
+
+// Devices that can have a shadow register cache attached at once
+#ifndef I2C1_SHADOW_SLOTS
+#define I2C1_SHADOW_SLOTS 2
+#endif
+
+// Bytes of valid bitmap needed to shadow n registers
+#define I2C1_SHADOW_VALID_BYTES(n) (((n) + 7) / 8)
+
+// Bus speeds in Hz
+#define I2C_SPEED_STANDARD      100000UL
+#define I2C_SPEED_FAST          400000UL
+#define I2C_SPEED_FAST_PLUS    1000000UL
+
+// Speed used after initialization and for all devices that do not switch
+#define I2C1_DEFAULT_SPEED      I2C_SPEED_STANDARD
+
+// Baud rate generator reload value for a bus speed, evaluated at compile
+// time from FCY. I2CxBRG = ((1/FSCL - PGD) * FCY) - 2 with the 130 ns pulse
+// gobbler delay of the dsPIC33E, e.g. 314, 74 and 26 at FCY = 32 MHz
+#ifndef I2C_BRG
+#define I2C_BRG(fscl)  ((uint16_t)(((FCY) / (fscl)) \
+                        - (((FCY) / 1000000UL) * 130UL / 1000UL) - 2))
+#endif
+
+// Slew rate control is only meant for 400 kHz, disabled otherwise
+#define I2C_DISSLW(fscl)  ((fscl) != I2C_SPEED_FAST)
+
+// Switch I2C1 speed between transaction groups, e.g.
+// I2C1_SetSpeed(I2C_SPEED_FAST_PLUS);
+#define I2C1_SetSpeed(fscl)  I2C1_SetBaudRate(I2C_BRG(fscl), I2C_DISSLW(fscl))
+
 // General High Level Functions
 void I2C1_INIT(void);
 void I2C1_IDLE(void);
+void I2C1_SetBaudRate(uint16_t brg, bool disslw);
     
 void I2C1_Write(uint8_t devAddr,uint16_t regAddr,uint8_t data);
 void I2C1_WriteBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t data);
@@ -63,6 +99,12 @@ uint8_t I2C1_Read(uint8_t devAddr,uint16_t regAddr);
 uint8_t I2C1readBit(uint8_t devAddr, uint8_t regAddr, uint8_t bitNum, uint8_t *data);
 uint8_t I2C1readBits(uint8_t devAddr, uint8_t regAddr, uint8_t bitStart, uint8_t length, uint8_t *data);
 void I2C1readBytes(uint8_t devAddr,uint8_t regAddr,uint8_t len,uint8_t *dptr);
+
+// Shadow register cache for read-modify-write of write-mostly registers
+bool I2C1_ShadowAttach(uint8_t devAddr, uint8_t firstReg, uint8_t numRegs, uint8_t *regs, uint8_t *valid);
+void I2C1_ShadowDetach(uint8_t devAddr);
+void I2C1_ShadowInvalidate(uint8_t devAddr);
+void I2C1_ShadowInvalidateReg(uint8_t devAddr, uint8_t regAddr);
 void I2C1_page_Write(unsigned char deviceId,unsigned char address,unsigned char len,unsigned char *dataptr);
 void I2C1_page_Read(unsigned char deviceId,unsigned char address,unsigned char len,unsigned char *dataptr);
 
@@ -46,10 +46,12 @@
 
 #include "dsPIC33_STD.h"
 #include "mcc_generated_files/mcc.h"
+#include "PIC24_PIC33_I2C.h"
 #include <stdint.h>
 
-// Used by writing string to I2C
-#define PAGESIZE 16
+// Bus speed used by I2C2_INIT(). PAGESIZE, the speeds and I2C_BRG() come
+// from PIC24_PIC33_I2C.h so both modules share one formula
+#define I2C2_SPEED              I2C_SPEED_FAST
 
 // General High Level Functions
 void I2C2_INIT(void);
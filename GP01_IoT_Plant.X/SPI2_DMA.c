@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * File: SPI2_DMA.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: DMA driven SPI2 transfers. See SPI2_DMA.h
+ *
+ * Hardware Description: SPI2, DMA channels 0 (TX) and 1 (RX)
+ *
+ * Created October 19th, 2026, 5:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "SPI2_DMA.h"
+
+// DMAxCON: byte transfers, one-shot, ping-pong off
+#define DMA_CON_SIZE_BYTE   0x4000
+#define DMA_CON_DIR_TO_PER  0x2000      // RAM to peripheral
+#define DMA_CON_NO_INC      0x0010      // register indirect, no increment
+#define DMA_CON_ONE_SHOT    0x0001
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static volatile bool spi2_dma_busy;
+static SPI2_DMA_CALLBACK spi2_dma_callback;
+
+// Source of dummy bytes for reads and sink for discarded bytes
+static uint8_t spi2_dma_dummy = SPI2_DUMMY_DATA;
+static uint8_t spi2_dma_sink;
+
+/*******************************************************************************
+ * Function:        void SPI2_DMA_Initialize(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Sets up the DMA1 completion interrupt
+ *
+ * Usage:           SPI2_DMA_Initialize();
+ *
+ * Note:            None
+ ******************************************************************************/
+void SPI2_DMA_Initialize(void)
+{
+    DMA0CONbits.CHEN = 0;
+    DMA1CONbits.CHEN = 0;
+
+    IPC3bits.DMA1IP = SPI2_DMA_PRIORITY;
+    IFS0bits.DMA0IF = 0;
+    IFS0bits.DMA1IF = 0;
+    IEC0bits.DMA0IE = 0;
+    IEC0bits.DMA1IE = 0;
+
+    spi2_dma_busy = false;
+}
+
+/*******************************************************************************
+ * Function:        bool SPI2_DMA_Start(const uint8_t *tx, uint8_t *rx,
+ *                  uint16_t length, SPI2_DMA_CALLBACK done)
+ *
+ * PreCondition:    SPI2 enabled as master with SPIBEN = 0, chip select of
+ *                  the slave asserted
+ *
+ * Input:           Data to send (NULL sends SPI2_DUMMY_DATA), receive
+ *                  buffer (NULL discards), number of bytes and completion
+ *                  callback (may be NULL)
+ *
+ * Output:          false if a transfer is already running
+ *
+ * Overview:        Programs DMA1 to move every received byte to RAM and DMA0
+ *                  to load the next byte to send, then forces the first
+ *                  DMA0 request to start the transfer. Returns immediately
+ *
+ * Usage:           SPI2_DMA_Start(page, NULL, 256, Flash_Done);
+ *
+ * Note:            Buffers must be in data RAM, not const data in program
+ *                  memory, and stay valid until the callback has run
+ ******************************************************************************/
+bool SPI2_DMA_Start(const uint8_t *tx, uint8_t *rx, uint16_t length,
+                    SPI2_DMA_CALLBACK done)
+{
+    uint8_t dummy;
+
+    if (spi2_dma_busy || length == 0)
+    {
+        return false;
+    }
+
+    spi2_dma_busy = true;
+    spi2_dma_callback = done;
+
+    // Throw away anything left in the receive buffer
+    while (SPI2STATbits.SPIRBF)
+    {
+        dummy = SPI2BUF;
+    }
+    (void)dummy;
+    SPI2STATbits.SPIROV = 0;
+
+    // DMA1: SPI2BUF to RAM
+    DMA1CON = DMA_CON_SIZE_BYTE | DMA_CON_ONE_SHOT |
+              (rx ? 0 : DMA_CON_NO_INC);
+    DMA1REQ = SPI2_DMA_IRQ;
+    DMA1PAD = (volatile unsigned int)&SPI2BUF;
+    DMA1STAL = (unsigned int)(rx ? rx : &spi2_dma_sink);
+    DMA1STAH = 0;
+    DMA1CNT = length - 1;
+
+    // DMA0: RAM to SPI2BUF
+    DMA0CON = DMA_CON_SIZE_BYTE | DMA_CON_DIR_TO_PER | DMA_CON_ONE_SHOT |
+              (tx ? 0 : DMA_CON_NO_INC);
+    DMA0REQ = SPI2_DMA_IRQ;
+    DMA0PAD = (volatile unsigned int)&SPI2BUF;
+    DMA0STAL = (unsigned int)(tx ? tx : &spi2_dma_dummy);
+    DMA0STAH = 0;
+    DMA0CNT = length - 1;
+
+    IFS0bits.DMA1IF = 0;
+    IEC0bits.DMA1IE = 1;
+
+    DMA1CONbits.CHEN = 1;
+    DMA0CONbits.CHEN = 1;
+
+    // Send the first byte, the rest follow on each transfer done event
+    DMA0REQbits.FORCE = 1;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        bool SPI2_DMA_IsBusy(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          true while a transfer is running
+ *
+ * Overview:        Returns the transfer state
+ *
+ * Usage:           while (SPI2_DMA_IsBusy());
+ *
+ * Note:            None
+ ******************************************************************************/
+bool SPI2_DMA_IsBusy(void)
+{
+    return spi2_dma_busy;
+}
+
+/*******************************************************************************
+ * Function:        void _DMA1Interrupt(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Last byte received, both channels have stopped (one-shot)
+ *
+ * Usage:           None
+ *
+ * Note:            Callback runs at SPI2_DMA_PRIORITY
+ ******************************************************************************/
+void __attribute__ ( ( interrupt, no_auto_psv ) ) _DMA1Interrupt ( void )
+{
+    IFS0bits.DMA1IF = 0;
+    IEC0bits.DMA1IE = 0;
+
+    spi2_dma_busy = false;
+
+    if (spi2_dma_callback)
+    {
+        spi2_dma_callback();
+    }
+}
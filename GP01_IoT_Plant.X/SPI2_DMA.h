@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * File: SPI2_DMA.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: DMA driven SPI2 transfers. DMA0 feeds SPI2BUF from RAM
+ *                      and DMA1 drains it into RAM, both triggered by the SPI2
+ *                      transfer done event, so the CPU is free while a buffer
+ *                      is exchanged. Completion is reported through a callback
+ *                      from the DMA1 interrupt.
+ *
+ *                      SPI2 must run with the enhanced buffer disabled
+ *                      (SPIBEN = 0) while a DMA transfer is active.
+ *
+ * Hardware Description: SPI2, DMA channels 0 and 1
+ *
+ * Created October 19th, 2026, 5:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SPI2_DMA_H
+#define SPI2_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DMA request source: SPI2 transfer done
+#define SPI2_DMA_IRQ        0x21
+
+// Interrupt priority of the DMA1 completion interrupt
+#define SPI2_DMA_PRIORITY   2
+
+// Called from the DMA1 interrupt once the last byte has been received
+typedef void (*SPI2_DMA_CALLBACK)(void);
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void SPI2_DMA_Initialize(void);
+bool SPI2_DMA_Start(const uint8_t *tx, uint8_t *rx, uint16_t length,
+                    SPI2_DMA_CALLBACK done);
+bool SPI2_DMA_IsBusy(void);
+
+#endif  // SPI2_DMA_H
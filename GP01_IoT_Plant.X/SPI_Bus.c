@@ -0,0 +1,522 @@
+/*******************************************************************************
+ * File: SPI_Bus.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Shared SPI2 bus layer. See SPI_Bus.h
+ *
+ * Hardware Description: SPI2
+ *
+ * Created October 19th, 2026, 4:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "SPI_Bus.h"
+#include "Bus_Trace.h"
+#include "SPI2_DMA.h"
+#include <string.h>
+
+// SPI2CON2 enhanced buffer enable, cleared while DMA owns the bus
+#define SPI_BUS_CON2_SPIBEN 0x0001
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const SPI_DEVICE *spi_bus_device;    // device selected, NULL if none
+static uint16_t spi_bus_con1;               // SPI2CON1 currently loaded
+static uint16_t spi_bus_con2;               // SPI2CON2 currently loaded
+static uint16_t spi_bus_count;              // bytes in current transaction
+static bool     spi_bus_read;               // data was read back
+#if BUS_TRACE_ENABLE
+static uint32_t spi_bus_start;              // trace timestamp of Begin
+#endif
+
+static SPI_TRANSACTION * volatile spi_bus_head;
+static SPI_TRANSACTION * volatile spi_bus_tail;
+
+static SPI_TRANSACTION *spi_bus_dma;        // transaction on DMA, NULL if none
+static volatile bool spi_bus_dma_done;      // set by the DMA interrupt
+#if BUS_TRACE_ENABLE
+static uint32_t spi_bus_dma_start;
+#endif
+
+/*******************************************************************************
+ * Function:        static void SPI_Bus_Select(const SPI_DEVICE *device,
+ *                  bool select)
+ *
+ * Overview:        Drives the chip select of a device to its active or
+ *                  inactive level
+ ******************************************************************************/
+static void SPI_Bus_Select(const SPI_DEVICE *device, bool select)
+{
+    if (select == device->csActiveHigh)
+    {
+        *device->csLat |= device->csMask;
+    }
+    else
+    {
+        *device->csLat &= ~device->csMask;
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void SPI_Bus_Setup(const SPI_DEVICE *device,
+ *                  uint16_t con2)
+ *
+ * Overview:        Waits for any DMA transfer to finish, reloads SPI2CON1
+ *                  and SPI2CON2 if they differ from what is loaded then
+ *                  asserts the chip select of the device, at least
+ *                  SPI_BUS_CS_IDLE_US after the previous transaction
+ ******************************************************************************/
+static void SPI_Bus_Setup(const SPI_DEVICE *device, uint16_t con2)
+{
+    while (SPI2_DMA_IsBusy());
+
+    if (spi_bus_con1 != device->con1 || spi_bus_con2 != con2)
+    {
+        // Let a previous transfer finish before switching
+        while (SPI2STATbits.SPIBEC || !SPI2STATbits.SRMPT);
+
+        SPI2STATbits.SPIEN = 0;
+        SPI2CON1 = device->con1;
+        SPI2CON2 = con2;
+        SPI2STATbits.SPIEN = 1;
+        spi_bus_con1 = device->con1;
+        spi_bus_con2 = con2;
+    }
+
+    spi_bus_device = device;
+    spi_bus_count = 0;
+    spi_bus_read = false;
+#if BUS_TRACE_ENABLE
+    spi_bus_start = TMR1_TimestampGet();
+#endif
+
+    // End() may have released a chip select only a few cycles ago
+    __delay_us(SPI_BUS_CS_IDLE_US);
+
+    SPI_Bus_Select(device, true);
+}
+
+/*******************************************************************************
+ * Function:        static void SPI_Bus_DmaDone(void)
+ *
+ * Overview:        DMA completion callback, releases the chip select as soon
+ *                  as the last byte is in. Runs in the DMA1 interrupt
+ ******************************************************************************/
+static void SPI_Bus_DmaDone(void)
+{
+    SPI_Bus_Select(spi_bus_dma->device, false);
+    spi_bus_dma_done = true;
+}
+
+/*******************************************************************************
+ * Function:        void SPI_Bus_DeviceInit(const SPI_DEVICE *device)
+ *
+ * PreCondition:    Chip select pin configured as output
+ *
+ * Input:           Device
+ *
+ * Output:          None
+ *
+ * Overview:        Puts the chip select of a device in its inactive state
+ *
+ * Usage:           SPI_Bus_DeviceInit(&ds1722_spi);
+ *
+ * Note:            Call for every device before the first transaction
+ ******************************************************************************/
+void SPI_Bus_DeviceInit(const SPI_DEVICE *device)
+{
+    SPI_Bus_Select(device, false);
+}
+
+/*******************************************************************************
+ * Function:        void SPI_Bus_Begin(const SPI_DEVICE *device)
+ *
+ * PreCondition:    SPI2 should have been initialized
+ *
+ * Input:           Device
+ *
+ * Output:          None
+ *
+ * Overview:        Loads the mode and clock of the device into SPI2CON1 if
+ *                  it differs from the last device then asserts its chip
+ *                  select
+ *
+ * Usage:           SPI_Bus_Begin(&ds1722_spi);
+ *
+ * Note:            SPI2CON1 can only be written with the module disabled.
+ *                  Blocks while a DMA transfer is running
+ ******************************************************************************/
+void SPI_Bus_Begin(const SPI_DEVICE *device)
+{
+    SPI_Bus_Setup(device, SPI_BUS_CON2_SPIBEN);
+}
+
+/*******************************************************************************
+ * Function:        void SPI_Bus_End(void)
+ *
+ * PreCondition:    SPI_Bus_Begin() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Releases the chip select and records the transaction in
+ *                  the bus trace
+ *
+ * Usage:           SPI_Bus_End();
+ *
+ * Note:            None
+ ******************************************************************************/
+void SPI_Bus_End(void)
+{
+    SPI_Bus_Select(spi_bus_device, false);
+
+    BUS_TRACE_LOG(BUS_TRACE_SPI2, spi_bus_device->traceId,
+                  spi_bus_read ? BUS_TRACE_READ : BUS_TRACE_WRITE,
+                  spi_bus_count, spi_bus_start, 0);
+
+    spi_bus_device = NULL;
+}
+
+/*******************************************************************************
+ * Function:        uint8_t SPI_Bus_Transfer(uint8_t data)
+ *
+ * PreCondition:    SPI_Bus_Begin() should have been called
+ *
+ * Input:           Byte to send
+ *
+ * Output:          Byte received
+ *
+ * Overview:        Exchanges a single byte with the selected device
+ *
+ * Usage:           lsb = SPI_Bus_Transfer(0x00);
+ *
+ * Note:            None
+ ******************************************************************************/
+uint8_t SPI_Bus_Transfer(uint8_t data)
+{
+    spi_bus_count++;
+    return SPI2_Exchange8bit(data);
+}
+
+/*******************************************************************************
+ * Function:        void SPI_Bus_Exchange(const uint8_t *tx, uint8_t *rx,
+ *                  uint16_t length)
+ *
+ * PreCondition:    SPI_Bus_Begin() should have been called
+ *
+ * Input:           Data to send (NULL for dummy bytes), receive buffer (NULL
+ *                  to discard) and number of bytes
+ *
+ * Output:          None
+ *
+ * Overview:        Exchanges a buffer with the selected device
+ *
+ * Usage:           SPI_Bus_Exchange(cmd, NULL, 4);
+ *
+ * Note:            None
+ ******************************************************************************/
+void SPI_Bus_Exchange(const uint8_t *tx, uint8_t *rx, uint16_t length)
+{
+    spi_bus_count += length;
+    if (rx)
+    {
+        spi_bus_read = true;
+    }
+
+    SPI2_Exchange8bitBuffer((uint8_t *)tx, length, rx);
+}
+
+/*******************************************************************************
+ * Function:        void SPI_Bus_ReadRegisters(const SPI_DEVICE *device,
+ *                  uint8_t command, uint8_t *data, uint16_t count)
+ *
+ * PreCondition:    SPI2 should have been initialized
+ *
+ * Input:           Device, read command (register address), destination
+ *                  and number of registers
+ *
+ * Output:          None
+ *
+ * Overview:        Reads consecutive registers in one chip select cycle. Up
+ *                  to SPI2_FIFO_FILL_LIMIT - 1 registers go out as a single
+ *                  burst, one fill and drain of the enhanced buffer
+ *
+ * Usage:           SPI_Bus_ReadRegisters(&ds1722_spi, 0x01, data, 2);
+ *
+ * Note:            For devices which auto increment the register address
+ ******************************************************************************/
+void SPI_Bus_ReadRegisters(const SPI_DEVICE *device, uint8_t command,
+                           uint8_t *data, uint16_t count)
+{
+    uint8_t burst[SPI2_FIFO_FILL_LIMIT];
+
+    SPI_Bus_Begin(device);
+
+    if (count < SPI2_FIFO_FILL_LIMIT)
+    {
+        // Exchanged in place, byte n is always sent before it is received
+        burst[0] = command;
+        memset(&burst[1], SPI2_DUMMY_DATA, count);
+        SPI_Bus_Exchange(burst, burst, count + 1);
+        memcpy(data, &burst[1], count);
+    }
+    else
+    {
+        SPI_Bus_Exchange(&command, NULL, 1);
+        SPI_Bus_Exchange(NULL, data, count);
+    }
+
+    SPI_Bus_End();
+}
+
+/*******************************************************************************
+ * Function:        void SPI_Bus_WriteRegisters(const SPI_DEVICE *device,
+ *                  uint8_t command, const uint8_t *data, uint16_t count)
+ *
+ * PreCondition:    SPI2 should have been initialized
+ *
+ * Input:           Device, write command (register address), data and number
+ *                  of registers
+ *
+ * Output:          None
+ *
+ * Overview:        Writes consecutive registers in one chip select cycle,
+ *                  as a single burst when they fit the enhanced buffer
+ *
+ * Usage:           SPI_Bus_WriteRegisters(&ds1722_spi, 0x80, &config, 1);
+ *
+ * Note:            None
+ ******************************************************************************/
+void SPI_Bus_WriteRegisters(const SPI_DEVICE *device, uint8_t command,
+                            const uint8_t *data, uint16_t count)
+{
+    uint8_t burst[SPI2_FIFO_FILL_LIMIT];
+
+    SPI_Bus_Begin(device);
+
+    if (count < SPI2_FIFO_FILL_LIMIT)
+    {
+        burst[0] = command;
+        memcpy(&burst[1], data, count);
+        SPI_Bus_Exchange(burst, NULL, count + 1);
+    }
+    else
+    {
+        SPI_Bus_Exchange(&command, NULL, 1);
+        SPI_Bus_Exchange(data, NULL, count);
+    }
+
+    SPI_Bus_End();
+}
+
+/*******************************************************************************
+ * Function:        bool SPI_Bus_Submit(SPI_TRANSACTION *t)
+ *
+ * PreCondition:    Transaction device, buffers and length filled in
+ *
+ * Input:           Transaction
+ *
+ * Output:          false if the transaction is already queued
+ *
+ * Overview:        Queues a transaction to run from SPI_Bus_Tasks()
+ *
+ * Usage:           SPI_Bus_Submit(&t);
+ *
+ * Note:            Safe to call from interrupts
+ ******************************************************************************/
+bool SPI_Bus_Submit(SPI_TRANSACTION *t)
+{
+    // Test and set together, an interrupt could submit the same transaction
+    INTERRUPT_GlobalDisable();
+
+    if (t->busy)
+    {
+        INTERRUPT_GlobalEnable();
+        return false;
+    }
+
+    t->busy = true;
+    t->next = NULL;
+
+    if (spi_bus_head == NULL)
+    {
+        spi_bus_head = t;
+    }
+    else
+    {
+        spi_bus_tail->next = t;
+    }
+    spi_bus_tail = t;
+
+    INTERRUPT_GlobalEnable();
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        bool SPI_Bus_Tasks(void)
+ *
+ * PreCondition:    SPI2 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          true if a transaction was started or completed
+ *
+ * Overview:        Runs the oldest queued transaction and calls its done
+ *                  callback. Transactions of SPI_BUS_DMA_MIN bytes or more
+ *                  are handed to DMA and completed on a later call, after
+ *                  the DMA interrupt has released the chip select
+ *
+ * Usage:           SPI_Bus_Tasks();
+ *
+ * Note:            Call from main line code only. Buffers of DMA
+ *                  transactions must be in RAM
+ ******************************************************************************/
+bool SPI_Bus_Tasks(void)
+{
+    SPI_TRANSACTION *t = spi_bus_head;
+
+    if (spi_bus_dma != NULL)
+    {
+        if (!spi_bus_dma_done)
+        {
+            return false;
+        }
+
+        t = spi_bus_dma;
+        spi_bus_dma = NULL;
+
+        // Duration includes the time until this call picked up completion
+        BUS_TRACE_LOG(BUS_TRACE_SPI2, t->device->traceId,
+                      t->rx ? BUS_TRACE_READ : BUS_TRACE_WRITE,
+                      t->length, spi_bus_dma_start, 0);
+    }
+    else if (t == NULL)
+    {
+        return false;
+    }
+    else if (t->length >= SPI_BUS_DMA_MIN)
+    {
+        SPI_Bus_Setup(t->device, 0);
+#if BUS_TRACE_ENABLE
+        spi_bus_dma_start = spi_bus_start;
+#endif
+        spi_bus_device = NULL;
+
+        spi_bus_dma = t;
+        spi_bus_dma_done = false;
+        SPI2_DMA_Start(t->tx, t->rx, t->length, SPI_Bus_DmaDone);
+
+        return true;
+    }
+    else
+    {
+        SPI_Bus_Begin(t->device);
+        SPI_Bus_Exchange(t->tx, t->rx, t->length);
+        SPI_Bus_End();
+    }
+
+    INTERRUPT_GlobalDisable();
+
+    spi_bus_head = t->next;
+    if (spi_bus_head == NULL)
+    {
+        spi_bus_tail = NULL;
+    }
+
+    INTERRUPT_GlobalEnable();
+
+    t->busy = false;
+
+    if (t->done)
+    {
+        t->done(t);
+    }
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        void SPI_Bus_Wait(SPI_TRANSACTION *t)
+ *
+ * PreCondition:    Transaction submitted
+ *
+ * Input:           Transaction
+ *
+ * Output:          None
+ *
+ * Overview:        Runs the bus until the transaction has completed,
+ *                  transactions queued before it run first
+ *
+ * Usage:           SPI_Bus_Wait(&t);
+ *
+ * Note:            Call from main line code only
+ ******************************************************************************/
+void SPI_Bus_Wait(SPI_TRANSACTION *t)
+{
+    while (t->busy)
+    {
+        if (!SPI_Bus_Tasks())
+        {
+            Nop();      // DMA is moving the data
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        bool SPI_Bus_Busy(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          true while a transaction is queued or on DMA
+ *
+ * Overview:        Tells whether the bus still has work. SPI2 and DMA stop
+ *                  in Sleep, so the CPU may only sleep once this is false
+ *
+ * Usage:           if (!SPI_Bus_Busy()) ...
+ *
+ * Note:            A DMA transfer stays busy until SPI_Bus_Tasks() has
+ *                  picked up its completion
+ ******************************************************************************/
+bool SPI_Bus_Busy(void)
+{
+    return (spi_bus_head != NULL) || (spi_bus_dma != NULL) ||
+           SPI2_DMA_IsBusy();
+}
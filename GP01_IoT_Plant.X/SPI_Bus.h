@@ -0,0 +1,122 @@
+/*******************************************************************************
+ * File: SPI_Bus.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Shared SPI2 bus layer. Each slave is described once by
+ *                      an SPI_DEVICE (chip select pin and polarity, SPI mode,
+ *                      clock prescalers). SPI_Bus_Begin() reconfigures
+ *                      SPI2CON1 only when the next device needs a different
+ *                      setup, asserts chip select and starts the bus trace,
+ *                      SPI_Bus_End() releases it again. Transactions can also
+ *                      be queued and are then run from SPI_Bus_Tasks().
+ *
+ * Hardware Description: SPI2, SCK2 on RB4, SDI2 on RB5, SDO2 on RB6
+ *
+ * Created October 19th, 2026, 4:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// SPI modes as SPI2CON1 CKP/CKE bits (CKE = !CPHA)
+#define SPI_MODE0           0x0100      // CPOL 0, CPHA 0
+#define SPI_MODE1           0x0000      // CPOL 0, CPHA 1
+#define SPI_MODE2           0x0140      // CPOL 1, CPHA 0
+#define SPI_MODE3           0x0040      // CPOL 1, CPHA 1
+
+// Primary prescaler, SPI2CON1 PPRE
+#define SPI_PPRE_64         0x0000
+#define SPI_PPRE_16         0x0001
+#define SPI_PPRE_4          0x0002
+#define SPI_PPRE_1          0x0003
+
+// Secondary prescaler 1..8, SPI2CON1 SPRE
+#define SPI_SPRE(n)         ((8 - (n)) << 2)
+
+// Input sampled at end of data output time, SPI2CON1 SMP
+#define SPI_SMP_END         0x0200
+
+// SPI2CON1 value for a master device, SCK = FCY / (primary * secondary)
+#define SPI_CON1(mode, ppre, spre)  (0x0020 | (mode) | (ppre) | SPI_SPRE(spre))
+
+// Queued transactions of at least this many bytes are moved by DMA
+#define SPI_BUS_DMA_MIN     16
+
+// Chip select inactive time between transactions in us, DS1722 tCWH 400 ns
+#define SPI_BUS_CS_IDLE_US  1
+
+/*******************************************************************************
+ * Device descriptor, one per slave on the bus
+ ******************************************************************************/
+typedef struct
+{
+    volatile unsigned int *csLat;   // LATx register of the chip select pin
+    uint16_t csMask;                // chip select pin mask
+    bool csActiveHigh;              // DS1722 CE is active high
+    uint16_t con1;                  // SPI_CON1() setup
+    uint8_t traceId;                // BUS_TRACE device identifier
+} SPI_DEVICE;
+
+/*******************************************************************************
+ * Queued transaction, owned by the client
+ ******************************************************************************/
+typedef struct SPI_TRANSACTION
+{
+    const SPI_DEVICE *device;
+    const uint8_t *tx;              // NULL sends SPI2_DUMMY_DATA
+    uint8_t *rx;                    // NULL discards received bytes
+    uint16_t length;
+    void (*done)(struct SPI_TRANSACTION *t);  // optional, called when done
+    volatile bool busy;             // queued or running
+    struct SPI_TRANSACTION *next;
+} SPI_TRANSACTION;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void SPI_Bus_DeviceInit(const SPI_DEVICE *device);
+void SPI_Bus_Begin(const SPI_DEVICE *device);
+void SPI_Bus_End(void);
+uint8_t SPI_Bus_Transfer(uint8_t data);
+void SPI_Bus_Exchange(const uint8_t *tx, uint8_t *rx, uint16_t length);
+void SPI_Bus_ReadRegisters(const SPI_DEVICE *device, uint8_t command,
+                           uint8_t *data, uint16_t count);
+void SPI_Bus_WriteRegisters(const SPI_DEVICE *device, uint8_t command,
+                            const uint8_t *data, uint16_t count);
+bool SPI_Bus_Submit(SPI_TRANSACTION *t);
+bool SPI_Bus_Tasks(void);
+void SPI_Bus_Wait(SPI_TRANSACTION *t);
+bool SPI_Bus_Busy(void);
+
+#endif  // SPI_BUS_H
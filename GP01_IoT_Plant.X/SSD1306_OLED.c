@@ -83,6 +83,16 @@
 #include <stdio.h>
 #include <string.h>
 #include "PIC24_PIC33_I2C.h"
+#include "Bus_Trace.h"
+#include "I2C_Bus.h"
+
+// Buffer flush job on the I2C bus arbiter and the next page it sends
+static I2C_BUS_JOB ssd1306_flush_job;
+static uint8_t ssd1306_flush_page;
+
+// Display on/off job and the command it sends
+static I2C_BUS_JOB ssd1306_power_job;
+static uint8_t ssd1306_power_command;
 
 
 /*******************************************************************************
@@ -428,6 +438,119 @@ void drawPixel(int16_t x, int16_t y, uint16_t color)
 
 }
 
+/*******************************************************************************
+ * Function:        static bool SSD1306_Flush_Step(void *context)
+ *
+ * PreCondition:    Display should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          true once the last page has been sent
+ *
+ * Overview:        I2C bus job step, sends one 128 byte page of the buffer
+ *                  per call. The address window is set up with the first
+ *                  page, the display keeps its address pointer while other
+ *                  devices use the bus between steps
+ * 
+ * Usage:           None
+ *
+ * Note:            Bus runs at SSD1306_I2C_SPEED during the step
+ ******************************************************************************/
+static bool SSD1306_Flush_Step(void *context)
+{
+  // Variable for write loop
+  uint16_t x;
+  uint8_t *data = &buffer[ssd1306_flush_page * SSD1306_LCDWIDTH];
+  BUS_TRACE_START(t_start);
+  
+  (void)context;
+  
+  // Run the display at its own speed, other devices stay at the default
+  I2C1_SetSpeed(SSD1306_I2C_SPEED);
+  
+  if (ssd1306_flush_page == 0) {
+    SSD1306_COMMAND(SSD1306_COLUMNADDR);
+    SSD1306_COMMAND(0);   // Column start address (0 = reset)
+    SSD1306_COMMAND(SSD1306_LCDWIDTH-1); // Column end address (127 = reset)
+    SSD1306_COMMAND(SSD1306_PAGEADDR);
+    SSD1306_COMMAND(0); // Page start address (0 = reset)
+    SSD1306_COMMAND(7); // Page end address
+  }
+  
+  I2C1_IDLE();
+  I2C1CONbits.SEN = 1;
+  while (I2C1CONbits.SEN);
+  IFS1bits.MI2C1IF = 0;
+  MasterWriteI2C1(0x3C<<1|0);
+  MasterWriteI2C1(0x40&0x00FF);
+  
+  // Write a page of data
+  for (x=0; x<SSD1306_LCDWIDTH; x++) {
+      MasterWriteI2C1(data[x]);
+  }
+  
+  I2C1CONbits.PEN = 1;
+  while(I2C1CONbits.PEN);                     
+  IFS1bits.MI2C1IF = 0;   
+  BUS_TRACE_LOG(BUS_TRACE_I2C1, SSD1306_I2C_ADDRESS, BUS_TRACE_WRITE,
+                SSD1306_LCDWIDTH + 1, t_start, I2C1STATbits.ACKSTAT ? -2 : 0);
+  
+  I2C1_SetSpeed(I2C1_DEFAULT_SPEED);
+  
+  if (++ssd1306_flush_page == SSD1306_LCDHEIGHT / 8) {
+    ssd1306_flush_page = 0;
+    return true;
+  }
+  
+  return false;
+}
+
+/*******************************************************************************
+ * Function:        void SSD1306_Write_Buffer_Start(void)
+ *
+ * PreCondition:    Display should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Queues a flush of the buffer on the I2C bus arbiter as a
+ *                  low priority job of one step per page
+ * 
+ * Usage:           SSD1306_Write_Buffer_Start();
+ *                  while (SSD1306_Write_Buffer_Busy()) I2C_Bus_Tasks();
+ *
+ * Note:            Do not draw into the buffer until the flush is done. A
+ *                  flush already in progress is not restarted
+ ******************************************************************************/
+void SSD1306_Write_Buffer_Start(void) {
+  if (ssd1306_flush_job.step == NULL) {
+    I2C_Bus_JobInit(&ssd1306_flush_job, SSD1306_Flush_Step, NULL,
+                    I2C_BUS_PRIO_LOW, I2C_BUS_CLIENT_DISPLAY);
+  }
+  
+  I2C_Bus_Submit(&ssd1306_flush_job);
+}
+
+/*******************************************************************************
+ * Function:        bool SSD1306_Write_Buffer_Busy(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          true while a flush is queued or running
+ *
+ * Overview:        Returns the state of the flush job
+ * 
+ * Usage:           None
+ *
+ * Note:            None
+ ******************************************************************************/
+bool SSD1306_Write_Buffer_Busy(void) {
+  return ssd1306_flush_job.busy;
+}
+
 /*******************************************************************************
  * Function:        void SSD1306_Write_Buffer(void)
  *
@@ -437,46 +560,59 @@ void drawPixel(int16_t x, int16_t y, uint16_t color)
  *
  * Output:          None
  *
- * Overview:        Writes the buffer to the OLED
+ * Overview:        Writes the buffer to the OLED and returns when done,
+ *                  higher priority I2C jobs run between pages
  * 
  * Usage:           None
  *
- * Note:            None
+ * Note:            Bus runs at SSD1306_I2C_SPEED during the transfer
  ******************************************************************************/
 void SSD1306_Write_Buffer(void) {
-  SSD1306_COMMAND(SSD1306_COLUMNADDR);
-  SSD1306_COMMAND(0);   // Column start address (0 = reset)
-  SSD1306_COMMAND(SSD1306_LCDWIDTH-1); // Column end address (127 = reset)
-  SSD1306_COMMAND(SSD1306_PAGEADDR);
-  SSD1306_COMMAND(0); // Page start address (0 = reset)
-  SSD1306_COMMAND(7); // Page end address
+  SSD1306_Write_Buffer_Start();
+  I2C_Bus_Wait(&ssd1306_flush_job);
+}
+
+/*******************************************************************************
+ * Function:        static bool SSD1306_Power_Step(void *context)
+ *
+ * Overview:        I2C bus job step, sends the latest display on/off
+ *                  command
+ ******************************************************************************/
+static bool SSD1306_Power_Step(void *context)
+{
+  (void)context;
   
-   // Variable for buffer loop
-   uint16_t i;
-   
-   for(i = 0; i < (SSD1306_LCDWIDTH * SSD1306_LCDHEIGHT/ 8); i++){
-       I2C1_IDLE();
-       I2C1CONbits.SEN = 1;
-       while (I2C1CONbits.SEN);
-       IFS1bits.MI2C1IF = 0;
-       MasterWriteI2C1(0x3C<<1|0);
-       MasterWriteI2C1(0x40&0x00FF);
-       
-       // Variable for write loop
-       uint16_t x;
-     
-       // Write a chunk of data 
-       for (x=0; x<128; x++) {
-           MasterWriteI2C1(buffer[i]);
-           i++;
-       }
-       i--;
-       
-       I2C1CONbits.PEN = 1;
-       while(I2C1CONbits.PEN);                     
-       IFS1bits.MI2C1IF = 0;   
+  SSD1306_COMMAND(ssd1306_power_command);
+  
+  return true;
+}
+
+/*******************************************************************************
+ * Function:        void SSD1306_Display_Power_Start(bool on)
+ *
+ * PreCondition:    Display should have been initialized
+ *
+ * Input:           true to turn the panel on, false to turn it off
+ *
+ * Output:          None
+ *
+ * Overview:        Queues a display on or off command on the I2C bus
+ *                  arbiter, with the same priority as the buffer flushes so
+ *                  it runs in order with them
+ * 
+ * Usage:           SSD1306_Display_Power_Start(false);
+ *
+ * Note:            A command still queued is replaced, only the last one
+ *                  is sent. The display RAM is kept while the panel is off
+ ******************************************************************************/
+void SSD1306_Display_Power_Start(bool on) {
+  if (ssd1306_power_job.step == NULL) {
+    I2C_Bus_JobInit(&ssd1306_power_job, SSD1306_Power_Step, NULL,
+                    I2C_BUS_PRIO_LOW, I2C_BUS_CLIENT_DISPLAY);
   }
-    
+  
+  ssd1306_power_command = on ? SSD1306_DISPLAYON : SSD1306_DISPLAYOFF;
+  I2C_Bus_Submit(&ssd1306_power_job);
 }
 
 
@@ -88,6 +88,10 @@
 // Display address
 #define SSD1306_I2C_ADDRESS   0x3C  
 
+// Bus speed used while flushing the buffer, panels that do not cope with
+// Fast-mode Plus should use I2C_SPEED_FAST (see PIC24_PIC33_I2C.h)
+#define SSD1306_I2C_SPEED     I2C_SPEED_FAST_PLUS
+
 // Define OLED dimensions
 #define SSD1306_LCDWIDTH 128
 #define SSD1306_LCDHEIGHT 64
@@ -145,6 +149,9 @@ void SSD1306_INIT(void);
 void SSD1306_COMMAND(uint8_t command);
 void SSD1306_Clear_Display(void);
 void SSD1306_Write_Buffer(); 
+void SSD1306_Write_Buffer_Start(void);
+bool SSD1306_Write_Buffer_Busy(void);
+void SSD1306_Display_Power_Start(bool on);
 
 // Graphics functions
 void SSD1306_Draw_Button    (unsigned char recx1, unsigned char recy1, unsigned char recx2, 
@@ -0,0 +1,302 @@
+/*******************************************************************************
+ * File: Scheduler.c
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Cooperative task scheduler. See Scheduler.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 20th, 2026, 4:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include <stdio.h>
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Scheduler.h"
+
+// Timestamp ticks are 256 / FCY, about 8 us
+#define SCHED_TICKS_TO_US(t) \
+        ((unsigned long)((uint64_t)(t) * TMR1_TIMESTAMP_PRESCALER * 1000000UL / FCY))
+
+static SCHED_TASK *sched_tasks;
+static uint8_t sched_count;
+
+/*******************************************************************************
+ * Function:        static SCHED_TASK *Scheduler_Find(void (*run)(void))
+ * Overview:        Table entry of the task with this run function, NULL if
+ *                  there is none
+ ******************************************************************************/
+static SCHED_TASK *Scheduler_Find(void (*run)(void))
+{
+    uint8_t i;
+
+    for (i = 0; i < sched_count; i++)
+    {
+        if (sched_tasks[i].run == run)
+        {
+            return &sched_tasks[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function:        void Scheduler_Init(SCHED_TASK *tasks, uint8_t count)
+ *
+ * PreCondition:    TMR1 should have been initialized
+ *
+ * Input:           Task table and its length
+ *
+ * Output:          None
+ *
+ * Overview:        Makes every task due now
+ *
+ * Usage:           Scheduler_Init(Tasks, NUM_TASKS);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Scheduler_Init(SCHED_TASK *tasks, uint8_t count)
+{
+    uint32_t now = TMR1_TimestampGet();
+    uint8_t i;
+
+    sched_tasks = tasks;
+    sched_count = count;
+
+    for (i = 0; i < count; i++)
+    {
+        tasks[i].next = now;
+    }
+}
+
+/*******************************************************************************
+ * Function:        bool Scheduler_Run(void)
+ *
+ * PreCondition:    Scheduler_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          true if a task ran
+ *
+ * Overview:        Runs every task that is due once, in table order, and
+ *                  books its start and run time against the deadline and
+ *                  budget
+ *
+ * Usage:           if (!Scheduler_Run()) Idle();
+ *
+ * Note:            A task that fell more than a period behind is not run
+ *                  again to catch up, its next run is a period from now
+ ******************************************************************************/
+bool Scheduler_Run(void)
+{
+    SCHED_TASK *t;
+    uint32_t start;
+    uint32_t time;
+    bool ran = false;
+    uint8_t i;
+
+    for (i = 0; i < sched_count; i++)
+    {
+        t = &sched_tasks[i];
+        start = TMR1_TimestampGet();
+
+        if (t->suspended || ((int32_t)(start - t->next) < 0))
+        {
+            continue;
+        }
+
+        if (start - t->next > t->deadline)
+        {
+            t->late++;
+        }
+
+        t->run();
+        ran = true;
+
+        time = TMR1_TimestampGet() - start;
+        t->runs++;
+        if (time > t->worst)
+        {
+            t->worst = time;
+        }
+        if (time > t->budget)
+        {
+            t->overruns++;
+        }
+
+        t->next += t->period;
+        if ((int32_t)(start - t->next) >= 0)
+        {
+            t->next = start + t->period;
+        }
+    }
+
+    return ran;
+}
+
+/*******************************************************************************
+ * Function:        uint32_t Scheduler_NextDue(void)
+ *
+ * PreCondition:    Scheduler_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          Ticks until the next task is due, 0 if one is due now
+ *
+ * Overview:        Looks for the task due soonest
+ *
+ * Usage:           wait = Scheduler_NextDue();
+ *
+ * Note:            UINT32_MAX if every task is suspended
+ ******************************************************************************/
+uint32_t Scheduler_NextDue(void)
+{
+    uint32_t now = TMR1_TimestampGet();
+    uint32_t soonest = UINT32_MAX;
+    int32_t wait;
+    uint8_t i;
+
+    for (i = 0; i < sched_count; i++)
+    {
+        if (sched_tasks[i].suspended)
+        {
+            continue;
+        }
+
+        wait = (int32_t)(sched_tasks[i].next - now);
+
+        if (wait <= 0)
+        {
+            return 0;
+        }
+        if ((uint32_t)wait < soonest)
+        {
+            soonest = wait;
+        }
+    }
+
+    return soonest;
+}
+
+/*******************************************************************************
+ * Function:        void Scheduler_Suspend(void (*run)(void))
+ *
+ * PreCondition:    Scheduler_Init() should have been called
+ *
+ * Input:           Run function of the task
+ *
+ * Output:          None
+ *
+ * Overview:        Stops running the task and leaves it out of the next
+ *                  due time
+ *
+ * Usage:           Scheduler_Suspend(Probe_Task);
+ *
+ * Note:            A task may suspend itself
+ ******************************************************************************/
+void Scheduler_Suspend(void (*run)(void))
+{
+    SCHED_TASK *t = Scheduler_Find(run);
+
+    if (t)
+    {
+        t->suspended = true;
+    }
+}
+
+/*******************************************************************************
+ * Function:        void Scheduler_Resume(void (*run)(void))
+ *
+ * PreCondition:    Scheduler_Init() should have been called
+ *
+ * Input:           Run function of the task
+ *
+ * Output:          None
+ *
+ * Overview:        Makes a suspended task due now, then every period
+ *
+ * Usage:           Scheduler_Resume(Probe_Task);
+ *
+ * Note:            Does nothing to a task that is not suspended
+ ******************************************************************************/
+void Scheduler_Resume(void (*run)(void))
+{
+    SCHED_TASK *t = Scheduler_Find(run);
+
+    if (t && t->suspended)
+    {
+        t->suspended = false;
+        t->next = TMR1_TimestampGet();
+    }
+}
+
+/*******************************************************************************
+ * Function:        void Scheduler_Report(void)
+ *
+ * PreCondition:    UART1 should have been initialized
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Prints runs, late starts, overruns and the longest run
+ *                  of every task then clears the statistics
+ *
+ * Usage:           Scheduler_Report();
+ *
+ * Note:            Does nothing unless SCHED_REPORT is 1
+ ******************************************************************************/
+void Scheduler_Report(void)
+{
+#if SCHED_REPORT
+    SCHED_TASK *t;
+    uint8_t i;
+
+    for (i = 0; i < sched_count; i++)
+    {
+        t = &sched_tasks[i];
+
+        printf("Task %s: %u runs %u late %u over max %lu us\n",
+               t->name, t->runs, t->late, t->overruns,
+               SCHED_TICKS_TO_US(t->worst));
+
+        t->runs = 0;
+        t->late = 0;
+        t->overruns = 0;
+        t->worst = 0;
+    }
+#endif
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * File: Scheduler.h
+ * Author: Armstrong Subero
+ * PIC: dsPIC33EP128GP502 @ ~32 MHz, 3.3v
+ * Compiler: XC16 (Pro) (v1.31, MPLAX X v3.61)
+ * Program Version: 1.0
+ *
+ * Program Description: Cooperative scheduler on the TMR1 timestamp. Each
+ *                      task runs to completion every period, tasks due at
+ *                      the same time run in table order.
+ *
+ *                      A task with nothing to do for a while can be
+ *                      suspended so it does not keep the CPU awake, and be
+ *                      resumed when there is work for it again.
+ *
+ *                      Every task also has a deadline, the latest it may
+ *                      start after becoming due, and a run time budget.
+ *                      Late starts, budget overruns and the longest run are
+ *                      counted per task and printed by Scheduler_Report()
+ *                      when SCHED_REPORT is defined to 1.
+ *
+ * Hardware Description: None
+ *
+ * Created October 20th, 2026, 4:00 PM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Set to 1 to print the task statistics from Scheduler_Report()
+#ifndef SCHED_REPORT
+#define SCHED_REPORT 0
+#endif
+
+// Milliseconds to TMR1 timestamp ticks
+#define SCHED_MS(ms)        ((uint32_t)(ms) * (FCY / TMR1_TIMESTAMP_PRESCALER) / 1000)
+
+/*******************************************************************************
+ * Task table entry, fill the first five fields with SCHED_TASK_INIT()
+ ******************************************************************************/
+typedef struct
+{
+    const char *name;
+    void (*run)(void);
+    uint32_t period;            // ticks between runs
+    uint32_t deadline;          // ticks after due by which it must start
+    uint32_t budget;            // ticks it may run for
+    uint32_t next;              // timestamp it is next due
+    bool suspended;             // not run until resumed
+    uint32_t worst;             // longest run in ticks
+    uint16_t runs;
+    uint16_t late;              // started after the deadline
+    uint16_t overruns;          // ran longer than the budget
+} SCHED_TASK;
+
+#define SCHED_TASK_INIT(name, run, period_ms, deadline_ms, budget_ms)   \
+        {(name), (run), SCHED_MS(period_ms), SCHED_MS(deadline_ms),     \
+         SCHED_MS(budget_ms), 0, false, 0, 0, 0, 0}
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Scheduler_Init(SCHED_TASK *tasks, uint8_t count);
+bool Scheduler_Run(void);
+uint32_t Scheduler_NextDue(void);
+void Scheduler_Suspend(void (*run)(void));
+void Scheduler_Resume(void (*run)(void));
+void Scheduler_Report(void);
+
+#endif  // SCHEDULER_H
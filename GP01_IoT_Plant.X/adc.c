@@ -16,6 +16,8 @@ limitations under the License.
 
 #include <xc.h>
 #include "adc.h"
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -24,172 +26,328 @@ limitations under the License.
 
 #define PIN_INPUT       1
 #define PIN_OUTPUT      0
+
+// Sample time of the blocking conversions, in ADC clocks (max 31)
+#define ADC_SAMPLE_TAD  31
+
+// Map from channel to the ADC1 DMA snapshot slot
+static const uint8_t adc_slot[ADC_CHANNEL_COUNT] =
+{
+    ADC1_SLOT_AN0, ADC1_SLOT_AN1, ADC1_SLOT_AN2, ADC1_SLOT_AN3
+};
+
+static ADC_MODE adc_mode = ADC_MODE_BLOCKING;
+static uint8_t  adc_enabled;
+
+// Interrupt mode state, channel being converted and its running sum
+static volatile uint16_t adc_results[ADC_CHANNEL_COUNT];
+static uint8_t  adc_channel;
+static uint8_t  adc_samples;
+static uint16_t adc_sum;
+
 /*********************************************************************
- * Function: ADC_ReadPercentage(ADC_CHANNEL channel);
+ * Function: static uint8_t ADC_NextChannel(uint8_t channel);
  *
- * Overview: Reads the requested ADC channel and returns the percentage
- *            of that conversions result (0-100%).
+ * Overview: Next enabled channel after channel, wrapping around
+ *
+ ********************************************************************/
+static uint8_t ADC_NextChannel ( uint8_t channel )
+{
+    uint8_t i ;
+
+    for (i = 0 ; i < ADC_CHANNEL_COUNT ; i++)
+    {
+        channel = (channel + 1) % ADC_CHANNEL_COUNT ;
+
+        if (adc_enabled & (1 << channel))
+        {
+            break ;
+        }
+    }
+
+    return channel ;
+}
+
+/*********************************************************************
+ * Function: static void ADC_Stop(void);
  *
- * PreCondition: channel is configured via the ADCConfigure() function
+ * Overview: Stops the triggers, DMA and interrupt and puts the ADC
+ *           back to single channel conversions of CH0
  *
- * Input: ADC_CHANNEL channel - enumeration of the ADC channels
- *        available in this demo.  They should be meaningful names and
- *        not the names of the ADC pins on the device (as the demo code
- *        may be ported to other boards).
- *         i.e. ADC_ReadPercentage(ADC_CHANNEL_POTENTIOMETER);
+ ********************************************************************/
+static void ADC_Stop ( void )
+{
+    ADC1_TriggeredAcquisitionStop ( ) ;
+    IEC0bits.AD1IE = 0 ;
+
+    AD1CON1bits.ADON = 0 ;
+    AD1CON1bits.ADDMABM = 0 ;
+    AD1CON4bits.ADDMAEN = 0 ;
+    AD1CON1bits.SIMSAM = 0 ;
+    AD1CON2bits.CHPS = ADC1_CONVERSION_CHANNELS_CH0 ;
+    AD1CON2bits.CSCNA = 0 ;
+    AD1CON2bits.SMPI = 0 ;
+    AD1CON1bits.SSRCG = 0 ;
+    IFS0bits.AD1IF = 0 ;
+}
+
+/*********************************************************************
+ * Function: bool ADC_SetMode(ADC_MODE mode, uint16_t rateHz);
  *
- * Output: uint8_t indicating the percentage of the result 0-100% or
- *         0xFF for an error
+ * Overview: Stops any running acquisition and restarts the ADC in the
+ *           requested mode
+ *
+ * PreCondition: SYSTEM_Initialize() has been called. For the interrupt
+ *               mode the channels are enabled via ADC_ChannelEnable()
+ *
+ * Input: ADC_MODE mode - blocking, interrupt or DMA
+ *        uint16_t rateHz - Timer3 trigger rate, unused when blocking
+ *
+ * Output: bool - true if successfully configured.  false otherwise.
  *
  ********************************************************************/
-uint8_t ADC_ReadPercentage
-( ADC_CHANNEL channel )
+bool ADC_SetMode ( ADC_MODE mode, uint16_t rateHz )
 {
-    uint8_t percent ;
+    uint8_t i ;
 
-    switch (channel)
+    ADC_Stop ( ) ;
+
+    for (i = 0 ; i < ADC_CHANNEL_COUNT ; i++)
     {
-        case ADC_CHANNEL_10:
+        adc_results[i] = 0 ;
+    }
+
+    switch (mode)
+    {
+        case ADC_MODE_BLOCKING:
+            // Setting SAMP samples for ADC_SAMPLE_TAD then converts
+            AD1CON1bits.ASAM = 0 ;
+            AD1CON1bits.SSRC = ADC1_SAMPLING_SOURCE_AUTO ;
+            AD1CON3bits.SAMC = ADC_SAMPLE_TAD ;
+            AD1CON1bits.ADON = 1 ;
+            break ;
+
+        case ADC_MODE_INTERRUPT:
+            if (adc_enabled == 0 || rateHz == 0)
+            {
+                return false ;
+            }
+
+            adc_channel = ADC_NextChannel ( ADC_CHANNEL_COUNT - 1 ) ;
+            adc_samples = 0 ;
+            adc_sum = 0 ;
+            AD1CHS0bits.CH0SA = adc_channel ;
+
+            // Timer3 off, 1:256 prescaler, period of one trigger
+            T3CON = 0x0030 ;
+            TMR3 = 0 ;
+            PR3 = (FCY / ADC1_TRIGGER_PRESCALER) / rateHz - 1 ;
+
+            // Sampling restarts after each conversion, the Timer3 match
+            // ends it, one interrupt per result
+            AD1CON1bits.SSRC = ADC1_SAMPLING_SOURCE_TMR3 ;
+            AD1CON1bits.ASAM = 1 ;
+            IEC0bits.AD1IE = 1 ;
+            AD1CON1bits.ADON = 1 ;
+            T3CONbits.TON = 1 ;
+            break ;
+
+        case ADC_MODE_DMA:
+            if (rateHz == 0)
+            {
+                return false ;
+            }
+
+            ADC1_TriggeredAcquisitionStart ( rateHz ) ;
             break ;
-        case ADC_CHANNEL_11:
-            break;
 
         default:
-            return 0xFF ;
+            return false ;
     }
 
-    //A very crude percentage calculation
-    percent = ( ADC_Read10bit ( channel ) / 10 ) ;
+    adc_mode = mode ;
 
-    if (percent > 100)
+    return true ;
+}
+
+/*********************************************************************
+ * Function: bool ADC_ChannelEnable(ADC_CHANNEL channel);
+ *
+ * Overview: Makes the pin of the channel an analog input and adds the
+ *           channel to the ones converted in interrupt mode
+ *
+ * PreCondition: none
+ *
+ * Input: ADC_CHANNEL channel - the channel to enable
+ *
+ * Output: bool - true if successfully configured.  false otherwise.
+ *
+ ********************************************************************/
+bool ADC_ChannelEnable ( ADC_CHANNEL channel )
+{
+    switch (channel)
     {
-        percent = 100 ;
+        case ADC_CHANNEL_AN0:
+            TRISAbits.TRISA0 = PIN_INPUT ;
+            ANSELAbits.ANSA0 = PIN_ANALOG ;
+            break ;
+
+        case ADC_CHANNEL_AN1:
+            TRISAbits.TRISA1 = PIN_INPUT ;
+            ANSELAbits.ANSA1 = PIN_ANALOG ;
+            break ;
+
+        case ADC_CHANNEL_AN2:
+            TRISBbits.TRISB0 = PIN_INPUT ;
+            ANSELBbits.ANSB0 = PIN_ANALOG ;
+            break ;
+
+        case ADC_CHANNEL_AN3:
+            TRISBbits.TRISB1 = PIN_INPUT ;
+            ANSELBbits.ANSB1 = PIN_ANALOG ;
+            break ;
+
+        default:
+            return false ;
     }
-    return percent ;
+
+    adc_enabled |= 1 << channel ;
+
+    return true ;
 }
+
 /*********************************************************************
- * Function: ADC_Read10bit(ADC_CHANNEL channel);
+ * Function: ADC_Read(ADC_CHANNEL channel);
  *
- * Overview: Reads the requested ADC channel and returns the 10-bit
- *           representation of this data.
+ * Overview: Returns the latest result of the requested channel with
+ *           ADC1_RESULT_BITS of resolution. Converts and waits in
+ *           blocking mode, never waits otherwise
  *
- * PreCondition: channel is configured via the ADCConfigure() function
+ * PreCondition: ADC_SetMode() has been called and in interrupt mode the
+ *               channel is enabled via ADC_ChannelEnable()
  *
  * Input: ADC_CHANNEL channel - enumeration of the ADC channels
- *        available in this demo.  They should be meaningful names and
- *        not the names of the ADC pins on the device (as the demo code
- *        may be ported to other boards).
- *         i.e. - ADCReadPercentage(ADC_CHANNEL_POTENTIOMETER);
+ *         i.e. ADC_Read(ADC_CHANNEL_LIGHT);
  *
- * Output: uint16_t the right adjusted 10-bit representation of the ADC
- *         channel conversion or 0xFFFF for an error.
+ * Output: uint16_t the right adjusted result of the ADC channel, 0 before
+ *         the first conversion or 0xFFFF for an error.
  *
  ********************************************************************/
-uint16_t ADC_Read10bit ( ADC_CHANNEL channel )
+uint16_t ADC_Read ( ADC_CHANNEL channel )
 {
-    uint16_t i ;
+    uint16_t sum = 0 ;
+    uint8_t i ;
 
-    switch (channel)
+    if (channel >= ADC_CHANNEL_COUNT)
     {
-        case ADC_CHANNEL_10:
-            break ;
-            
-        case ADC_CHANNEL_11:
-            break;
+        return 0xFFFF ;
+    }
+
+    switch (adc_mode)
+    {
+        case ADC_MODE_INTERRUPT:
+            return adc_results[channel] ;
+
+        case ADC_MODE_DMA:
+            return ADC1_ResultGet ( adc_slot[channel] ) ;
 
         default:
-            return 0xFFFF ;
+            break ;
     }
 
-    AD1CHS = channel ;
+    // Oversample as the other modes do
+    AD1CHS0bits.CH0SA = channel ;
 
-    // Get an ADC sample
-    AD1CON1bits.SAMP = 1 ;           //Start sampling
-    for (i = 0 ; i < 1000 ; i++) ; //Sample delay, conversion start automatically
+    for (i = 0 ; i < ADC1_OVERSAMPLE ; i++)
+    {
+        AD1CON1bits.DONE = 0 ;
+        AD1CON1bits.SAMP = 1 ;          // Start sampling, conversion follows
 
-    AD1CON1bits.SAMP = 0 ;           //Start sampling
-    for (i = 0 ; i < 1000 ; i++) ; //Sample delay, conversion start automatically
+        while (!AD1CON1bits.DONE) ;     // Wait for conversion to complete
 
-    while (!AD1CON1bits.DONE) ;       //Wait for conversion to complete
+        sum += ADC1BUF0 ;
+    }
 
-    return ADC1BUF0 ;
+    return sum >> ADC1_OVERSAMPLE_BITS ;
 }
+
 /*********************************************************************
- * Function: bool ADC_ChannelEnable(ADC_CHANNEL channel, ADC_CONFIGURATION configuration);
+ * Function: ADC_Read10bit(ADC_CHANNEL channel);
  *
- * Overview: Configures the ADC module to specified setting
+ * Overview: Reads the requested ADC channel and returns the 10-bit
+ *           representation of this data.
  *
- * PreCondition: none
+ * PreCondition: as for ADC_Read()
  *
- * Input: ADC_CHANNEL channel - the channel to enable
- *        ADC_CONFIGURATION configuration - the mode in which to run the ADC
+ * Input: ADC_CHANNEL channel - enumeration of the ADC channels
+ *         i.e. ADC_Read10bit(ADC_CHANNEL_MOISTURE);
  *
- * Output: bool - true if successfully configured.  false otherwise.
+ * Output: uint16_t the right adjusted 10-bit representation of the ADC
+ *         channel conversion or 0xFFFF for an error.
  *
  ********************************************************************/
-bool ADC_ChannelEnable ( ADC_CHANNEL channel )
+uint16_t ADC_Read10bit ( ADC_CHANNEL channel )
 {
-    switch (channel)
-    {
-        case ADC_CHANNEL_10:
-            ANSCbits.ANSC0 = PIN_ANALOG ;
-            return true ;
-        case ADC_CHANNEL_11:
-            ANSCbits.ANSC1 = PIN_ANALOG;
-            return true ;
+    uint16_t result = ADC_Read ( channel ) ;
 
-        default:
-            return false ;
+    if (result == 0xFFFF)
+    {
+        return 0xFFFF ;
     }
+
+    return result >> ADC1_OVERSAMPLE_BITS ;
 }
+
 /*********************************************************************
- * Function: bool ADC_SetConfiguration(ADC_CONFIGURATION configuration)
+ * Function: ADC_ReadPercentage(ADC_CHANNEL channel);
  *
- * Overview: Configures the ADC module to specified setting
+ * Overview: Reads the requested ADC channel and returns the percentage
+ *            of that conversions result (0-100%).
  *
- * PreCondition: none
+ * PreCondition: as for ADC_Read()
  *
- * Input: ADC_CONFIGURATION configuration - the mode in which to run the ADC
+ * Input: ADC_CHANNEL channel - enumeration of the ADC channels
+ *         i.e. ADC_ReadPercentage(ADC_CHANNEL_MOISTURE);
  *
- * Output: bool - true if successfully configured.  false otherwise.
+ * Output: uint8_t indicating the percentage of the result 0-100% or
+ *         0xFF for an error
  *
  ********************************************************************/
-bool ADC_SetConfiguration ( ADC_CONFIGURATION configuration )
+uint8_t ADC_ReadPercentage ( ADC_CHANNEL channel )
 {
-    if (configuration == ADC_CONFIGURATION_DEFAULT)
+    uint16_t result = ADC_Read ( channel ) ;
+
+    if (result == 0xFFFF)
     {
-        AD1CON2bits.PVCFG = 0x00 ;
-        AD1CON2bits.NVCFG0 = 0x0 ;
-        AD1CON3bits.ADCS = 0xFF ;
-        AD1CON1bits.SSRC = 0x0 ;
-        AD1CON3bits.SAMC = 0b10000 ;
-        AD1CON1bits.FORM = 0b00 ;
-        AD1CON2bits.SMPI = 0x0 ;
-        AD1CON1bits.MODE12 = 0 ;
-        AD1CON1bits.ADON = 1 ;
-
-        return true ;
+        return 0xFF ;
     }
 
-    else if (configuration ==  ADC_CONFIGURATION_AUTO_SAMPLE_CONVERT)
+    // Rounded to the nearest percent of full scale
+    return ((uint32_t)result * 100 + ADC_FULL_SCALE / 2) / ADC_FULL_SCALE ;
+}
+
+/*********************************************************************
+ * Function: void _AD1Interrupt(void);
+ *
+ * Overview: Interrupt mode, adds up ADC1_OVERSAMPLE results of the
+ *           current channel, publishes them and moves on to the next
+ *           enabled channel
+ *
+ ********************************************************************/
+void __attribute__ ( ( interrupt, no_auto_psv ) ) _AD1Interrupt ( void )
+{
+    adc_sum += ADC1BUF0 ;
+
+    if (++adc_samples == ADC1_OVERSAMPLE)
     {
-        AD1CON1bits.SSRC  = 0b111 ;
-        AD1CON1bits.ASAM  = 0x01 ;
-        AD1CON2bits.PVCFG = 0x00 ;
-        AD1CON2bits.NVCFG0 = 0x0 ;
-        AD1CON2bits.SMPI  = 0x0 ;
-        AD1CON2bits.CSCNA = 0x0 ;
-        AD1CON2bits.ALTS  = 0x0 ;
-        AD1CON3bits.ADCS  = 0x2F ;
-        AD1CON3bits.SAMC  = 0b00011 ;
-        IEC0bits.AD1IE    = 1 ;
-        AD1CON1bits.MODE12 = 0 ;
-        AD1CON1bits.ADON = 1 ;
-        AD1CHS = ADC_CHANNEL_10 ;
-        IFS0bits.AD1IF = 0 ;
-        AD1CSSL = 0x0000 ;
-        return true ;
+        adc_results[adc_channel] = adc_sum >> ADC1_OVERSAMPLE_BITS ;
+        adc_sum = 0 ;
+        adc_samples = 0 ;
+
+        // Still sampling until the next trigger, switch the input now
+        adc_channel = ADC_NextChannel ( adc_channel ) ;
+        AD1CHS0bits.CH0SA = adc_channel ;
     }
 
-    return false ;
+    IFS0bits.AD1IF = 0 ;
 }
@@ -19,90 +19,120 @@ limitations under the License.
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "mcc_generated_files/adc1.h"
 
 /*** ADC Channel Definitions *****************************************/
-#define ADC_CHANNEL_POTENTIOMETER_1 ADC_CHANNEL_10
-#define ADC_CHANNEL_POTENTIOMETER_2 ADC_CHANNEL_11
+#define ADC_CHANNEL_LIGHT       ADC_CHANNEL_AN0
+#define ADC_CHANNEL_MOISTURE    ADC_CHANNEL_AN1
+#define ADC_CHANNEL_BATTERY     ADC_CHANNEL_AN2
 
+// Analog inputs of the dsPIC33EP128GP502 on this board
 typedef enum
 {
-    ADC_CHANNEL_10 = 10,
-    ADC_CHANNEL_11 = 11         
+    ADC_CHANNEL_AN0 = ADC1_CHANNEL_AN0,    // RA0
+    ADC_CHANNEL_AN1 = ADC1_CHANNEL_AN1,    // RA1
+    ADC_CHANNEL_AN2 = ADC1_CHANNEL_AN2,    // RB0
+    ADC_CHANNEL_AN3 = ADC1_CHANNEL_AN3,    // RB1
+    ADC_CHANNEL_COUNT
 } ADC_CHANNEL;
 
+// How results are produced, ADC_Read10bit() and friends work the same way
+// in every mode
 typedef enum
 {
-    ADC_CONFIGURATION_DEFAULT,
-    ADC_CONFIGURATION_AUTO_SAMPLE_CONVERT
-} ADC_CONFIGURATION;
+    ADC_MODE_BLOCKING,          // converted on request, the caller waits
+    ADC_MODE_INTERRUPT,         // Timer3 triggered, AD1 interrupt cycles
+                                // through the enabled channels
+    ADC_MODE_DMA                // Timer3 triggered, all channels at once
+                                // through DMA channel 2
+} ADC_MODE;
+
+// Full scale of ADC_Read(), oversampled to ADC1_RESULT_BITS in every mode
+#define ADC_FULL_SCALE          (1023u << ADC1_OVERSAMPLE_BITS)
 
 /*********************************************************************
-* Function: ADC_ReadPercentage(ADC_CHANNEL channel);
+* Function: bool ADC_SetMode(ADC_MODE mode, uint16_t rateHz);
 *
-* Overview: Reads the requested ADC channel and returns the percentage
-*            of that conversions result (0-100%).
+* Overview: Stops any running acquisition and restarts the ADC in the
+*           requested mode
 *
-* PreCondition: channel is enabled via ADC_ChannelEnable()
+* PreCondition: SYSTEM_Initialize() has been called. For the interrupt
+*               mode the channels are enabled via ADC_ChannelEnable()
 *
-* Input: ADC_CHANNEL channel - enumeration of the ADC channels
-*        available in this demo.  They should be meaningful names and
-*        not the names of the ADC pins on the device (as the demo code
-*        may be ported to other boards).
-*         i.e. ADC_ReadPercentage(ADC_CHANNEL_POTENTIOMETER);
+* Input: ADC_MODE mode - blocking, interrupt or DMA
+*        uint16_t rateHz - Timer3 trigger rate, unused when blocking
 *
-* Output: uint8_t indicating the percentage of the result 0-100% or
-*         0xFF for an error
+* Output: bool - true if successfully configured.  false otherwise.
 *
 ********************************************************************/
-uint8_t ADC_ReadPercentage(ADC_CHANNEL channel);
+bool ADC_SetMode(ADC_MODE mode, uint16_t rateHz);
 
+/*********************************************************************
+* Function: bool ADC_ChannelEnable(ADC_CHANNEL channel);
+*
+* Overview: Makes the pin of the channel an analog input and adds the
+*           channel to the ones converted in interrupt mode
+*
+* PreCondition: none
+*
+* Input: ADC_CHANNEL channel - the channel to enable
+*
+* Output: bool - true if successfully configured.  false otherwise.
+*
+********************************************************************/
+bool ADC_ChannelEnable(ADC_CHANNEL channel);
 
 /*********************************************************************
-* Function: ADC_Read10bit(ADC_CHANNEL channel);
+* Function: ADC_Read(ADC_CHANNEL channel);
 *
-* Overview: Reads the requested ADC channel and returns the 10-bit
-*           representation of this data.
+* Overview: Returns the latest result of the requested channel with
+*           ADC1_RESULT_BITS of resolution. Converts and waits in
+*           blocking mode, never waits otherwise
 *
-* PreCondition: channel is enabled via ADC_ChannelEnable()
+* PreCondition: ADC_SetMode() has been called and in interrupt mode the
+*               channel is enabled via ADC_ChannelEnable()
 *
 * Input: ADC_CHANNEL channel - enumeration of the ADC channels
-*        available in this demo.  They should be meaningful names and
-*        not the names of the ADC pins on the device (as the demo code
-*        may be ported to other boards).
-*         i.e. - ADCReadPercentage(ADC_CHANNEL_POTENTIOMETER);
+*         i.e. ADC_Read(ADC_CHANNEL_LIGHT);
 *
-* Output: uint16_t the right adjusted 10-bit representation of the ADC
-*         channel conversion or 0xFFFF for an error.
+* Output: uint16_t the right adjusted result of the ADC channel, 0 before
+*         the first conversion or 0xFFFF for an error.
 *
 ********************************************************************/
-uint16_t ADC_Read10bit(ADC_CHANNEL channel);
+uint16_t ADC_Read(ADC_CHANNEL channel);
 
 /*********************************************************************
-* Function: bool ADC_ChannelEnable(ADC_CHANNEL channel, ADC_CONFIGURATION configuration);
+* Function: ADC_Read10bit(ADC_CHANNEL channel);
 *
-* Overview: Enables specified channel
+* Overview: Reads the requested ADC channel and returns the 10-bit
+*           representation of this data.
 *
-* PreCondition: none
+* PreCondition: as for ADC_Read()
 *
-* Input: ADC_CHANNEL channel - the channel to enable
+* Input: ADC_CHANNEL channel - enumeration of the ADC channels
+*         i.e. ADC_Read10bit(ADC_CHANNEL_MOISTURE);
 *
-* Output: bool - true if successfully configured.  false otherwise.
+* Output: uint16_t the right adjusted 10-bit representation of the ADC
+*         channel conversion or 0xFFFF for an error.
 *
 ********************************************************************/
-bool ADC_ChannelEnable(ADC_CHANNEL channel);
+uint16_t ADC_Read10bit(ADC_CHANNEL channel);
 
 /*********************************************************************
-* Function: bool ADC_SetConfiguration(ADC_CONFIGURATION configuration)
+* Function: ADC_ReadPercentage(ADC_CHANNEL channel);
 *
-* Overview: Configures the ADC module to specified setting
+* Overview: Reads the requested ADC channel and returns the percentage
+*            of that conversions result (0-100%).
 *
-* PreCondition: none
+* PreCondition: as for ADC_Read()
 *
-* Input: ADC_CONFIGURATION configuration - the mode in which to run the ADC
+* Input: ADC_CHANNEL channel - enumeration of the ADC channels
+*         i.e. ADC_ReadPercentage(ADC_CHANNEL_MOISTURE);
 *
-* Output: bool - true if successfully configured.  false otherwise.
+* Output: uint8_t indicating the percentage of the result 0-100% or
+*         0xFF for an error
 *
 ********************************************************************/
-bool ADC_SetConfiguration(ADC_CONFIGURATION configuration);
+uint8_t ADC_ReadPercentage(ADC_CHANNEL channel);
 
 #endif  //ADC_H
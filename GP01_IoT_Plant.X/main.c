@@ -29,10 +29,13 @@
  *                      because the moisture sensor is powered via transistor
  *                      by pin RB15.
  * 
- *                      The program is state machine based and consists of four
- *                      states. State One measures light intensity, state two
- *                      temperature, state three soil moisture and state four
- *                      prints to the on board OLED. 
+ *                      The program is made of periodic tasks run by a 
+ *                      cooperative scheduler on the TMR1 tick. The tasks 
+ *                      measure light intensity, temperature, soil moisture and
+ *                      battery charge, draw the on board OLED and log and send
+ *                      the readings, each at its own rate. Between tasks
+ *                      the CPU idles, or sleeps when the next one is far
+ *                      enough away and no probe reading is in progress. 
  * 
  *                       
  * Hardware Description: 
@@ -95,359 +98,389 @@
 #include <stdbool.h>
 #include "SSD1306_OLED.h"
 #include "IoT_Plant_Specific.h"
-
-// Number of states for SM
-#define NUM_STATES 4
+#include "Bus_Trace.h"
+#include "EEPROM_Log.h"
+#include "I2C_Bus.h"
+#include "DS1722.h"
+#include "SPI_Bus.h"
+#include "SPI2_DMA.h"
+#include "Flash_Log.h"
+#include "DSP_Filter.h"
+#include "Lux_Cal.h"
+#include "Classifier.h"
+#include "adc.h"
+#include "Moisture_Probe.h"
+#include "Battery.h"
+#include "Event_Queue.h"
+#include "Scheduler.h"
+#include "Low_Power.h"
 
 
 /*****************************
  * Variables of type extern
  * see TMR1 interrupt routine
  ****************************/
-uint16_t msCount;
+volatile uint16_t msCount;
+
+// Soil check requested, set from the EVENT_SOIL_CHECK handler
 bool check_soil;
  
 /*******************************************************************************
  * Function Prototypes
  ******************************************************************************/
  void initMain(void);
+ void Battery_Report(void);
+ void Soil_Check_Event(uint16_t data);
 
- void SM_STATE_ONE(void);      // Light Intensity 
- void SM_STATE_TWO(void);      // Temperature
- void SM_STATE_THREE(void);    // Soil Moisture
- void SM_STATE_FOUR(void);     // OLED
- 
- // Prototypes for temp sensor
- int16_t Read_DS1722();
- void Config_DS1722(uint8_t u8_i);
+ void Probe_Task(void);        // Moisture probe sequence
+ void Light_Task(void);        // Light Intensity 
+ void Temperature_Task(void);  // Temperature
+ void Moisture_Task(void);     // Soil Moisture
+ void Battery_Task(void);      // Battery charge
+ void Display_Task(void);      // OLED
+ void Telemetry_Task(void);    // Logging and counters
  
  // booleans to store plant mood
  bool Good_Light  = true;
  bool Good_Moisture = true;
+ bool Good_Temperature = true;
  bool Happy_State = true;
  
-/*******************************************************************************
- * Global Variables
- ******************************************************************************/
+ // last readings, stored in the EEPROM log
+ uint16_t Light_Reading;
+ uint16_t Moisture_Reading;
+ int16_t  Temp_Reading;
+ bool     Moisture_Sampled = false;
+ 
+ // light smoothing, median rejects shadows and flicker spikes, then a
+ // low-pass settles slow changes
+ DSP_MEDIAN Light_Median;
+ DSP_IIR    Light_Filter;
  
- // enum of each state
- typedef enum
+ // debounced light and moisture bands, only changes are reported
+ enum { LIGHT_POOR, LIGHT_FAIR, LIGHT_GOOD };
+ enum { MOISTURE_DRY, MOISTURE_GOOD };
+ enum { TEMP_COLD, TEMP_GOOD, TEMP_HOT };
+ 
+ char *Light_Text[] = {"Lighting Poor", "Lighting Fair", "Lighting Good"};
+ char *Moisture_Text[] = {"Dry, water plant", "Moisture Good"};
+ char *Temp_Text[] = {"Too cold", "Temperature Good", "Too hot"};
+ 
+ const uint16_t Light_Edges[] = {LIGHT_FAIR_LUX, LIGHT_GOOD_LUX};
+ const CLASSIFIER_CONFIG Light_Config =
  {
-     STATE_ONE,
-     STATE_TWO,
-     STATE_THREE,
-     STATE_FOUR
- }StateType;
-
- // define state machine table structure
- typedef struct
+     Light_Edges, 3, LIGHT_HYSTERESIS_LUX,
+     LIGHT_VOTES, LIGHT_WINDOW, LIGHT_DWELL_TICKS
+ };
+ 
+ const uint16_t Moisture_Edges[] = {MOISTURE_GOOD_COUNTS};
+ const CLASSIFIER_CONFIG Moisture_Config =
  {
-     StateType State;       // Define the command
-     void(*func)(void);     // Defines the function to run
- }StateMachineType;
+     Moisture_Edges, 2, MOISTURE_HYSTERESIS_COUNTS,
+     1, 1, 0
+ };
  
-// Table that defines valid states of the sm and function to be executed for 
-StateMachineType StateMachine[] =
+ // temperature band edges stay Q8.8, offset to unsigned for the classifier
+ const uint16_t Temp_Edges[] =
  {
-     {STATE_ONE, SM_STATE_ONE},
-     {STATE_TWO, SM_STATE_TWO},
-     {STATE_THREE, SM_STATE_THREE},
-     {STATE_FOUR, SM_STATE_FOUR}
+     DS1722_ORDERED(TEMP_COLD_Q8_8), DS1722_ORDERED(TEMP_HOT_Q8_8)
+ };
+ const CLASSIFIER_CONFIG Temp_Config =
+ {
+     Temp_Edges, 3, TEMP_HYSTERESIS_Q8_8,
+     1, 1, 0
+ };
+ 
+ CLASSIFIER Light_Class;
+ CLASSIFIER Moisture_Class;
+ CLASSIFIER Temp_Class;
+ 
+ // power mode, follows the battery level
+ BatteryLevel Power_Level = BATTERY_OK;
+ 
+ // TMR1 timestamp of the last EEPROM log record and page buffer flush
+ uint32_t Last_Log_Time;
+ uint32_t Last_Flush_Time;
+ 
+ // seconds of logging, carried on across resets by the flash log
+ uint32_t Log_Time;
+ bool     Log_Boot = true;
+ 
+/*******************************************************************************
+ * Global Variables
+ ******************************************************************************/
+ 
+// Table of tasks, run in this order when due together. Deadline is how late
+// a task may start, budget how long it may run, both in ms. Output is sent
+// at 9600 baud, about 1 ms per character
+SCHED_TASK Tasks[] =
+ {
+     SCHED_TASK_INIT("probe",   Probe_Task,       PROBE_PERIOD_MS,     10,  2),
+     SCHED_TASK_INIT("light",   Light_Task,       LIGHT_PERIOD_MS,    500, 30),
+     SCHED_TASK_INIT("temp",    Temperature_Task, TEMP_PERIOD_MS,    1000, 40),
+     SCHED_TASK_INIT("soil",    Moisture_Task,    MOISTURE_PERIOD_MS, 500, 30),
+     SCHED_TASK_INIT("battery", Battery_Task,     BATTERY_PERIOD_MS,  500, 60),
+     SCHED_TASK_INIT("display", Display_Task,     DISPLAY_PERIOD_MS,  500, 60),
+     SCHED_TASK_INIT("log",     Telemetry_Task,   TELEMETRY_PERIOD_MS, 500, 150)
  };
 
-// Store current state of state machine
-StateType SM_STATE = STATE_ONE;
+// Number of tasks in the table
+#define NUM_TASKS (sizeof(Tasks) / sizeof(Tasks[0]))
 
 /*******************************************************************************
- * Function:        void Config_DS1722(uint8_t u8_i)
+ * Function:        void Probe_Task(void)
  *
- * PreCondition:    SPI module should have been enabled
+ * PreCondition:    Probe_Init() should have been called
  *
- * Input:           Arguments to configure DS1722
+ * Input:           None
  *
  * Output:          None
  *
- * Overview:        Configures the DS1722 temperature sensor
+ * Overview:        Steps the probe sequence every PROBE_PERIOD_MS while a
+ *                  reading is in progress
  * 
- * Usage:           void Config_DS1722()
+ * Usage:           None
  *
- * Note:            None
+ * Note:            Suspends itself between readings so the CPU can sleep,
+ *                  the moisture task resumes it
  ******************************************************************************/
-void Config_DS1722(uint8_t u8_i)
+void Probe_Task(void)
 {
-    // Enable slave
-    LATBbits.LATB7 = 1;
-   
-    // As per datasheet
-    SPI2_Exchange8bit(0x80);
-    SPI2_Exchange8bit(u8_i);
+    Probe_Tasks();
     
-    // Disable slave
-    LATBbits.LATB7 = 0;
+    if (!Probe_IsBusy())
+    {
+        Scheduler_Suspend(Probe_Task);
+    }
 }
 
 /*******************************************************************************
- * Function:        int16_t Read_DS1722()
+ * Function:        void Light_Task(void)
  *
- * PreCondition:    SPI module should have been enabled and DS1722 initialized
+ * PreCondition:    Task table should have been initialized
  *
  * Input:           None
  *
  * Output:          None
  *
- * Overview:        Reads the DS1722 temperature sensor as per Table 4 of 
- *                  datasheet 
+ * Overview:        Reads the lighting conditions every LIGHT_PERIOD_MS
  * 
- * Usage:           uint16_t temp = Read_DS1722()
+ * Usage:           None
  *
  * Note:            None
  ******************************************************************************/
-int16_t Read_DS1722()
+void Light_Task(void)
 {
-    uint16_t u16_lo, u16_hi;
-    
-    LATBbits.LATB7 = 1;                // assert chip select
-    SPI2_Exchange8bit(0x01);           // LSB address
-    u16_lo = SPI2_Exchange8bit(0x00);  // read LSByte
-    u16_hi = SPI2_Exchange8bit(0x00);  // read MSbyte
     
-    LATBbits.LATB7 = 0;                // chip select off
-    
-    return ((u16_hi<<8) | u16_lo);     // return raw temp values
+    uint16_t conversion;  // Variable for conversion
+    uint16_t lux;
+    int16_t  light;
+    
+    // Photoresistor from the latest ADC snapshot, filtered
+    light = DSP_FROM_ADC(ADC_Read(ADC_CHANNEL_LIGHT));
+    light = DSP_Median_Update(&Light_Median, light);
+    conversion = DSP_TO_ADC(DSP_IIR_Update(&Light_Filter, light));
+    Light_Reading = conversion;
+    lux = Lux_Cal_FromADC(conversion);
+    
+#if LUX_CAL_CAPTURE
+    printf("LUXCAL %u %u\n", conversion, lux);
+#endif
+    
+    // Bright sun or lamp is good, a dim lamp fair, lights off poor
+    if (Classifier_Update(&Light_Class, lux, TMR1_TimestampGet()))
+    {
+        printf("Light: %u lux\n", lux);
+        printf("%s\n", Light_Text[Classifier_State(&Light_Class)]);
+        Good_Light = (Classifier_State(&Light_Class) != LIGHT_POOR);
+    }
 }
 
+
 /*******************************************************************************
- * Function:        void SM_STATE_ONE(void)
+ * Function:        void Temperature_Task(void)
  *
- * PreCondition:    Table structure for states should have been initialized
- *                  as well as enum for each state
+ * PreCondition:    Task table should have been initialized
  *
  * Input:           None
  *
  * Output:          None
  *
- * Overview:        State One reads the lighting conditions
+ * Overview:        Reads the temperature of the DS1722 every TEMP_PERIOD_MS
  * 
  * Usage:           None
  *
- * Note:            None
+ * Note:            Never waits for the DS1722, a conversion still running
+ *                  is collected on a later run
  ******************************************************************************/
-void SM_STATE_ONE(void)
+
+void Temperature_Task(void)
 {
+    int16_t i16_tempC;
+    char tempC[DS1722_FORMAT_SIZE];
+    char tempF[DS1722_FORMAT_SIZE];
     
-    uint16_t conversion;  // Variable for conversion
-    uint16_t i;           // Loop variable
-    
-    // Set channel 0
-    ADC1_ChannelSelectSet(ADC1_CHANNEL_AN0);
-        
-    // Start sampling
-    ADC1_SamplingStart();
-        
-    //Provide Delay
-    for(i=0;i <1000;i++)
-    {
-    }
-    
-    // Stop sampling
-    ADC1_SamplingStop();
-      
-    // Wait for conversion to complete
-    while(!ADC1_IsConversionComplete())
+    // Collect the one-shot conversion once it is done and start the next,
+    // until then show the previous reading
+    if (DS1722_GetResult(&Temp_Reading))
     {
-        ADC1_Tasks();   
-    }
-      
-    
-    // Read channel 0 (photoresistor)
-    conversion = ADC1_Channel0ConversionResultGet();
-    
-    
-    // Bright Sun or Lamp
-    if (conversion >= 500)
-    {
-        SSD1306_Write_Text ( 0, 0, "Lighting Good", 1, WHITE);
-        printf("Lighting Good\n");
-        Good_Light = true;
+        DS1722_StartConversion();
+        
+        // Report the temperature band when it changes, compared in Q8.8
+        if (Classifier_Update(&Temp_Class, DS1722_ORDERED(Temp_Reading),
+                              TMR1_TimestampGet()))
+        {
+            Good_Temperature = (Classifier_State(&Temp_Class) == TEMP_GOOD);
+            printf("%s\n", Temp_Text[Classifier_State(&Temp_Class)]);
+        }
     }
     
-    // Dim Lamp
-    else if ((conversion >= 300) && (conversion <= 499))
-    {
-        SSD1306_Write_Text ( 0, 0, "Lighting Fair", 1, WHITE);
-        printf("Lighting Fair\n");
-        Good_Light = true;
-    }
+    // Celsius is the DS1722 reading itself, Q8.8
+    i16_tempC = Temp_Reading;
     
-    // Room with lights off
-    else if (conversion <= 299)
-    {
-        SSD1306_Write_Text ( 0, 0, "Lighting Poor", 1, WHITE);
-        printf("Lighting Poor\n");
-        Good_Light = false;
-    }
+    // Format Celsius and Farenheit without floating point
+    DS1722_Format(tempC, i16_tempC, false);
+    DS1722_Format(tempF, i16_tempC, true);
     
-    // Go to state two
-    SM_STATE = STATE_TWO;
+    // Send temp Celsius and Farenheit to BT
+    printf("Temp: %s C \t %s F\n", tempC, tempF);
 }
 
-
 /*******************************************************************************
- * Function:        void SM_STATE_TWO(void)
+ * Function:        void Moisture_Task(void)
  *
- * PreCondition:    Table structure for states should have been initialized
- *                  as well as enum for each state
+ * PreCondition:    Task table should have been initialized
  *
  * Input:           None
  *
  * Output:          None
  *
- * Overview:        State Two reads the temperature of the DS1722
+ * Overview:        Starts a soil moisture reading when one is requested and
+ *                  collects the result from the probe task
  * 
  * Usage:           None
  *
  * Note:            None
  ******************************************************************************/
-
-void SM_STATE_TWO(void)
+void Moisture_Task(void)
 {
-    uint16_t i16_temp;
-    float f_tempC;
-    float f_tempF;
-    
-    // Read temp sensor
-    i16_temp = Read_DS1722();
-    
-    // Perform Celsius conversion 
-    f_tempC = i16_temp;
-    f_tempC = f_tempC/256;
+    uint16_t Moisture_Conversion;  // Variable for conversion
     
-    // Perform Farenheit conversion
-    f_tempF = f_tempC*9/5 + 32;
-        
-    // Write temperature in Celsius
-    SSD1306_Write_Float(0,   20, f_tempC, 1);
-    SSD1306_Write_Text (35,  20, "C", 1, WHITE);
-        
-    // Write temperature in Farenheit
-    SSD1306_Write_Float(55,  20, f_tempF, 1);
-    SSD1306_Write_Text (95,  20, "F", 1, WHITE);
+    // TMR1 asks for a soil check, the probe sequencer powers the probe
+    // only while it takes its burst
+    if ((check_soil == true) && Probe_Start())
+    {
+        printf("Checking soil\n");
+        check_soil = false;
+        Scheduler_Resume(Probe_Task);
+    }
     
-    // Send temp Celsius and Farenheit to BT
-    printf("Temp: %.2f C \t %.2f F\n", f_tempC, f_tempF);
-        
-    // Transition to state three
-    SM_STATE = STATE_THREE;  
+    if (Probe_ResultGet(&Moisture_Conversion))
+    {
+        // Median of the burst
+        Moisture_Reading = Moisture_Conversion;
+        Moisture_Sampled = true;
+   
+        // Report the moisture band when it changes
+        if (Classifier_Update(&Moisture_Class, Moisture_Conversion,
+                              TMR1_TimestampGet()))
+        {
+            Good_Moisture =
+                (Classifier_State(&Moisture_Class) == MOISTURE_GOOD);
+            printf("%s\n", Moisture_Text[Good_Moisture]);
+        }
+    }
 }
 
 /*******************************************************************************
- * Function:        void SM_STATE_THREE(void)
+ * Function:        void Battery_Task(void)
  *
- * PreCondition:    Table structure for states should have been initialized
- *                  as well as enum for each state
+ * PreCondition:    Battery_Init() should have been called
  *
  * Input:           None
  *
  * Output:          None
  *
- * Overview:        State Three reads the soil moisture
+ * Overview:        Counts the battery charge and reports every voltage
+ *                  sample
  * 
  * Usage:           None
  *
  * Note:            None
  ******************************************************************************/
-void SM_STATE_THREE(void)
+void Battery_Task(void)
 {
-    uint16_t Moisture_Conversion;  // Variable for conversion
-    uint16_t i;                    // Loop variable
-    
-    if (check_soil == true){
-        printf("Checking soil\n");
-        // Select channel 1 (Moisture sensor)
-        ADC1_ChannelSelectSet(ADC1_CHANNEL_AN1);
-        
-        // Start Sampling
-        ADC1_SamplingStart();
-        
-        //Provide Delay
-        for(i=0;i <1000;i++)
-        {
-        }
-    
-        // Stop sampling
-        ADC1_SamplingStop();
-        
-        // Wait for conversion to complete
-        while(!ADC1_IsConversionComplete())
-        {
-            ADC1_Tasks();   
-        }
-    
-        // Read ADC1 (Moisture sensor)
-        Moisture_Conversion = ADC1_Channel1ConversionResultGet();
-   
-        // If Moisture Good, set bool true
-        if (Moisture_Conversion >= 400)
-        {
-            Good_Moisture = true;   
-        }
-    
-        // If moisture poor set bool false
-        else if (Moisture_Conversion <= 399)
-        {
-            Good_Moisture = false;
-        }
-    
-        check_soil = false;
-        POWER_PIN = OFF;
-   }
-     
-    // Transition to state 4
-    SM_STATE = STATE_FOUR;
+    if (Battery_Tasks())
+    {
+        Battery_Report();
+    }
 }
 
 
 /*******************************************************************************
- * Function:        void SM_STATE_FOUR(void)
+ * Function:        void Display_Task(void)
  *
- * PreCondition:    Table structure for states should have been initialized
- *                  as well as enum for each state
+ * PreCondition:    Task table should have been initialized
  *
  * Input:           None
  *
  * Output:          None
  *
- * Overview:        State four writes accumulated buffer to  the SSD1306, prints
- *                  plant status and current count
+ * Overview:        Draws the latest readings and plant mood and queues the
+ *                  buffer for the SSD1306, the main loop sends it a page at
+ *                  a time through I2C_Bus_Tasks()
  * 
  * Usage:           None
  *
- * Note:            None
+ * Note:            Skips a run while the previous frame is still being sent
  ******************************************************************************/
-void SM_STATE_FOUR(void)
+void Display_Task(void)
 {
-    // print current count max = 12000
-    printf("Count: %d\n", msCount);
+    char battery[20];
+    char tempC[DS1722_FORMAT_SIZE];
+    char tempF[DS1722_FORMAT_SIZE];
+    
+    // The buffer must not change while it is being sent
+    if (SSD1306_Write_Buffer_Busy())
+    {
+        return;
+    }
+    
+    SSD1306_Clear_Display();
+    
+    //////////////////////////////////
+    // Display lighting conditions
+    //////////////////////////////////
+    SSD1306_Write_Text ( 0, 0, Light_Text[Classifier_State(&Light_Class)],
+                         1, WHITE);
     
     //////////////////////////////////
     // Display last moisture reading
     //////////////////////////////////
-    if (Good_Moisture == true)
-    {
-       SSD1306_Write_Text ( 0, 10, "Moisture Good", 1, WHITE);
-       printf("Moisture Good\n");
-    }
+    SSD1306_Write_Text ( 0, 10, Moisture_Text[Good_Moisture], 1, WHITE);
     
-    else if (Good_Moisture == false)
-    {
-        SSD1306_Write_Text ( 0, 10, "Dry, water plant", 1, WHITE);
-        printf("Dry, water plant\n");
-    }
+    //////////////////////////////////
+    // Display temperature
+    //////////////////////////////////
+    DS1722_Format(tempC, Temp_Reading, false);
+    DS1722_Format(tempF, Temp_Reading, true);
+    SSD1306_Write_Text (0,   20, tempC, 1, WHITE);
+    SSD1306_Write_Text (35,  20, "C", 1, WHITE);
+    SSD1306_Write_Text (55,  20, tempF, 1, WHITE);
+    SSD1306_Write_Text (95,  20, "F", 1, WHITE);
+    
+    //////////////////////////////////
+    // Display battery and runtime
+    //////////////////////////////////
+    sprintf(battery, "Batt %u%% %uh", Battery_Percent(),
+            Battery_RuntimeMinutes() / 60);
+    SSD1306_Write_Text ( 0, 30, battery, 1, WHITE);
     
     ////////////////////////
     // Display plant mood
     ////////////////////////
-    if ((Good_Light == true) && (Good_Moisture == true))
+    if ((Good_Light == true) && (Good_Moisture == true) &&
+        (Good_Temperature == true))
     {
         Happy_State = true;
     }
@@ -468,47 +501,189 @@ void SM_STATE_FOUR(void)
     }
     
     ///////////////////////////
-    // Write buffer to OLED
+    // Write buffer to OLED, off to save power when the battery is low
     //////////////////////////
-    SSD1306_Write_Buffer();
-    __delay_ms(1000);
-    SSD1306_Clear_Display();
-      
-    SM_STATE = STATE_ONE; 
+    if (Power_Level == BATTERY_OK)
+    {
+        SSD1306_Write_Buffer_Start();
+    }
 }
 
 /*******************************************************************************
- * Function:        RUN_STATEMACHINE(void)
+ * Function:        void Telemetry_Task(void)
  *
- * PreCondition:    Table structure for states should have been initialized
- *                  as well as enum for each state
+ * PreCondition:    Task table should have been initialized
  *
  * Input:           None
  *
  * Output:          None
  *
- * Overview:        Allows state machine to run
+ * Overview:        Prints the current count and statistics, logs the
+ *                  readings every LOG_INTERVAL_S and writes records held in
+ *                  the EEPROM page buffer every LOG_FLUSH_S
  * 
- * Usage:           RUN_STATEMACHINE()
+ * Usage:           None
  *
  * Note:            None
  ******************************************************************************/
-void RUN_STATEMACHINE (void)
+void Telemetry_Task(void)
 {
-    // Make Sure States is valid
-    if (SM_STATE < NUM_STATES)
+    // print current count max = 24000
+    printf("Count: %u\n", msCount);
+    
+    // Per client I2C bus time, when I2C_BUS_REPORT is enabled
+    I2C_Bus_Report();
+    
+    ///////////////////////////
+    // Log readings to EEPROM
+    //////////////////////////
+    if (TMR1_TimestampGet() - Last_Log_Time >= LOG_INTERVAL_TICKS)
+    {
+        EELogRecord rec;
+        FlashLogSample sample;
+        
+        rec.flags = 0;
+        if (Good_Light) rec.flags |= EE_LOG_FLAG_LIGHT_GOOD;
+        if (Good_Moisture) rec.flags |= EE_LOG_FLAG_MOISTURE_GOOD;
+        if (Good_Temperature) rec.flags |= EE_LOG_FLAG_TEMP_GOOD;
+        if (Moisture_Sampled) rec.flags |= EE_LOG_FLAG_MOISTURE_NEW;
+        rec.light = Light_Reading;
+        rec.moisture = Moisture_Reading;
+        rec.temperature = Temp_Reading;
+        
+        EE_Log_Append(&rec);
+        
+        // Same sample to the long term flash history
+        sample.time = Log_Time;
+        sample.flags = rec.flags;
+        if (Log_Boot) sample.flags |= FLASH_LOG_FLAG_BOOT;
+        sample.light = rec.light;
+        sample.moisture = rec.moisture;
+        sample.temperature = rec.temperature;
+        
+        Flash_Log_Append(&sample);
+        Log_Time += LOG_INTERVAL_S;
+        Log_Boot = false;
+        
+        Moisture_Sampled = false;
+        Last_Log_Time += LOG_INTERVAL_TICKS;
+    }
+    
+    // Records in the page buffer are lost with the battery, write a part
+    // filled page now and then
+    if (TMR1_TimestampGet() - Last_Flush_Time >= LOG_FLUSH_TICKS)
     {
-        // Call function for state
-        (*StateMachine[SM_STATE].func)();
+        EE_Log_Flush();
+        Last_Flush_Time = TMR1_TimestampGet();
+    }
+    
+#if BUS_TRACE_ENABLE
+    // HC-05 TX is not wired back to us, so send the trace every run, a few
+    // records at a time to stay within the task budget
+    Bus_Trace_Dump(BUS_TRACE_DUMP_RECORDS);
+#endif
+    
+    // Task run times, when SCHED_REPORT is enabled
+    Scheduler_Report();
+    
+    // Time awake, idle and asleep, when LOW_POWER_REPORT is enabled
+    Low_Power_Report();
+}
+
+/*******************************************************************************
+ * Function:        void Soil_Check_Event(uint16_t data)
+ *
+ * PreCondition:    Registered for EVENT_SOIL_CHECK
+ *
+ * Input:           Unused
+ *
+ * Output:          None
+ *
+ * Overview:        TMR1 posts this every 2 hours, the moisture task then
+ *                  starts a probe reading
+ * 
+ * Usage:           Event_Register(EVENT_SOIL_CHECK, Soil_Check_Event)
+ *
+ * Note:            None
+ ******************************************************************************/
+void Soil_Check_Event(uint16_t data)
+{
+    check_soil = true;
+}
+
+/*******************************************************************************
+ * Function:        void Battery_Report(void)
+ *
+ * PreCondition:    Battery_Init() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Sends the battery state to BT and switches power mode
+ *                  when the battery level changes. Low turns the OLED off,
+ *                  critical also slows the ADC triggers. Records held in
+ *                  the EEPROM page buffer are written when the level drops
+ * 
+ * Usage:           Battery_Report()
+ *
+ * Note:            Called for every battery voltage sample
+ ******************************************************************************/
+void Battery_Report(void)
+{
+    BatteryLevel level = Battery_Level();
+    
+    printf("Battery: %u mV %u%% %u min\n", Battery_Millivolts(),
+           Battery_Percent(), Battery_RuntimeMinutes());
+    
+    if (level == Power_Level)
+    {
+        return;
+    }
+    
+    // OLED on only with a good battery, sent through the I2C bus arbiter
+    if (level == BATTERY_OK)
+    {
+        SSD1306_Display_Power_Start(true);
+    }
+    else if (Power_Level == BATTERY_OK)
+    {
+        SSD1306_Display_Power_Start(false);
+    }
+    
+    // The battery may be swapped or run out soon, keep the log
+    if (level != BATTERY_OK)
+    {
+        EE_Log_Flush();
+    }
+    
+    // Fewer snapshots when critical
+    if (level == BATTERY_CRITICAL)
+    {
+        ADC_SetMode(ADC_MODE_DMA, ADC_CRITICAL_RATE_HZ);
+    }
+    else if (Power_Level == BATTERY_CRITICAL)
+    {
+        ADC_SetMode(ADC_MODE_DMA, ADC_TRIGGER_RATE_HZ);
+    }
+    
+    if (level == BATTERY_OK)
+    {
+        printf("Battery OK\n");
+        Battery_SetLoad(BATTERY_ACTIVE_MA);
+    }
+    else if (level == BATTERY_LOW)
+    {
+        printf("Battery low, display off\n");
+        Battery_SetLoad(BATTERY_LOW_MA);
     }
     else
     {
-        // Code should never reach here
-        while(1)
-        {
-            // Some exception handling;
-        }
+        printf("Battery critical, recharge\n");
+        Battery_SetLoad(BATTERY_CRITICAL_MA);
     }
+    
+    Power_Level = level;
 }
 
 /*******************************************************************************
@@ -528,28 +703,71 @@ void RUN_STATEMACHINE (void)
  ******************************************************************************/ 
 int main(void)
 {
+    uint32_t logo;
+    
     // Initialize main
     initMain();
     
-    // Display Logo
-    SSD1306_Write_Buffer();
-    __delay_ms(3000);
+    // Display Logo, sent between the log reads below
+    logo = TMR1_TimestampGet();
+    SSD1306_Write_Buffer_Start();
+    
+    // Configure DS1722 for one-shot conversions and start the first
+    DS1722_Init(DS1722_RESOLUTION, true);
+    DS1722_StartConversion();
+    
+    // Find end of sensor log, logging is off if no EEPROM is fitted
+    if (EE_Log_Init())
+    {
+#if EE_LOG_EXPORT_AT_BOOT
+        EE_Log_Export();
+#endif
+    }
+    
+    // Recover the flash history, time carries on from the last sample
+    // (there is no RTC so the time spent powered off is not counted)
+    Flash_Log_Init();
+    Log_Time = Flash_Log_LastTime() + LOG_INTERVAL_S;
+    
+    // Keep the logo up for LOGO_TICKS
+    while (SSD1306_Write_Buffer_Busy() ||
+           TMR1_TimestampGet() - logo < LOGO_TICKS)
+    {
+        I2C_Bus_Tasks();
+    }
     
     // Clear SSD1306 
     SSD1306_Clear_Display();
+    Last_Log_Time = TMR1_TimestampGet();
+    Last_Flush_Time = Last_Log_Time;
     
-    // Configure DS1722 as per datasheet
-    Config_DS1722(0xE8);
+    // Power mode for the battery at start up
+    Battery_Report();
   
-    // Initially turn on moisture sensor and perform check on soil
-    POWER_PIN = ON;
-    __delay_ms(1000);
+    // Perform an initial check on the soil
     check_soil = true;
+    
+    // Every task is due straight away
+    Scheduler_Init(Tasks, NUM_TASKS);
+    Low_Power_Init();
  
     while(1)
     {
-        // Start the state machine
-        RUN_STATEMACHINE();
+        bool busy;
+        
+        // Handle events posted by the interrupts
+        Event_Dispatch();
+        
+        // Run queued SPI transactions and a step of the queued I2C jobs
+        busy = SPI_Bus_Tasks();
+        busy |= I2C_Bus_Tasks();
+        
+        // Run the tasks that are due. With nothing to do wait for the
+        // next one, asleep unless the probe needs the ADC running
+        if (!Scheduler_Run() && !busy)
+        {
+            Low_Power_Wait(Scheduler_NextDue(), !Probe_IsBusy());
+        }
     }
     
     return 0;
@@ -578,13 +796,32 @@ void initMain(void)
    
     // Initialize system
     SYSTEM_Initialize();
+    Event_Register(EVENT_SOIL_CHECK, Soil_Check_Event);
+    SPI2_DMA_Initialize();
+    
+    // Snapshot all analog inputs in the background
+    ADC_SetMode(ADC_MODE_DMA, ADC_TRIGGER_RATE_HZ);
     __delay_ms(1000);
     
+    // Charge estimate from the first pack voltage reading
+    Battery_Init();
+    
+    // Plant mood bands, set by the first readings
+    Classifier_Init(&Light_Class, &Light_Config);
+    Classifier_Init(&Moisture_Class, &Moisture_Config);
+    Classifier_Init(&Temp_Class, &Temp_Config);
+    
+    // Start the light filters from the first reading
+    DSP_Filter_Init();
+    DSP_Median_Init(&Light_Median, DSP_FROM_ADC(ADC_Read(ADC_CHANNEL_LIGHT)));
+    DSP_IIR_Init(&Light_Filter, DSP_Q15(0.25),
+                 DSP_FROM_ADC(ADC_Read(ADC_CHANNEL_LIGHT)));
+    
     // Initialize SSD1306
     SSD1306_INIT();
     
-    // Moisture sensor pin
-    TRISBbits.TRISB15 = 0;
+    // Moisture sensor pin, probe off
+    Probe_Init();
     
     __delay_ms(2000);
 }
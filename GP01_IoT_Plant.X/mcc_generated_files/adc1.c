@@ -49,6 +49,8 @@
 
 #include <xc.h>
 #include "adc1.h"
+#include "../mcc_generated_files/mcc.h"
+#include "../dsPIC33_STD.h"
 
 /**
   Section: Data Type Definitions
@@ -73,6 +75,12 @@ ADC_OBJECT;
 
 static ADC_OBJECT adc1_obj;
 
+// Filled by DMA channel 2 one half at a time, the interrupt decimates and
+// publishes the half just completed while the other fills
+static volatile uint16_t adc1_dma_buffer[2][ADC1_OVERSAMPLE][ADC1_RESULT_SLOTS];
+static volatile uint16_t adc1_results[ADC1_RESULT_SLOTS];
+static volatile uint16_t adc1_count;
+
 /**
   Section: Driver Interface
 */
@@ -121,6 +129,141 @@ void ADC1_Tasks ( void )
     IFS0bits.AD1IF = false;
 }
 
+void ADC1_TriggeredAcquisitionStart(uint16_t rateHz)
+{
+    AD1CON1bits.ADON = 0;
+
+    // Timer3 off, 1:256 prescaler, period of one trigger
+    T3CON = 0x0030;
+    TMR3 = 0;
+    PR3 = (FCY / ADC1_TRIGGER_PRESCALER) / rateHz - 1;
+
+    // CH0..CH3 sample simultaneously, no scanning
+    AD1CON2bits.CSCNA = 0;
+    AD1CON2bits.CHPS = ADC1_CONVERSION_CHANNELS_CH0123;
+    AD1CHS0bits.CH0SA = ADC1_CH0_INPUT;
+    AD1CHS123bits.CH123SA = 0;
+    AD1CON1bits.SIMSAM = 1;
+
+    // Sampling restarts after each sequence, the Timer3 match ends it and
+    // starts converting CH0..CH3
+    AD1CON1bits.SSRCG = 0;
+    AD1CON1bits.SSRC = ADC1_SAMPLING_SOURCE_TMR3;
+    AD1CON1bits.ASAM = 1;
+
+    // Every result goes through ADC1BUF0 to DMA in conversion order
+    AD1CON1bits.ADDMABM = 1;
+    AD1CON2bits.SMPI = ADC1_RESULT_SLOTS - 1;
+    AD1CON4bits.ADDMAEN = 1;
+    adc1_obj.intSample = AD1CON2bits.SMPI;
+    IEC0bits.AD1IE = 0;
+
+    // DMA2: ADC1BUF0 to RAM, word, post-increment, continuous ping-pong,
+    // one block per ADC1_OVERSAMPLE triggers into each half in turn
+    DMA2CONbits.CHEN = 0;
+    DMA2CON = 0x0002;
+    DMA2REQ = ADC1_DMA_IRQ;
+    DMA2PAD = (volatile unsigned int)&ADC1BUF0;
+    DMA2STAL = (unsigned int)adc1_dma_buffer[0];
+    DMA2STAH = 0;
+    DMA2STBL = (unsigned int)adc1_dma_buffer[1];
+    DMA2STBH = 0;
+    DMA2CNT = ADC1_OVERSAMPLE * ADC1_RESULT_SLOTS - 1;
+    IFS1bits.DMA2IF = 0;
+    IEC1bits.DMA2IE = 1;
+    DMA2CONbits.CHEN = 1;
+
+    AD1CON1bits.ADON = 1;
+    T3CONbits.TON = 1;
+}
+
+void ADC1_TriggeredAcquisitionStop(void)
+{
+    T3CONbits.TON = 0;
+    AD1CON1bits.ASAM = 0;
+    DMA2CONbits.CHEN = 0;
+    IEC1bits.DMA2IE = 0;
+}
+
+bool ADC1_TriggeredAcquisitionHold(void)
+{
+    if (!T3CONbits.TON)
+    {
+        return false;
+    }
+
+    T3CONbits.TON = 0;
+
+    // Auto-sampling starts again once the last channel is converted
+    while (!AD1CON1bits.SAMP);
+
+    return true;
+}
+
+void ADC1_TriggeredAcquisitionResume(void)
+{
+    T3CONbits.TON = 1;
+}
+
+uint16_t ADC1_SampleCountGet(void)
+{
+    return adc1_count;
+}
+
+uint16_t ADC1_ResultGet(uint8_t slot)
+{
+    // 16 bit reads are atomic, no need to mask the interrupt
+    return (slot < ADC1_RESULT_SLOTS) ? adc1_results[slot] : 0;
+}
+
+uint16_t ADC1_SnapshotGet(uint16_t *results)
+{
+    uint16_t count;
+    uint8_t i;
+
+    do
+    {
+        count = adc1_count;
+
+        for (i = 0; i < ADC1_RESULT_SLOTS; i++)
+        {
+            results[i] = adc1_results[i];
+        }
+    } while (count != adc1_count);
+
+    return count;
+}
+
+void __attribute__ ( ( interrupt, no_auto_psv ) ) _DMA2Interrupt ( void )
+{
+    uint16_t sum[ADC1_RESULT_SLOTS] = {0};
+    uint8_t half;
+    uint8_t n;
+    uint8_t i;
+
+    // The channel has moved on to the other half, PPST2 set means it now
+    // fills B so A is the one complete
+    half = DMAPPSbits.PPST2 ? 0 : 1;
+
+    // Sum the triggers of each input (at most 64 x 1023, fits 16 bits) and
+    // drop the bits that are only noise
+    for (n = 0; n < ADC1_OVERSAMPLE; n++)
+    {
+        for (i = 0; i < ADC1_RESULT_SLOTS; i++)
+        {
+            sum[i] += adc1_dma_buffer[half][n][i];
+        }
+    }
+
+    for (i = 0; i < ADC1_RESULT_SLOTS; i++)
+    {
+        adc1_results[i] = sum[i] >> ADC1_OVERSAMPLE_BITS;
+    }
+    adc1_count++;
+
+    IFS1bits.DMA2IF = 0;
+}
+
 
 
 /**
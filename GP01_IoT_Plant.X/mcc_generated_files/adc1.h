@@ -64,6 +64,37 @@
 
 #define ADC1_ISR_FUNCTION_HEADER    void __attribute__((interrupt, no_auto_psv)) _AD1Interrupt
 
+/**
+  Section: Triggered Acquisition
+*/
+
+// Results kept per trigger, in conversion order CH0, CH1, CH2, CH3
+#define ADC1_RESULT_SLOTS           4
+
+// Inputs sampled together on every trigger, CH0 takes ADC1_CH0_INPUT and
+// CH1..CH3 take AN0..AN2 (CH123SA = 0)
+#define ADC1_CH0_INPUT              ADC1_CHANNEL_AN3
+
+// Slot of each input in a snapshot
+#define ADC1_SLOT_AN3               0
+#define ADC1_SLOT_AN0               1
+#define ADC1_SLOT_AN1               2
+#define ADC1_SLOT_AN2               3
+
+// DMA channel request source: ADC1 convert done
+#define ADC1_DMA_IRQ                0x0D
+
+// Extra bits of resolution by oversampling and decimation, 0 to 3. Each
+// result is the sum of 4^n triggers shifted right by n, 10 + n bits wide
+#ifndef ADC1_OVERSAMPLE_BITS
+#define ADC1_OVERSAMPLE_BITS        2
+#endif
+#define ADC1_OVERSAMPLE             (1 << (2 * ADC1_OVERSAMPLE_BITS))
+#define ADC1_RESULT_BITS            (10 + ADC1_OVERSAMPLE_BITS)
+
+// Timer3 prescaler used for the conversion trigger
+#define ADC1_TRIGGER_PRESCALER      256
+
 /**
   Section: Data Types
 */
@@ -83,6 +114,8 @@ typedef enum
 {
     ADC1_CHANNEL_AN0 =  0x0,
     ADC1_CHANNEL_AN1 =  0x1,
+    ADC1_CHANNEL_AN2 =  0x2,
+    ADC1_CHANNEL_AN3 =  0x3,
     ADC1_CHANNEL_CTMU_TEMP =  0x1E,
     ADC1_CHANNEL_CTMU =  0x1F,
     ADC1_MAX_CHANNEL_COUNT = 4
@@ -972,6 +1005,183 @@ inline static void ADC1_InterruptPrioritySet( uint16_t priorityValue )
 */
 void ADC1_Tasks(void);
 
+/**
+  @Summary
+    Starts hardware triggered acquisition
+
+  @Description
+    This routine makes Timer3 the conversion trigger with automatic sampling.
+    Every Timer3 period match samples AN0..AN3 at the same instant on
+    CH0..CH3 and converts them in sequence without the CPU. DMA channel 2
+    collects ADC1_OVERSAMPLE triggers into one half of a ping-pong buffer
+    while its interrupt sums the other half and decimates it to
+    ADC1_RESULT_BITS wide results, published as one snapshot, read with
+    ADC1_SnapshotGet() or ADC1_ResultGet(), and advances
+    ADC1_SampleCountGet(). Snapshots arrive at rateHz divided by
+    ADC1_OVERSAMPLE.
+
+  @Preconditions
+    ADC1_Initialize() and INTERRUPT_Initialize() should have been called.
+
+  @Param
+    Trigger rate in Hz, 2 to 65535.
+
+  @Returns
+    None
+
+  @Example
+    <code>
+    ADC1_TriggeredAcquisitionStart(64);
+    </code>
+*/
+
+void ADC1_TriggeredAcquisitionStart(uint16_t rateHz);
+
+/**
+  @Summary
+    Stops hardware triggered acquisition
+
+  @Description
+    This routine stops Timer3 and the DMA channel, the last snapshot stays
+    readable.
+
+  @Preconditions
+    None
+
+  @Param
+    None.
+
+  @Returns
+    None
+*/
+
+void ADC1_TriggeredAcquisitionStop(void);
+
+/**
+  @Summary
+    Holds the triggers before the device enters Sleep
+
+  @Description
+    This routine stops Timer3 and waits until a sequence that is being
+    converted has finished. Sleep stops the ADC clock and would abort it,
+    leaving the DMA results out of slot order. Does nothing unless Timer3
+    is triggering conversions.
+
+  @Preconditions
+    None
+
+  @Param
+    None.
+
+  @Returns
+    true if the triggers were held and have to be resumed
+
+  @Example
+    <code>
+    held = ADC1_TriggeredAcquisitionHold();
+    Sleep();
+    if (held) ADC1_TriggeredAcquisitionResume();
+    </code>
+*/
+
+bool ADC1_TriggeredAcquisitionHold(void);
+
+/**
+  @Summary
+    Restarts the triggers held by ADC1_TriggeredAcquisitionHold()
+
+  @Description
+    This routine starts Timer3 again, sampling continues where it stopped.
+
+  @Preconditions
+    ADC1_TriggeredAcquisitionHold() returned true
+
+  @Param
+    None.
+
+  @Returns
+    None
+*/
+
+void ADC1_TriggeredAcquisitionResume(void);
+
+/**
+  @Summary
+    Returns the number of snapshots published
+
+  @Description
+    This routine returns a counter advanced once per snapshot, that is once
+    every ADC1_OVERSAMPLE triggers, not per trigger. It wraps at 65536,
+    compare values with != or unsigned subtraction to find out whether a
+    newer result is available.
+
+  @Preconditions
+    ADC1_TriggeredAcquisitionStart() should have been called.
+
+  @Param
+    None.
+
+  @Returns
+    Snapshot counter.
+
+  @Example
+    <code>
+    uint16_t seen = ADC1_SampleCountGet();
+    // ... later, without waiting
+    if (ADC1_SampleCountGet() != seen)
+    {
+        light = ADC1_ResultGet(ADC1_SLOT_AN0);
+    }
+    </code>
+*/
+
+uint16_t ADC1_SampleCountGet(void);
+
+/**
+  @Summary
+    Returns the latest triggered conversion of a channel
+
+  @Description
+    This routine returns one input of the latest snapshot.
+
+  @Preconditions
+    ADC1_TriggeredAcquisitionStart() should have been called.
+
+  @Param
+    Slot, ADC1_SLOT_ANx.
+
+  @Returns
+    Decimated result, ADC1_RESULT_BITS wide.
+*/
+
+uint16_t ADC1_ResultGet(uint8_t slot);
+
+/**
+  @Summary
+    Copies the latest snapshot
+
+  @Description
+    This routine copies all inputs of the latest snapshot, taken by the same
+    trigger, re-reading if a new snapshot arrives while copying.
+
+  @Preconditions
+    ADC1_TriggeredAcquisitionStart() should have been called.
+
+  @Param
+    Destination of ADC1_RESULT_SLOTS results, indexed by ADC1_SLOT_ANx.
+
+  @Returns
+    Sample count of the snapshot.
+
+  @Example
+    <code>
+    uint16_t snap[ADC1_RESULT_SLOTS];
+    ADC1_SnapshotGet(snap);
+    </code>
+*/
+
+uint16_t ADC1_SnapshotGet(uint16_t *results);
+
         
 #ifdef __cplusplus  // Provide C++ Compatibility
 
@@ -44,6 +44,7 @@
 */
 
 #include "i2c1.h"
+#include "../PIC24_PIC33_I2C.h"
 
 /**
  Section: Data Types
@@ -203,10 +204,12 @@ void I2C1_Initialize(void)
     i2c1_object.i2cErrors = 0;
     
     // initialize the hardware
-    // Baud Rate Generator Value: I2CBRG 76;   
-    I2C1BRG = 0x4C;
+    // Baud Rate Generator Value: computed from FCY for I2C1_DEFAULT_SPEED,
+    // 100 kHz on purpose (the generated 0x4C was 400 kHz)
+    I2C1BRG = I2C_BRG(I2C1_DEFAULT_SPEED);
     // ACKEN disabled; STREN disabled; GCEN disabled; SMEN disabled; DISSLW enabled; I2CSIDL disabled; ACKDT Sends ACK; SCLREL Holds; RSEN disabled; IPMIEN disabled; A10M 7 Bit; PEN disabled; RCEN disabled; SEN disabled; I2CEN enabled; 
     I2C1CON = 0x8000;
+    I2C1CONbits.DISSLW = I2C_DISSLW(I2C1_DEFAULT_SPEED);
     // P disabled; S disabled; BCL disabled; I2COV disabled; IWCOL disabled; 
     I2C1STAT = 0x0;
 
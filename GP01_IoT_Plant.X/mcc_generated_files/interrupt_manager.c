@@ -61,5 +61,11 @@ void INTERRUPT_Initialize (void)
     //    TI: Timer 1
     //    Priority: 1
         IPC0bits.T1IP = 1;
+    //    DMA2I: DMA Channel 2 (ADC1 snapshots)
+    //    Priority: 2
+        IPC6bits.DMA2IP = 2;
+    //    ADI: ADC1 Convert Done (interrupt mode of adc.c)
+    //    Priority: 2
+        IPC3bits.AD1IP = 2;
 }
 
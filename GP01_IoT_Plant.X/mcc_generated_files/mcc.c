@@ -54,8 +54,8 @@
 #pragma config WDTWIN = WIN25    // Watchdog Window Select bits->WDT Window is 25% of WDT period
 
 // FWDT
-#pragma config WDTPOST = PS32768    // Watchdog Timer Postscaler bits->1:32768
-#pragma config WDTPRE = PR128    // Watchdog Timer Prescaler bit->1:128
+#pragma config WDTPOST = PS128    // Watchdog Timer Postscaler bits->1:128
+#pragma config WDTPRE = PR32    // Watchdog Timer Prescaler bit->1:32
 #pragma config PLLKEN = ON    // PLL Lock Enable bit->Clock switch to PLL source will wait until the PLL lock signal is valid.
 #pragma config WINDIS = OFF    // Watchdog Timer Window Enable bit->Watchdog Timer in Non-Window mode
 #pragma config FWDTEN = OFF    // Watchdog Timer Enable bit->Watchdog timer enabled/disabled by user software
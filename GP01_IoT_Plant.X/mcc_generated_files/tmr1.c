@@ -52,6 +52,7 @@
 #include "../IoT_Plant_Specific.h"
 #include "../dsPIC33_STD.h"
 #include "../mcc_generated_files/mcc.h"
+#include "../Event_Queue.h"
 /**
   Section: Data Type Definitions
 */
@@ -75,6 +76,10 @@ typedef struct _TMR_OBJ_STRUCT
     bool                                                    timerElapsed;
     /*Software Counter value*/
     uint8_t                                                 count;
+    /*Timer ticks accumulated at each period match*/
+    volatile uint32_t                                       ticks;
+    /*Timer ticks not yet counted as a 0.3 s tick*/
+    uint32_t                                                tickCounts;
 
 } TMR_OBJ;
 
@@ -90,7 +95,7 @@ void TMR1_Initialize (void)
     //TMR1 0; 
     TMR1 = 0x0;
     //Period = 0.3000020273 s; Frequency = 32013437 Hz; PR1 37516; 
-    PR1 = 0x928C;
+    PR1 = TMR1_TICK_COUNTS - 1;
     //TCKPS 1:256; TON enabled; TSIDL disabled; TCS FOSC/2; TSYNC disabled; TGATE disabled; 
     T1CON = 0x8030;
 
@@ -103,11 +108,34 @@ void TMR1_Initialize (void)
 }
 
 
-volatile extern uint16_t msCount;
-volatile extern bool check_soil;
+static void TMR1_TickCount(uint32_t counts)
+{
+    tmr1_obj.tickCounts += counts;
+
+    // The period varies after TMR1_WakeSet() and TMR1 stops in Sleep,
+    // so msCount goes up once per 0.3 s of time rather than per interrupt
+    while (tmr1_obj.tickCounts >= TMR1_TICK_COUNTS)
+    {
+        tmr1_obj.tickCounts -= TMR1_TICK_COUNTS;
+        msCount++;
+
+        // 7 200 000 ms = 2 hours
+        // then msCount = 7 200 000 / 300
+        // msCount = 24 000
+        // the soil check itself runs from the main loop
+        if (msCount == 24000)
+        {
+            msCount = 0;
+            Event_Post(EVENT_SOIL_CHECK, 0);
+        }
+    }
+}
 
 void __attribute__ ( ( interrupt, no_auto_psv ) ) _T1Interrupt (  )
 {
+    /* Period that has just ended */
+    uint32_t period = (uint32_t)PR1 + 1;
+
     /* Check if the Timer Interrupt/Status is set */
 
     //***User Area Begin
@@ -117,19 +145,12 @@ void __attribute__ ( ( interrupt, no_auto_psv ) ) _T1Interrupt (  )
     TMR1_CallBack();
 
     //***User Area End
-    msCount++;
-    
-    // 7 200 000 ms = 2 hours
-    // then msCount = 7 200 000 / 300
-    // msCount = 24 000
-    if (msCount == 24000)
-    {
-        msCount = 0;
-        POWER_PIN = ON;
-        __delay_ms(1000);
-        check_soil = true;
-    }
 
+    // Back to the 0.3 s tick after a TMR1_WakeSet()
+    PR1 = TMR1_TICK_COUNTS - 1;
+
+    tmr1_obj.ticks += period;
+    TMR1_TickCount(period);
     tmr1_obj.count++;
     tmr1_obj.timerElapsed = true;
     IFS0bits.T1IF = false;
@@ -212,6 +233,59 @@ void TMR1_SoftwareCounterClear(void)
     tmr1_obj.count = 0; 
 }
 
+uint32_t TMR1_TimestampGet(void)
+{
+    uint32_t ticks;
+    uint16_t counter;
+
+    // Re-read if the period ISR updated the tick count in between
+    do
+    {
+        ticks = tmr1_obj.ticks;
+        counter = TMR1;
+    } while (ticks != tmr1_obj.ticks);
+
+    // Counter wrapped but the ISR has not run yet (interrupts masked)
+    if (IFS0bits.T1IF && (counter < (PR1 >> 1)))
+    {
+        ticks += (uint32_t)PR1 + 1;
+    }
+
+    return ticks + counter;
+}
+
+void TMR1_WakeSet(uint32_t counts)
+{
+    uint32_t match;
+
+    if (counts < TMR1_WAKE_MIN_COUNTS)
+    {
+        counts = TMR1_WAKE_MIN_COUNTS;
+    }
+
+    INTERRUPT_GlobalDisable();
+
+    // The ISR accounts the period that has ended with PR1, leave it alone
+    // until then
+    if (!IFS0bits.T1IF)
+    {
+        match = (uint32_t)TMR1 + counts - 1;
+        PR1 = (match > 0xFFFF) ? 0xFFFF : match;
+    }
+
+    INTERRUPT_GlobalEnable();
+}
+
+void TMR1_TimestampAdvance(uint32_t counts)
+{
+    INTERRUPT_GlobalDisable();
+
+    tmr1_obj.ticks += counts;
+    TMR1_TickCount(counts);
+
+    INTERRUPT_GlobalEnable();
+}
+
 /**
  End of File
 */
@@ -61,6 +61,15 @@
 
 #define TMR1_INTERRUPT_TICKER_FACTOR    1
 
+/* TMR1 runs from FOSC/2 through the 1:256 prescaler */
+#define TMR1_TIMESTAMP_PRESCALER        256
+
+/* Counts in one 0.3 s tick, PR1 + 1 */
+#define TMR1_TICK_COUNTS                37517UL
+
+/* Fewest counts TMR1_WakeSet() moves the interrupt to */
+#define TMR1_WAKE_MIN_COUNTS            16
+
 /**
   Section: Interface Routines
 */
@@ -315,6 +324,82 @@ int TMR1_SoftwareCounterGet(void);
 
 void TMR1_SoftwareCounterClear(void);
 
+/**
+  @Summary
+    Returns a free running 32-bit timestamp.
+
+  @Description
+    This routine returns the number of TMR1 counts elapsed since
+    TMR1_Initialize(), i.e. the period ticks accumulated by the ISR plus the
+    current counter value. One count is TMR1_TIMESTAMP_PRESCALER instruction
+    cycles. The value wraps modulo 2^32, so use unsigned subtraction to
+    compute intervals.
+
+  @Param
+    None.
+
+  @Returns
+    Timestamp in TMR1 counts.
+ 
+  @Example 
+    <code>
+    uint32_t start = TMR1_TimestampGet();
+    // ... work ...
+    uint32_t elapsed = TMR1_TimestampGet() - start;
+    </code>
+*/
+
+uint32_t TMR1_TimestampGet(void);
+
+/**
+  @Summary
+    Moves the next period interrupt to wake the CPU.
+
+  @Description
+    This routine sets the period that is running so that it ends counts
+    from now, at most at 0xFFFF and at least TMR1_WAKE_MIN_COUNTS away. The
+    ISR goes back to the 0.3 s tick after it. The timestamp and the tick
+    count are not affected. Nothing is changed when the period has already
+    ended and its interrupt is pending.
+
+  @Param
+    counts - TMR1 counts until the interrupt.
+
+  @Returns
+    None
+ 
+  @Example 
+    <code>
+    TMR1_WakeSet(Scheduler_NextDue());
+    Idle();
+    </code>
+*/
+
+void TMR1_WakeSet(uint32_t counts);
+
+/**
+  @Summary
+    Adds time during which TMR1 was stopped.
+
+  @Description
+    This routine moves the timestamp on by counts and counts the 0.3 s
+    ticks they hold, for time spent in Sleep where TMR1 does not run.
+
+  @Param
+    counts - TMR1 counts to add.
+
+  @Returns
+    None
+ 
+  @Example 
+    <code>
+    Sleep();
+    TMR1_TimestampAdvance(slept);
+    </code>
+*/
+
+void TMR1_TimestampAdvance(uint32_t counts);
+
 #ifdef __cplusplus  // Provide C++ Compatibility
 
     }
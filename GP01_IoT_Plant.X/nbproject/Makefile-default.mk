@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=mcc_generated_files/mcc.c mcc_generated_files/interrupt_manager.c mcc_generated_files/traps.c mcc_generated_files/pin_manager.c mcc_generated_files/i2c1.c mcc_generated_files/adc1.c mcc_generated_files/spi2.c mcc_generated_files/uart1.c mcc_generated_files/tmr1.c main.c SSD1306_OLED.c PIC24_33_I2C.c PIC24_33_I2C2.c
+SOURCEFILES_QUOTED_IF_SPACED=mcc_generated_files/mcc.c mcc_generated_files/interrupt_manager.c mcc_generated_files/traps.c mcc_generated_files/pin_manager.c mcc_generated_files/i2c1.c mcc_generated_files/adc1.c mcc_generated_files/spi2.c mcc_generated_files/uart1.c mcc_generated_files/tmr1.c main.c SSD1306_OLED.c PIC24_33_I2C.c PIC24_33_I2C2.c Bus_Trace.c EEPROM_Log.c I2C_Bus.c DS1722.c SPI_Bus.c SPI2_DMA.c Flash_Log.c DSP_Filter.c Lux_Cal.c Classifier.c adc.c Moisture_Probe.c Battery.c Event_Queue.c Scheduler.c Low_Power.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/mcc_generated_files/mcc.o ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o ${OBJECTDIR}/mcc_generated_files/traps.o ${OBJECTDIR}/mcc_generated_files/pin_manager.o ${OBJECTDIR}/mcc_generated_files/i2c1.o ${OBJECTDIR}/mcc_generated_files/adc1.o ${OBJECTDIR}/mcc_generated_files/spi2.o ${OBJECTDIR}/mcc_generated_files/uart1.o ${OBJECTDIR}/mcc_generated_files/tmr1.o ${OBJECTDIR}/main.o ${OBJECTDIR}/SSD1306_OLED.o ${OBJECTDIR}/PIC24_33_I2C.o ${OBJECTDIR}/PIC24_33_I2C2.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/mcc_generated_files/mcc.o.d ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d ${OBJECTDIR}/mcc_generated_files/traps.o.d ${OBJECTDIR}/mcc_generated_files/pin_manager.o.d ${OBJECTDIR}/mcc_generated_files/i2c1.o.d ${OBJECTDIR}/mcc_generated_files/adc1.o.d ${OBJECTDIR}/mcc_generated_files/spi2.o.d ${OBJECTDIR}/mcc_generated_files/uart1.o.d ${OBJECTDIR}/mcc_generated_files/tmr1.o.d ${OBJECTDIR}/main.o.d ${OBJECTDIR}/SSD1306_OLED.o.d ${OBJECTDIR}/PIC24_33_I2C.o.d ${OBJECTDIR}/PIC24_33_I2C2.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/mcc_generated_files/mcc.o ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o ${OBJECTDIR}/mcc_generated_files/traps.o ${OBJECTDIR}/mcc_generated_files/pin_manager.o ${OBJECTDIR}/mcc_generated_files/i2c1.o ${OBJECTDIR}/mcc_generated_files/adc1.o ${OBJECTDIR}/mcc_generated_files/spi2.o ${OBJECTDIR}/mcc_generated_files/uart1.o ${OBJECTDIR}/mcc_generated_files/tmr1.o ${OBJECTDIR}/main.o ${OBJECTDIR}/SSD1306_OLED.o ${OBJECTDIR}/PIC24_33_I2C.o ${OBJECTDIR}/PIC24_33_I2C2.o ${OBJECTDIR}/Bus_Trace.o ${OBJECTDIR}/EEPROM_Log.o ${OBJECTDIR}/I2C_Bus.o ${OBJECTDIR}/DS1722.o ${OBJECTDIR}/SPI_Bus.o ${OBJECTDIR}/SPI2_DMA.o ${OBJECTDIR}/Flash_Log.o ${OBJECTDIR}/DSP_Filter.o ${OBJECTDIR}/Lux_Cal.o ${OBJECTDIR}/Classifier.o ${OBJECTDIR}/adc.o ${OBJECTDIR}/Moisture_Probe.o ${OBJECTDIR}/Battery.o ${OBJECTDIR}/Event_Queue.o ${OBJECTDIR}/Scheduler.o ${OBJECTDIR}/Low_Power.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/mcc_generated_files/mcc.o.d ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o.d ${OBJECTDIR}/mcc_generated_files/traps.o.d ${OBJECTDIR}/mcc_generated_files/pin_manager.o.d ${OBJECTDIR}/mcc_generated_files/i2c1.o.d ${OBJECTDIR}/mcc_generated_files/adc1.o.d ${OBJECTDIR}/mcc_generated_files/spi2.o.d ${OBJECTDIR}/mcc_generated_files/uart1.o.d ${OBJECTDIR}/mcc_generated_files/tmr1.o.d ${OBJECTDIR}/main.o.d ${OBJECTDIR}/SSD1306_OLED.o.d ${OBJECTDIR}/PIC24_33_I2C.o.d ${OBJECTDIR}/PIC24_33_I2C2.o.d ${OBJECTDIR}/Bus_Trace.o.d ${OBJECTDIR}/EEPROM_Log.o.d ${OBJECTDIR}/I2C_Bus.o.d ${OBJECTDIR}/DS1722.o.d ${OBJECTDIR}/SPI_Bus.o.d ${OBJECTDIR}/SPI2_DMA.o.d ${OBJECTDIR}/Flash_Log.o.d ${OBJECTDIR}/DSP_Filter.o.d ${OBJECTDIR}/Lux_Cal.o.d ${OBJECTDIR}/Classifier.o.d ${OBJECTDIR}/adc.o.d ${OBJECTDIR}/Moisture_Probe.o.d ${OBJECTDIR}/Battery.o.d ${OBJECTDIR}/Event_Queue.o.d ${OBJECTDIR}/Scheduler.o.d ${OBJECTDIR}/Low_Power.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/mcc_generated_files/mcc.o ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o ${OBJECTDIR}/mcc_generated_files/traps.o ${OBJECTDIR}/mcc_generated_files/pin_manager.o ${OBJECTDIR}/mcc_generated_files/i2c1.o ${OBJECTDIR}/mcc_generated_files/adc1.o ${OBJECTDIR}/mcc_generated_files/spi2.o ${OBJECTDIR}/mcc_generated_files/uart1.o ${OBJECTDIR}/mcc_generated_files/tmr1.o ${OBJECTDIR}/main.o ${OBJECTDIR}/SSD1306_OLED.o ${OBJECTDIR}/PIC24_33_I2C.o ${OBJECTDIR}/PIC24_33_I2C2.o
+OBJECTFILES=${OBJECTDIR}/mcc_generated_files/mcc.o ${OBJECTDIR}/mcc_generated_files/interrupt_manager.o ${OBJECTDIR}/mcc_generated_files/traps.o ${OBJECTDIR}/mcc_generated_files/pin_manager.o ${OBJECTDIR}/mcc_generated_files/i2c1.o ${OBJECTDIR}/mcc_generated_files/adc1.o ${OBJECTDIR}/mcc_generated_files/spi2.o ${OBJECTDIR}/mcc_generated_files/uart1.o ${OBJECTDIR}/mcc_generated_files/tmr1.o ${OBJECTDIR}/main.o ${OBJECTDIR}/SSD1306_OLED.o ${OBJECTDIR}/PIC24_33_I2C.o ${OBJECTDIR}/PIC24_33_I2C2.o ${OBJECTDIR}/Bus_Trace.o ${OBJECTDIR}/EEPROM_Log.o ${OBJECTDIR}/I2C_Bus.o ${OBJECTDIR}/DS1722.o ${OBJECTDIR}/SPI_Bus.o ${OBJECTDIR}/SPI2_DMA.o ${OBJECTDIR}/Flash_Log.o ${OBJECTDIR}/DSP_Filter.o ${OBJECTDIR}/Lux_Cal.o ${OBJECTDIR}/Classifier.o ${OBJECTDIR}/adc.o ${OBJECTDIR}/Moisture_Probe.o ${OBJECTDIR}/Battery.o ${OBJECTDIR}/Event_Queue.o ${OBJECTDIR}/Scheduler.o ${OBJECTDIR}/Low_Power.o
 
 # Source Files
-SOURCEFILES=mcc_generated_files/mcc.c mcc_generated_files/interrupt_manager.c mcc_generated_files/traps.c mcc_generated_files/pin_manager.c mcc_generated_files/i2c1.c mcc_generated_files/adc1.c mcc_generated_files/spi2.c mcc_generated_files/uart1.c mcc_generated_files/tmr1.c main.c SSD1306_OLED.c PIC24_33_I2C.c PIC24_33_I2C2.c
+SOURCEFILES=mcc_generated_files/mcc.c mcc_generated_files/interrupt_manager.c mcc_generated_files/traps.c mcc_generated_files/pin_manager.c mcc_generated_files/i2c1.c mcc_generated_files/adc1.c mcc_generated_files/spi2.c mcc_generated_files/uart1.c mcc_generated_files/tmr1.c main.c SSD1306_OLED.c PIC24_33_I2C.c PIC24_33_I2C2.c Bus_Trace.c EEPROM_Log.c I2C_Bus.c DS1722.c SPI_Bus.c SPI2_DMA.c Flash_Log.c DSP_Filter.c Lux_Cal.c Classifier.c adc.c Moisture_Probe.c Battery.c Event_Queue.c Scheduler.c Low_Power.c
 
 
 CFLAGS=
@@ -185,6 +185,118 @@ ${OBJECTDIR}/PIC24_33_I2C2.o: PIC24_33_I2C2.c  nbproject/Makefile-${CND_CONF}.mk
 	${MP_CC} $(MP_EXTRA_CC_PRE)  PIC24_33_I2C2.c  -o ${OBJECTDIR}/PIC24_33_I2C2.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/PIC24_33_I2C2.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
 	@${FIXDEPS} "${OBJECTDIR}/PIC24_33_I2C2.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/Bus_Trace.o: Bus_Trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Bus_Trace.o.d 
+	@${RM} ${OBJECTDIR}/Bus_Trace.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Bus_Trace.c  -o ${OBJECTDIR}/Bus_Trace.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Bus_Trace.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Bus_Trace.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/EEPROM_Log.o: EEPROM_Log.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EEPROM_Log.o.d 
+	@${RM} ${OBJECTDIR}/EEPROM_Log.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  EEPROM_Log.c  -o ${OBJECTDIR}/EEPROM_Log.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/EEPROM_Log.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/EEPROM_Log.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/I2C_Bus.o: I2C_Bus.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/I2C_Bus.o.d 
+	@${RM} ${OBJECTDIR}/I2C_Bus.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  I2C_Bus.c  -o ${OBJECTDIR}/I2C_Bus.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/I2C_Bus.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/I2C_Bus.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/DS1722.o: DS1722.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/DS1722.o.d 
+	@${RM} ${OBJECTDIR}/DS1722.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  DS1722.c  -o ${OBJECTDIR}/DS1722.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/DS1722.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/DS1722.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/SPI_Bus.o: SPI_Bus.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SPI_Bus.o.d 
+	@${RM} ${OBJECTDIR}/SPI_Bus.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  SPI_Bus.c  -o ${OBJECTDIR}/SPI_Bus.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/SPI_Bus.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/SPI_Bus.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/SPI2_DMA.o: SPI2_DMA.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SPI2_DMA.o.d 
+	@${RM} ${OBJECTDIR}/SPI2_DMA.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  SPI2_DMA.c  -o ${OBJECTDIR}/SPI2_DMA.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/SPI2_DMA.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/SPI2_DMA.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Flash_Log.o: Flash_Log.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Flash_Log.o.d 
+	@${RM} ${OBJECTDIR}/Flash_Log.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Flash_Log.c  -o ${OBJECTDIR}/Flash_Log.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Flash_Log.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Flash_Log.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/DSP_Filter.o: DSP_Filter.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/DSP_Filter.o.d 
+	@${RM} ${OBJECTDIR}/DSP_Filter.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  DSP_Filter.c  -o ${OBJECTDIR}/DSP_Filter.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/DSP_Filter.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/DSP_Filter.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Lux_Cal.o: Lux_Cal.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Lux_Cal.o.d 
+	@${RM} ${OBJECTDIR}/Lux_Cal.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Lux_Cal.c  -o ${OBJECTDIR}/Lux_Cal.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Lux_Cal.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Lux_Cal.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Classifier.o: Classifier.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Classifier.o.d 
+	@${RM} ${OBJECTDIR}/Classifier.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Classifier.c  -o ${OBJECTDIR}/Classifier.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Classifier.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Classifier.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/adc.o: adc.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/adc.o.d 
+	@${RM} ${OBJECTDIR}/adc.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  adc.c  -o ${OBJECTDIR}/adc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/adc.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/adc.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Moisture_Probe.o: Moisture_Probe.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Moisture_Probe.o.d 
+	@${RM} ${OBJECTDIR}/Moisture_Probe.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Moisture_Probe.c  -o ${OBJECTDIR}/Moisture_Probe.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Moisture_Probe.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Moisture_Probe.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Battery.o: Battery.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Battery.o.d 
+	@${RM} ${OBJECTDIR}/Battery.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Battery.c  -o ${OBJECTDIR}/Battery.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Battery.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Battery.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Event_Queue.o: Event_Queue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Event_Queue.o.d 
+	@${RM} ${OBJECTDIR}/Event_Queue.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Event_Queue.c  -o ${OBJECTDIR}/Event_Queue.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Event_Queue.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Event_Queue.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Scheduler.o: Scheduler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Scheduler.o.d 
+	@${RM} ${OBJECTDIR}/Scheduler.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Scheduler.c  -o ${OBJECTDIR}/Scheduler.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Scheduler.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Scheduler.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Low_Power.o: Low_Power.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Low_Power.o.d 
+	@${RM} ${OBJECTDIR}/Low_Power.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Low_Power.c  -o ${OBJECTDIR}/Low_Power.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Low_Power.o.d"      -g -D__DEBUG -D__MPLAB_DEBUGGER_ICD3=1  -mno-eds-warn  -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Low_Power.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 else
 ${OBJECTDIR}/mcc_generated_files/mcc.o: mcc_generated_files/mcc.c  nbproject/Makefile-${CND_CONF}.mk
 	@${MKDIR} "${OBJECTDIR}/mcc_generated_files" 
@@ -277,6 +389,118 @@ ${OBJECTDIR}/PIC24_33_I2C2.o: PIC24_33_I2C2.c  nbproject/Makefile-${CND_CONF}.mk
 	${MP_CC} $(MP_EXTRA_CC_PRE)  PIC24_33_I2C2.c  -o ${OBJECTDIR}/PIC24_33_I2C2.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/PIC24_33_I2C2.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
 	@${FIXDEPS} "${OBJECTDIR}/PIC24_33_I2C2.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
 	
+${OBJECTDIR}/Bus_Trace.o: Bus_Trace.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Bus_Trace.o.d 
+	@${RM} ${OBJECTDIR}/Bus_Trace.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Bus_Trace.c  -o ${OBJECTDIR}/Bus_Trace.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Bus_Trace.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Bus_Trace.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/EEPROM_Log.o: EEPROM_Log.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/EEPROM_Log.o.d 
+	@${RM} ${OBJECTDIR}/EEPROM_Log.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  EEPROM_Log.c  -o ${OBJECTDIR}/EEPROM_Log.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/EEPROM_Log.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/EEPROM_Log.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/I2C_Bus.o: I2C_Bus.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/I2C_Bus.o.d 
+	@${RM} ${OBJECTDIR}/I2C_Bus.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  I2C_Bus.c  -o ${OBJECTDIR}/I2C_Bus.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/I2C_Bus.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/I2C_Bus.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/DS1722.o: DS1722.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/DS1722.o.d 
+	@${RM} ${OBJECTDIR}/DS1722.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  DS1722.c  -o ${OBJECTDIR}/DS1722.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/DS1722.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/DS1722.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/SPI_Bus.o: SPI_Bus.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SPI_Bus.o.d 
+	@${RM} ${OBJECTDIR}/SPI_Bus.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  SPI_Bus.c  -o ${OBJECTDIR}/SPI_Bus.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/SPI_Bus.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/SPI_Bus.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/SPI2_DMA.o: SPI2_DMA.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/SPI2_DMA.o.d 
+	@${RM} ${OBJECTDIR}/SPI2_DMA.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  SPI2_DMA.c  -o ${OBJECTDIR}/SPI2_DMA.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/SPI2_DMA.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/SPI2_DMA.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Flash_Log.o: Flash_Log.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Flash_Log.o.d 
+	@${RM} ${OBJECTDIR}/Flash_Log.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Flash_Log.c  -o ${OBJECTDIR}/Flash_Log.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Flash_Log.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Flash_Log.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/DSP_Filter.o: DSP_Filter.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/DSP_Filter.o.d 
+	@${RM} ${OBJECTDIR}/DSP_Filter.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  DSP_Filter.c  -o ${OBJECTDIR}/DSP_Filter.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/DSP_Filter.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/DSP_Filter.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Lux_Cal.o: Lux_Cal.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Lux_Cal.o.d 
+	@${RM} ${OBJECTDIR}/Lux_Cal.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Lux_Cal.c  -o ${OBJECTDIR}/Lux_Cal.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Lux_Cal.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Lux_Cal.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Classifier.o: Classifier.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Classifier.o.d 
+	@${RM} ${OBJECTDIR}/Classifier.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Classifier.c  -o ${OBJECTDIR}/Classifier.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Classifier.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Classifier.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/adc.o: adc.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/adc.o.d 
+	@${RM} ${OBJECTDIR}/adc.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  adc.c  -o ${OBJECTDIR}/adc.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/adc.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/adc.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Moisture_Probe.o: Moisture_Probe.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Moisture_Probe.o.d 
+	@${RM} ${OBJECTDIR}/Moisture_Probe.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Moisture_Probe.c  -o ${OBJECTDIR}/Moisture_Probe.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Moisture_Probe.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Moisture_Probe.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Battery.o: Battery.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Battery.o.d 
+	@${RM} ${OBJECTDIR}/Battery.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Battery.c  -o ${OBJECTDIR}/Battery.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Battery.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Battery.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Event_Queue.o: Event_Queue.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Event_Queue.o.d 
+	@${RM} ${OBJECTDIR}/Event_Queue.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Event_Queue.c  -o ${OBJECTDIR}/Event_Queue.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Event_Queue.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Event_Queue.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Scheduler.o: Scheduler.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Scheduler.o.d 
+	@${RM} ${OBJECTDIR}/Scheduler.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Scheduler.c  -o ${OBJECTDIR}/Scheduler.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Scheduler.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Scheduler.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
+${OBJECTDIR}/Low_Power.o: Low_Power.c  nbproject/Makefile-${CND_CONF}.mk
+	@${MKDIR} "${OBJECTDIR}" 
+	@${RM} ${OBJECTDIR}/Low_Power.o.d 
+	@${RM} ${OBJECTDIR}/Low_Power.o 
+	${MP_CC} $(MP_EXTRA_CC_PRE)  Low_Power.c  -o ${OBJECTDIR}/Low_Power.o  -c -mcpu=$(MP_PROCESSOR_OPTION)  -MMD -MF "${OBJECTDIR}/Low_Power.o.d"      -mno-eds-warn  -g -omf=elf -DXPRJ_default=$(CND_CONF)  -legacy-libc  $(COMPARISON_BUILD)  -O1 -msmart-io=1 -Wall -msfr-warn=off  
+	@${FIXDEPS} "${OBJECTDIR}/Low_Power.o.d" $(SILENT)  -rsi ${MP_CC_DIR}../ 
+	
 endif
 
 # ------------------------------------------------------------------------------------
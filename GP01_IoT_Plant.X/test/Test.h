@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * File: Test.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Minimal check macros for the host tests. A failed check
+ *                      prints its location and makes the test program exit non-
+ *                      zero.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+extern unsigned test_checks;
+extern unsigned test_failures;
+
+// Defines the counters, once per test program
+#define TEST_MAIN_DATA  unsigned test_checks, test_failures
+
+#define CHECK(cond)                                                     \
+    do                                                                  \
+    {                                                                   \
+        test_checks++;                                                  \
+        if (!(cond))                                                    \
+        {                                                               \
+            test_failures++;                                            \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__,     \
+                   #cond);                                              \
+        }                                                               \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                  \
+    do                                                                  \
+    {                                                                   \
+        long long test_a = (long long)(a), test_b = (long long)(b);     \
+        test_checks++;                                                  \
+        if (test_a != test_b)                                           \
+        {                                                               \
+            test_failures++;                                            \
+            printf("%s:%d: check failed: %s == %s (%lld != %lld)\n",    \
+                   __FILE__, __LINE__, #a, #b, test_a, test_b);         \
+        }                                                               \
+    } while (0)
+
+// Prints the summary, returns the exit status of the test program
+#define TEST_RESULT(name)                                               \
+    (printf("%s: %u checks, %u failed\n", name, test_checks,            \
+            test_failures), test_failures ? 1 : 0)
+
+#endif  // TEST_H
@@ -0,0 +1,702 @@
+/*******************************************************************************
+ * File: Test_Flash.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Host tests of the flash history. Runs Flash_Log
+ *                      unmodified over the SPI bus simulation and a file backed
+ *                      NOR flash model, checks recovery after power is cut at
+ *                      every byte around a sector change and during an erase,
+ *                      wrapping of the sector ring with erase ahead, time range
+ *                      queries and giving up on a flash that stays busy
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Flash_Log.h"
+#include "SPI_Bus.h"
+#include "SPI2_DMA.h"
+#include "Flash_Model.h"
+#include "Test.h"
+#include <string.h>
+
+// Simulated time in cycles
+#define TEST_MS(ms)     ((uint64_t)FCY * (ms) / 1000)
+
+// Backing file of the flash, in the build directory
+#define TEST_FILE       "Test_Flash.bin"
+
+// Samples a minute apart, an hour missing after every TEST_RUN of them
+#define TEST_T0         100000UL
+#define TEST_STEP       60
+#define TEST_RUN        1000
+#define TEST_GAP        3600
+#define TEST_RUN_TIME   ((TEST_RUN - 1) * TEST_STEP + TEST_STEP + TEST_GAP)
+
+TEST_MAIN_DATA;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static FLASH_MODEL flash;
+
+// The flash chip select with no descriptor of its own, to drain the queue
+static const SPI_DEVICE flash_pin =
+{
+    &FLASH_LOG_CS_LAT, FLASH_LOG_CS_MASK, false,
+    SPI_CON1(SPI_MODE0, SPI_PPRE_4, 1), 0
+};
+
+// Query results, checked against the samples as they arrive
+static uint32_t query_next;         // index expected next
+static uint32_t query_first;
+static uint32_t query_count;
+static uint32_t query_wrong;
+static uint32_t query_gap = UINT32_MAX;     // sample missing from the log
+
+/*******************************************************************************
+ * Function:        static void Test_Sample(uint32_t i, FlashLogSample *s)
+ *
+ * Overview:        Sample number i of the test series. Values wander with
+ *                  the odd large jump so every delta length gets used
+ ******************************************************************************/
+static void Test_Sample(uint32_t i, FlashLogSample *s)
+{
+    s->time = TEST_T0 + (i / TEST_RUN) * TEST_RUN_TIME +
+              (i % TEST_RUN) * TEST_STEP;
+    s->flags = FLASH_LOG_FLAG_LIGHT_GOOD;
+    if (i % 10 == 0)
+    {
+        s->flags |= FLASH_LOG_FLAG_MOISTURE_NEW;
+    }
+    if (i % TEST_RUN == 0)
+    {
+        s->flags |= FLASH_LOG_FLAG_BOOT;
+    }
+    s->light = 500 + (i * 37) % 300 + ((i % 97 == 0) ? 3000 : 0);
+    s->moisture = 2000 + (i % 50) * 3;
+    s->temperature = 20 * 256 + (int32_t)((i * 13) % 1500) - 750 -
+                     ((i % 211 == 0) ? 80 * 256 : 0);
+}
+
+/*******************************************************************************
+ * Function:        static uint32_t Test_Index(uint32_t time)
+ *
+ * Overview:        Index of the sample at a time of the series
+ ******************************************************************************/
+static uint32_t Test_Index(uint32_t time)
+{
+    uint32_t t = time - TEST_T0;
+
+    return (t / TEST_RUN_TIME) * TEST_RUN + (t % TEST_RUN_TIME) / TEST_STEP;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Collect(const FlashLogSample *sample)
+ *
+ * Overview:        Query callback, samples must be the series in order
+ ******************************************************************************/
+static void Test_Collect(const FlashLogSample *sample)
+{
+    FlashLogSample want;
+    uint32_t i = Test_Index(sample->time);
+
+    Test_Sample(i, &want);
+
+    if (query_count == 0)
+    {
+        query_first = i;
+    }
+    else if (i != query_next &&
+             !(query_next == query_gap && i == query_gap + 1))
+    {
+        query_wrong++;
+    }
+
+    if (sample->time != want.time || sample->flags != want.flags ||
+        sample->light != want.light || sample->moisture != want.moisture ||
+        sample->temperature != want.temperature)
+    {
+        query_wrong++;
+    }
+
+    query_next = i + 1;
+    query_count++;
+}
+
+/*******************************************************************************
+ * Function:        static uint32_t Test_Query(uint32_t from, uint32_t to)
+ *
+ * Overview:        Runs a query through Test_Collect()
+ ******************************************************************************/
+static uint32_t Test_Query(uint32_t from, uint32_t to)
+{
+    uint32_t n;
+
+    query_count = 0;
+    query_wrong = 0;
+
+    n = Flash_Log_Query(from, to, Test_Collect);
+
+    CHECK_EQ(n, query_count);
+    CHECK_EQ(query_wrong, 0);
+
+    return n;
+}
+
+/*******************************************************************************
+ * Function:        static uint32_t Test_Time(uint32_t i)
+ *
+ * Overview:        Time of sample i
+ ******************************************************************************/
+static uint32_t Test_Time(uint32_t i)
+{
+    FlashLogSample s;
+
+    Test_Sample(i, &s);
+
+    return s.time;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Idle(uint64_t cycles)
+ *
+ * Overview:        The main loop between samples, runs the SPI queue dry
+ *                  then lets time pass
+ ******************************************************************************/
+static void Test_Idle(uint64_t cycles)
+{
+    uint64_t end = Sim_Now() + cycles;
+
+    while (SPI_Bus_Tasks() || SPI2_DMA_IsBusy())
+    {
+        Nop();
+    }
+
+    if (Sim_Now() < end)
+    {
+        Sim_Delay(end - Sim_Now());
+    }
+}
+
+/*******************************************************************************
+ * Function:        static bool Test_Append(uint32_t i)
+ *
+ * Overview:        Logs sample i, then a minute of main loop
+ ******************************************************************************/
+static bool Test_Append(uint32_t i)
+{
+    FlashLogSample s;
+    bool ok;
+
+    Test_Sample(i, &s);
+    ok = Flash_Log_Append(&s);
+    Test_Idle(TEST_MS(1000) * TEST_STEP);
+
+    return ok;
+}
+
+/*******************************************************************************
+ * Function:        static bool Test_PowerUp(bool blank)
+ *
+ * Overview:        Powers the flash up from its file, erased if asked, and
+ *                  runs the boot recovery followed by a second of main loop,
+ *                  like the logo time at boot
+ ******************************************************************************/
+static bool Test_PowerUp(bool blank)
+{
+    bool ok;
+
+    CHECK(Flash_Model_Open(&flash, TEST_FILE, blank));
+    Sim_SPI_Attach(&flash.dev);
+    Sim_SPI_StatsReset();
+
+    ok = Flash_Log_Init();
+    Test_Idle(TEST_MS(1000));
+
+    return ok;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_PowerDown(void)
+ *
+ * Overview:        Cuts the power. Whatever the firmware still had queued
+ *                  goes to a flash that is already dead, as RAM is lost
+ ******************************************************************************/
+static void Test_PowerDown(void)
+{
+    static SPI_TRANSACTION drain;
+
+    Flash_Model_PowerFail(&flash);
+
+    drain.device = &flash_pin;
+    drain.tx = NULL;
+    drain.rx = NULL;
+    drain.length = 1;
+    drain.done = NULL;
+    SPI_Bus_Submit(&drain);
+    SPI_Bus_Wait(&drain);
+
+    Sim_SPI_Detach(&flash.dev);
+    Flash_Model_Close(&flash);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Errors(void)
+ *
+ * Overview:        Checks the flash was driven the way its datasheet asks
+ ******************************************************************************/
+static void Test_Errors(void)
+{
+    const SIM_SPI_STATS *s = Sim_SPI_Stats();
+
+    CHECK_EQ(flash.overwrites, 0);
+    CHECK_EQ(flash.busyCommands, 0);
+    CHECK_EQ(flash.unlatched, 0);
+    CHECK_EQ(s->modeErrors, 0);
+    CHECK_EQ(s->unselected, 0);
+    CHECK_EQ(s->overruns, 0);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Blank(void)
+ *
+ * Overview:        Logging from an erased part, over a power cycle. Appends
+ *                  never wait for the erase ahead
+ ******************************************************************************/
+static void Test_Blank(void)
+{
+    uint64_t start, worst = 0;
+    uint32_t i;
+
+    printf("Blank flash\n");
+
+    CHECK(Test_PowerUp(true));
+    CHECK_EQ(Flash_Log_LastTime(), 0);
+    CHECK_EQ(Test_Query(0, UINT32_MAX), 0);
+    CHECK_EQ(flash.erases, 1);
+
+    for (i = 0; i < 1500; i++)
+    {
+        FlashLogSample s;
+
+        Test_Sample(i, &s);
+        start = Sim_Now();
+        CHECK(Flash_Log_Append(&s));
+        if (Sim_Now() - start > worst)
+        {
+            worst = Sim_Now() - start;
+        }
+        Test_Idle(TEST_MS(1000) * TEST_STEP);
+    }
+
+    printf("  %u samples in %u sectors, %.1f bytes each, slowest append "
+           "%.1f us\n", (unsigned)i, (unsigned)flash.erases - 1,
+           (double)(flash.programBytes - 17 * (flash.erases - 1)) / i,
+           Sim_Microseconds(worst));
+
+    // Two page programs at most, never an erase
+    CHECK(worst < TEST_MS(3));
+    CHECK_EQ(Flash_Log_LastTime(), Test_Time(i - 1));
+    CHECK_EQ(Test_Query(0, UINT32_MAX), i);
+    CHECK_EQ(query_first, 0);
+    Test_Errors();
+
+    // Power cycle, the history and the delta base come back
+    Test_PowerDown();
+    CHECK(Test_PowerUp(false));
+    CHECK_EQ(Flash_Log_LastTime(), Test_Time(i - 1));
+
+    for (; i < 2000; i++)
+    {
+        CHECK(Test_Append(i));
+    }
+
+    CHECK_EQ(Test_Query(0, UINT32_MAX), 2000);
+    CHECK_EQ(query_first, 0);
+    Test_Errors();
+    Test_PowerDown();
+}
+
+/*******************************************************************************
+ * Function:        static uint32_t Test_SectorChange(void)
+ *
+ * Overview:        Index of the sample that opens the second sector
+ ******************************************************************************/
+static uint32_t Test_SectorChange(void)
+{
+    uint32_t i = 0;
+
+    Test_PowerUp(true);
+
+    while (flash.mem[FLASH_LOG_SECTOR_SIZE] == 0xFF)
+    {
+        Test_Append(i++);
+    }
+
+    Test_PowerDown();
+
+    return i - 1;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Snapshot(bool save)
+ *
+ * Overview:        Saves the flash contents, or puts them back
+ ******************************************************************************/
+static void Test_Snapshot(bool save)
+{
+    static uint8_t snapshot[FLASH_MODEL_SIZE];
+
+    CHECK(Flash_Model_Open(&flash, TEST_FILE, false));
+
+    if (save)
+    {
+        memcpy(snapshot, flash.mem, sizeof(snapshot));
+    }
+    else
+    {
+        memcpy(flash.mem, snapshot, sizeof(snapshot));
+    }
+
+    Flash_Model_Close(&flash);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_PowerLoss(void)
+ *
+ * Overview:        Cuts the power at every byte of the last records of the
+ *                  first sector, the second sector header and its first
+ *                  records. After the reset the log holds every sample
+ *                  before the one being written, nothing else, and carries
+ *                  on with the next sample into the next sector without
+ *                  programming over old data
+ ******************************************************************************/
+static void Test_PowerLoss(void)
+{
+    uint32_t change = Test_SectorChange();
+    uint32_t base = change - 3;
+    uint32_t cut, i, torn, failed = 0;
+
+    printf("Power loss, second sector opened by sample %u\n",
+           (unsigned)change);
+
+    // Every cut starts from the log up to three samples before the change
+    CHECK(Test_PowerUp(true));
+    for (i = 0; i < base; i++)
+    {
+        Test_Append(i);
+    }
+    Test_PowerDown();
+    Test_Snapshot(true);
+
+    for (cut = 0; cut < 60; cut++)
+    {
+        uint32_t before = test_failures;
+
+        Test_Snapshot(false);
+        CHECK(Test_PowerUp(false));
+
+        flash.cutBytes = cut;
+        for (i = base; !flash.dead && i < change + 20; i++)
+        {
+            Test_Append(i);
+        }
+        CHECK(flash.dead);
+        torn = i - 1;
+        Test_PowerDown();
+
+        CHECK(Test_PowerUp(false));
+        CHECK_EQ(Flash_Log_LastTime(), Test_Time(torn - 1));
+        CHECK_EQ(Test_Query(0, UINT32_MAX), torn);
+
+        // The torn sample is lost, a different one follows
+        for (i = torn + 1; i < change + 20; i++)
+        {
+            CHECK(Test_Append(i));
+        }
+
+        query_gap = torn;
+        CHECK_EQ(Test_Query(0, UINT32_MAX), i - 1);
+        CHECK_EQ(query_first, 0);
+        CHECK_EQ(query_next, i);
+        query_gap = UINT32_MAX;
+        Test_Errors();
+        Test_PowerDown();
+
+        if (test_failures != before)
+        {
+            printf("  cut %u bytes in failed\n", (unsigned)cut);
+            failed++;
+        }
+    }
+
+    printf("  60 cuts, %u failed\n", (unsigned)failed);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_EraseLoss(void)
+ *
+ * Overview:        Cuts the power during the erase ahead on a part holding
+ *                  other data, the half erased sector is erased again at
+ *                  boot before anything is programmed into it
+ ******************************************************************************/
+static void Test_EraseLoss(void)
+{
+    uint32_t i, opened = 0;
+    uint32_t a;
+
+    printf("Power loss during erase ahead\n");
+
+    // A part that was used for something else
+    CHECK(Flash_Model_Open(&flash, TEST_FILE, true));
+    for (a = 0; a < FLASH_MODEL_SIZE; a++)
+    {
+        flash.mem[a] = (a * 151) >> 3;
+    }
+    Flash_Model_Close(&flash);
+
+    CHECK(Test_PowerUp(false));
+
+    for (i = 0; opened < 2 && i < 3000; i++)
+    {
+        FlashLogSample s;
+
+        Test_Sample(i, &s);
+        CHECK(Flash_Log_Append(&s));
+
+        // The chip select goes inactive on the next cycle
+        Sim_Delay(TEST_MS(1) / 10);
+        if (Flash_Model_Busy(&flash) && flash.erasing)
+        {
+            opened++;
+        }
+        if (opened < 2)
+        {
+            Test_Idle(TEST_MS(1000) * TEST_STEP);
+        }
+    }
+
+    CHECK_EQ(flash.eraseAddress, 2 * FLASH_LOG_SECTOR_SIZE);
+    Test_PowerDown();
+    CHECK(flash.erasing == false);
+
+    CHECK(Test_PowerUp(false));
+    CHECK_EQ(Test_Query(0, UINT32_MAX), i);
+
+    for (; i < 3000; i++)
+    {
+        CHECK(Test_Append(i));
+    }
+
+    CHECK_EQ(Test_Query(0, UINT32_MAX), 3000);
+    CHECK_EQ(query_first, 0);
+    Test_Errors();
+    Test_PowerDown();
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Wrap(void)
+ *
+ * Overview:        Fills the ring and goes on round. The oldest sector
+ *                  goes as each new one is erased ahead, the rest stays
+ *                  queryable across a power cycle, then checks time range
+ *                  queries read only the sectors they need
+ ******************************************************************************/
+static void Test_Wrap(void)
+{
+    static const uint32_t ranges[][2] =
+    {
+        { 0, 0 }, { 0, 1 }, { 5, 59 }, { 0, 999 }, { 999, 1000 },
+        { 400, 3100 }, { 12345, 12345 }, { 20000, 24000 }
+    };
+    uint32_t i, n, first, last, reads, sectors;
+    uint8_t r;
+
+    printf("Sector ring wrap\n");
+
+    CHECK(Test_PowerUp(true));
+
+    for (i = 0; flash.erases < FLASH_LOG_SECTORS + 16; i++)
+    {
+        CHECK(Test_Append(i));
+    }
+    last = i - 1;
+    sectors = flash.erases - 1;
+
+    Test_Errors();
+    Test_PowerDown();
+    CHECK(Test_PowerUp(false));
+    CHECK_EQ(Flash_Log_LastTime(), Test_Time(last));
+
+    reads = flash.readBytes;
+    n = Test_Query(0, UINT32_MAX);
+    reads = flash.readBytes - reads;
+    first = query_first;
+
+    printf("  %u samples logged, %u kept from %u, full query %u bytes read\n",
+           (unsigned)(last + 1), (unsigned)n, (unsigned)first,
+           (unsigned)reads);
+
+    CHECK_EQ(query_next, last + 1);
+    CHECK_EQ(n, last + 1 - first);
+    CHECK(first > 0);
+
+    // All sectors but the one erased ahead hold samples
+    CHECK(n >= (last + 1) * (FLASH_LOG_SECTORS - 2) / sectors);
+    CHECK(n <= (last + 1) * FLASH_LOG_SECTORS / sectors);
+
+    // Ranges relative to the oldest sample, inclusive
+    for (r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++)
+    {
+        uint32_t a = first + ranges[r][0];
+        uint32_t b = first + ranges[r][1];
+
+        if (b > last)
+        {
+            b = last;
+        }
+
+        reads = flash.readBytes;
+        CHECK_EQ(Test_Query(Test_Time(a), Test_Time(b)), b - a + 1);
+        reads = flash.readBytes - reads;
+        CHECK_EQ(query_first, a);
+        CHECK_EQ(query_next, b + 1);
+
+        // Times between samples
+        CHECK_EQ(Test_Query(Test_Time(a) - 1, Test_Time(b) + 1), b - a + 1);
+
+        printf("  %5u..%-5u %5u samples %7u bytes read\n", (unsigned)a,
+               (unsigned)b, (unsigned)(b - a + 1), (unsigned)reads);
+
+        // A range covers its sectors plus one record read beyond
+        CHECK(reads < ((b - a) / 300 + 3) * FLASH_LOG_SECTOR_SIZE * 2);
+    }
+
+    // Outside the log, empty and reversed ranges
+    CHECK_EQ(Test_Query(0, Test_Time(first) - 1), 0);
+    CHECK_EQ(Test_Query(Test_Time(last) + 1, UINT32_MAX), 0);
+    CHECK_EQ(Test_Query(Test_Time(first + 10), Test_Time(first + 5)), 0);
+    CHECK_EQ(Test_Query(Test_Time(first + 10) + 1, Test_Time(first + 10) + 59),
+             0);
+
+    Test_Errors();
+    Test_PowerDown();
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Hang(void)
+ *
+ * Overview:        A flash that stays busy fails the store after
+ *                  FLASH_LOG_BUSY_MS and every later one at once. What was
+ *                  stored comes back once it answers again
+ ******************************************************************************/
+static void Test_Hang(void)
+{
+    const uint64_t limit = TEST_MS(FLASH_LOG_BUSY_MS);
+    SIM_SPI_STATS before;
+    FlashLogSample s;
+    uint64_t start;
+    uint32_t i;
+
+    printf("Flash stuck busy\n");
+
+    CHECK(Test_PowerUp(true));
+    for (i = 0; i < 100; i++)
+    {
+        CHECK(Test_Append(i));
+    }
+
+    flash.stuck = true;
+
+    Test_Sample(i, &s);
+    start = Sim_Now();
+    CHECK(!Flash_Log_Append(&s));
+    printf("  first store failed after %.1f ms\n",
+           Sim_Microseconds(Sim_Now() - start) / 1000);
+    // Timed in TMR1 ticks
+    CHECK(Sim_Now() - start > limit - TEST_MS(1));
+    CHECK(Sim_Now() - start < limit + TEST_MS(1));
+
+    before = *Sim_SPI_Stats();
+    start = Sim_Now();
+    CHECK(!Flash_Log_Append(&s));
+    CHECK_EQ(Test_Query(0, UINT32_MAX), 0);
+    CHECK(Sim_Now() - start < TEST_MS(1) / 10);
+    CHECK_EQ(Sim_SPI_Stats()->bytes, before.bytes);
+
+    // Boot with the part still hung
+    Test_PowerDown();
+    CHECK(Flash_Model_Open(&flash, TEST_FILE, false));
+    flash.stuck = true;
+    Sim_SPI_Attach(&flash.dev);
+    start = Sim_Now();
+    CHECK(!Flash_Log_Init());
+    CHECK(Sim_Now() - start < limit + TEST_MS(1));
+    Test_PowerDown();
+
+    // Recovered
+    CHECK(Test_PowerUp(false));
+    CHECK_EQ(Test_Query(0, UINT32_MAX), 100);
+    CHECK(Test_Append(100));
+    CHECK_EQ(Test_Query(0, UINT32_MAX), 101);
+    Test_Errors();
+    Test_PowerDown();
+}
+
+/*******************************************************************************
+ * Function:        int main(void)
+ *
+ * Overview:        Runs the tests
+ ******************************************************************************/
+int main(void)
+{
+    Sim_Reset();
+    Sim_SPI_Init();
+    Sim_DMA_Init();
+    SPI2_Initialize();
+    SPI2_DMA_Initialize();
+
+    Test_Blank();
+    Test_PowerLoss();
+    Test_EraseLoss();
+    Test_Wrap();
+    Test_Hang();
+
+    return TEST_RESULT("Test_Flash");
+}
@@ -0,0 +1,470 @@
+/*******************************************************************************
+ * File: Test_I2C.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Host tests of the I2C1 drivers. Runs the SSD1306 and
+ *                      EEPROM log drivers unmodified against the I2C bus
+ *                      simulation, checks what the device models received and
+ *                      reports bus time. The display contents are saved to
+ *                      build/ssd1306.pbm
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "PIC24_PIC33_I2C.h"
+#include "SSD1306_OLED.h"
+#include "EEPROM_Log.h"
+#include "I2C_Bus.h"
+#include "SSD1306_Model.h"
+#include "EEPROM_Model.h"
+#include "Test.h"
+#include <string.h>
+
+TEST_MAIN_DATA;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static SSD1306_MODEL oled;
+static EEPROM_MODEL eeprom;
+static uint8_t eeprom_memory[EE_LOG_SIZE];
+
+/*******************************************************************************
+ * Function:        static void Test_Bench(const char *name, uint64_t start,
+ *                  const SIM_I2C_STATS *before)
+ *
+ * Overview:        Prints the simulated time and bus traffic since start
+ ******************************************************************************/
+static void Test_Bench(const char *name, uint64_t start,
+                       const SIM_I2C_STATS *before)
+{
+    const SIM_I2C_STATS *s = Sim_I2C_Stats();
+
+    printf("  %-28s %9.1f us %6u bytes %5u starts %3u nacks\n", name,
+           Sim_Microseconds(Sim_Now() - start),
+           (unsigned)(s->written + s->read - before->written - before->read),
+           (unsigned)(s->starts - before->starts),
+           (unsigned)(s->nacks - before->nacks));
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Setup(void)
+ *
+ * Overview:        Fresh simulation with the display and a blank 24LC16B
+ *                  (or 24LC256 with EE_LOG_HIGH_DENSITY) on the bus
+ ******************************************************************************/
+static void Test_Setup(void)
+{
+    Sim_Reset();
+    Sim_I2C_Init();
+
+    SSD1306_Model_Init(&oled, 0x3C);
+    Sim_I2C_Attach(&oled.dev);
+
+    memset(eeprom_memory, EE_LOG_ERASED, sizeof(eeprom_memory));
+    EEPROM_Model_Init(&eeprom, eeprom_memory, EE_LOG_SIZE, EE_LOG_PAGE_SIZE,
+                      EE_LOG_HIGH_DENSITY);
+    Sim_I2C_Attach(&eeprom.dev);
+
+    I2C1_INIT();
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Display(void)
+ *
+ * Overview:        Initialises the display, draws a test pattern and checks
+ *                  the panel shows it the right way up
+ ******************************************************************************/
+static void Test_Display(void)
+{
+    SIM_I2C_STATS before;
+    uint64_t start;
+    uint16_t x, lit;
+
+    printf("SSD1306\n");
+    Test_Setup();
+
+    before = *Sim_I2C_Stats();
+    start = Sim_Now();
+    SSD1306_INIT();
+    Test_Bench("SSD1306_INIT", start, &before);
+
+    CHECK(oled.displayOn);
+    CHECK(oled.chargePump);
+    CHECK(oled.segRemap);
+    CHECK(oled.comRemap);
+    CHECK(!oled.inverse);
+    CHECK(!oled.entireOn);
+    CHECK_EQ(oled.memoryMode, 0);
+    CHECK_EQ(oled.contrast, 0x8F);
+    CHECK_EQ(oled.multiplex, 64);
+    CHECK_EQ(oled.unknown, 0);
+    CHECK_EQ(oled.cmdLength, 0);
+
+    SSD1306_Clear_Display();
+    drawPixel(0, 0, WHITE);
+    drawPixel(127, 63, WHITE);
+    drawFastHLine(0, 32, 128, WHITE);
+    drawFastVLine(64, 40, 10, WHITE);
+    SSD1306_Write_Text(8, 8, "PLANT", 1, WHITE);
+
+    before = *Sim_I2C_Stats();
+    start = Sim_Now();
+    SSD1306_Write_Buffer();
+    Test_Bench("SSD1306_Write_Buffer", start, &before);
+
+    CHECK_EQ(oled.dataBytes, SSD1306_MODEL_PAGES * SSD1306_MODEL_WIDTH);
+    CHECK_EQ(oled.unknown, 0);
+
+    // Corners, the line and their neighbours
+    CHECK(SSD1306_Model_Pixel(&oled, 0, 0));
+    CHECK(SSD1306_Model_Pixel(&oled, 127, 63));
+    CHECK(!SSD1306_Model_Pixel(&oled, 1, 0));
+    CHECK(!SSD1306_Model_Pixel(&oled, 127, 62));
+    CHECK(SSD1306_Model_Pixel(&oled, 64, 49));
+    CHECK(!SSD1306_Model_Pixel(&oled, 64, 50));
+
+    for (x = 0, lit = 0; x < SSD1306_MODEL_WIDTH; x++)
+    {
+        lit += SSD1306_Model_Pixel(&oled, x, 32);
+        lit += SSD1306_Model_Pixel(&oled, x, 31);
+    }
+    CHECK_EQ(lit, SSD1306_MODEL_WIDTH);
+
+    // Text is drawn somewhere in its cell
+    for (x = 8, lit = 0; x < 8 + 5 * 6; x++)
+    {
+        uint8_t y;
+
+        for (y = 8; y < 16; y++)
+        {
+            lit += SSD1306_Model_Pixel(&oled, x, y);
+        }
+    }
+    CHECK(lit > 20);
+
+    CHECK(SSD1306_Model_WritePBM(&oled, "ssd1306.pbm"));
+
+    // The bus is back at its default speed for the other devices
+    CHECK_EQ(I2C1BRG, I2C_BRG(I2C1_DEFAULT_SPEED));
+}
+
+/*******************************************************************************
+ * Function:        static EELogRecord Test_Record(uint16_t i)
+ *
+ * Overview:        Record number i of the test sequence
+ ******************************************************************************/
+static EELogRecord Test_Record(uint16_t i)
+{
+    EELogRecord r;
+
+    r.seq = 0;
+    r.flags = i & 0x07;
+    r.light = i;
+    r.moisture = i * 3;
+    r.temperature = -(int16_t)i;
+
+    return r;
+}
+
+/*******************************************************************************
+ * Function:        static bool Test_LogMatches(uint16_t first, uint16_t count)
+ *
+ * Overview:        Reads back the whole log and compares it with records
+ *                  first..first+count-1 of the test sequence
+ ******************************************************************************/
+static bool Test_LogMatches(uint16_t first, uint16_t count)
+{
+    EELogRecord r[16];
+    uint16_t index = 0;
+    uint16_t n, i;
+
+    if (EE_Log_Count() != count)
+    {
+        return false;
+    }
+
+    while ((n = EE_Log_Read(index, r, 16)) != 0)
+    {
+        for (i = 0; i < n; i++)
+        {
+            EELogRecord want = Test_Record(first + index + i);
+
+            if (r[i].light != want.light || r[i].moisture != want.moisture ||
+                r[i].temperature != want.temperature ||
+                r[i].flags != want.flags)
+            {
+                return false;
+            }
+        }
+        index += n;
+    }
+
+    return index == count;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Log(void)
+ *
+ * Overview:        EEPROM log on a blank part, across reboots and once the
+ *                  device has wrapped
+ ******************************************************************************/
+static void Test_Log(void)
+{
+    SIM_I2C_STATS before;
+    uint64_t start;
+    uint16_t i;
+    EELogRecord r;
+
+    printf("EEPROM log, %u bytes, %u byte pages\n", EE_LOG_SIZE,
+           EE_LOG_PAGE_SIZE);
+    Test_Setup();
+
+    before = *Sim_I2C_Stats();
+    start = Sim_Now();
+    CHECK(EE_Log_Init());
+    Test_Bench("EE_Log_Init blank", start, &before);
+    CHECK_EQ(EE_Log_Count(), 0);
+
+    // A partial page, flushed
+    for (i = 0; i < 5; i++)
+    {
+        r = Test_Record(i);
+        CHECK(EE_Log_Append(&r));
+    }
+
+    before = *Sim_I2C_Stats();
+    start = Sim_Now();
+    EE_Log_Flush();
+    while (I2C_Bus_Tasks());
+    Test_Bench("EE_Log_Flush 5 records", start, &before);
+    CHECK(Test_LogMatches(0, 5));
+
+    // Reboot, the log continues where it stopped
+    before = *Sim_I2C_Stats();
+    start = Sim_Now();
+    CHECK(EE_Log_Init());
+    Test_Bench("EE_Log_Init 5 records", start, &before);
+    CHECK(Test_LogMatches(0, 5));
+
+    before = *Sim_I2C_Stats();
+    start = Sim_Now();
+    for (i = 5; i < EE_LOG_RECORDS + 40; i++)
+    {
+        r = Test_Record(i);
+        CHECK(EE_Log_Append(&r));
+    }
+    EE_Log_Flush();
+    while (I2C_Bus_Tasks());
+    Test_Bench("EE_Log_Append to wrap", start, &before);
+
+    CHECK(Test_LogMatches(40, EE_LOG_RECORDS));
+
+    before = *Sim_I2C_Stats();
+    start = Sim_Now();
+    CHECK(EE_Log_Init());
+    Test_Bench("EE_Log_Init full", start, &before);
+    CHECK(Test_LogMatches(40, EE_LOG_RECORDS));
+
+    // Page writes never wrapped inside the device page
+    CHECK_EQ(eeprom.rollovers, 0);
+    printf("  %u page writes for %u bytes\n", (unsigned)eeprom.pageWrites,
+           (unsigned)eeprom.bytesWritten);
+
+    // No device, logging is disabled
+    Sim_I2C_Detach(&eeprom.dev);
+    CHECK(!EE_Log_Init());
+    r = Test_Record(0);
+    CHECK(!EE_Log_Append(&r));
+    CHECK_EQ(EE_Log_Count(), 0);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Shadow(void)
+ *
+ * Overview:        Shadowed registers on a device that stops acknowledging,
+ *                  the EEPROM during its write cycle. A failed write or read
+ *                  must not leave a value in the cache
+ ******************************************************************************/
+static void Test_Shadow(void)
+{
+    uint8_t regs[16];
+    uint8_t valid[I2C1_SHADOW_VALID_BYTES(16)];
+    uint32_t nacks, reads;
+
+    printf("Shadow registers\n");
+    Test_Setup();
+    CHECK(I2C1_ShadowAttach(0xA0, 0x00, 16, regs, valid));
+
+    // The write is cached, the bit update sent during the write cycle fails
+    I2C1_Write(0xA0, 3, 0x5A);
+    CHECK(EEPROM_Model_Busy(&eeprom));
+    nacks = eeprom.busyNacks;
+    I2C1_WriteBit(0xA0, 3, 0, 1);
+    CHECK(eeprom.busyNacks > nacks);
+    CHECK_EQ(eeprom_memory[3], 0x5A);
+
+    // So the next update reads the register back from the device
+    __delay_ms(EEPROM_MODEL_TWC_MS);
+    I2C1_WriteBit(0xA0, 3, 7, 1);
+    CHECK_EQ(eeprom_memory[3], 0xDA);
+
+    // A read that is not acknowledged is not cached either
+    CHECK(EEPROM_Model_Busy(&eeprom));
+    I2C1_Read(0xA0, 3);
+    __delay_ms(EEPROM_MODEL_TWC_MS);
+    I2C1_WriteBit(0xA0, 3, 2, 1);
+    CHECK_EQ(eeprom_memory[3], 0xDE);
+
+    // A cached register costs no read
+    __delay_ms(EEPROM_MODEL_TWC_MS);
+    reads = eeprom.bytesRead;
+    I2C1_WriteBit(0xA0, 3, 7, 0);
+    CHECK_EQ(eeprom.bytesRead, reads);
+    CHECK_EQ(eeprom_memory[3], 0x5E);
+
+    I2C1_ShadowDetach(0xA0);
+}
+
+/*******************************************************************************
+ * Function:        static bool Test_Step(void *context)
+ *
+ * Overview:        Job step that completes straight away
+ ******************************************************************************/
+static bool Test_Step(void *context)
+{
+    (void)context;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Arbiter(void)
+ *
+ * Overview:        Display flush and log writes queued together and run
+ *                  from a main loop calling I2C_Bus_Tasks(), as main.c does
+ ******************************************************************************/
+static void Test_Arbiter(void)
+{
+    SIM_I2C_STATS before;
+    I2C_BUS_JOB job;
+    uint64_t start;
+    uint16_t i, steps = 0;
+    EELogRecord r;
+
+    printf("I2C bus arbiter\n");
+    Test_Setup();
+    SSD1306_INIT();
+    CHECK(EE_Log_Init());
+    I2C_Bus_StatsReset();
+
+    SSD1306_Clear_Display();
+    drawFastHLine(0, 10, 128, WHITE);
+
+    before = *Sim_I2C_Stats();
+    start = Sim_Now();
+    SSD1306_Write_Buffer_Start();
+    CHECK(SSD1306_Write_Buffer_Busy());
+    CHECK(I2C_Bus_Busy());
+
+    // Two pages of records, queued behind the display without running it
+    for (i = 0; i < 2 * EE_LOG_PAGE_SIZE / EE_LOG_RECORD_SIZE; i++)
+    {
+        r = Test_Record(i);
+        CHECK(EE_Log_Append(&r));
+    }
+    CHECK(I2C_Bus_Stats(I2C_BUS_CLIENT_LOG)->jobs >= 1);
+
+    while (I2C_Bus_Tasks())
+    {
+        steps++;
+    }
+    Test_Bench("display and log", start, &before);
+    printf("  %u steps\n", steps);
+
+    CHECK(!SSD1306_Write_Buffer_Busy());
+    CHECK(!I2C_Bus_Busy());
+    CHECK_EQ(I2C_Bus_Stats(I2C_BUS_CLIENT_DISPLAY)->jobs, 1);
+    CHECK_EQ(I2C_Bus_Stats(I2C_BUS_CLIENT_DISPLAY)->steps,
+             SSD1306_MODEL_PAGES);
+    CHECK(SSD1306_Model_Pixel(&oled, 5, 10));
+    CHECK(Test_LogMatches(0, 2 * EE_LOG_PAGE_SIZE / EE_LOG_RECORD_SIZE));
+    CHECK_EQ(eeprom.pageWrites, 2);
+
+    // A job is queued once however often it is submitted
+    I2C_Bus_JobInit(&job, Test_Step, NULL, I2C_BUS_PRIO_HIGH,
+                    I2C_BUS_CLIENT_SENSOR);
+    CHECK(I2C_Bus_Submit(&job));
+    CHECK(!I2C_Bus_Submit(&job));
+    CHECK(Sim_InterruptsEnabled());
+    CHECK(I2C_Bus_Tasks());
+    CHECK(!I2C_Bus_Tasks());
+    CHECK(!job.busy);
+    CHECK_EQ(I2C_Bus_Stats(I2C_BUS_CLIENT_SENSOR)->jobs, 1);
+
+    // Display on/off goes through the arbiter, the last command wins
+    SSD1306_Display_Power_Start(false);
+    CHECK(I2C_Bus_Busy());
+    CHECK(oled.displayOn);
+    SSD1306_Display_Power_Start(true);
+    SSD1306_Display_Power_Start(false);
+    CHECK(I2C_Bus_Tasks());
+    CHECK(!I2C_Bus_Tasks());
+    CHECK(!oled.displayOn);
+    CHECK_EQ(I2C_Bus_Stats(I2C_BUS_CLIENT_DISPLAY)->jobs, 2);
+    SSD1306_Display_Power_Start(true);
+    while (I2C_Bus_Tasks());
+    CHECK(oled.displayOn);
+    CHECK_EQ(I2C_Bus_Stats(I2C_BUS_CLIENT_DISPLAY)->jobs, 3);
+}
+
+/*******************************************************************************
+ * Function:        int main(void)
+ *
+ * Overview:        Runs the tests
+ ******************************************************************************/
+int main(void)
+{
+    Test_Display();
+    Test_Shadow();
+    Test_Log();
+    Test_Arbiter();
+
+    return TEST_RESULT("Test_I2C");
+}
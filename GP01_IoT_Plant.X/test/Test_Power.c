@@ -0,0 +1,424 @@
+/*******************************************************************************
+ * File: Test_Power.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Host tests of the power modes. Runs Low_Power and the
+ *                      scheduler unmodified with the sensor, flash history and
+ *                      a display flush on the simulated buses, checks the CPU
+ *                      never sleeps with a bus transfer in progress and reports
+ *                      the duty cycle and average supply current of the sleep
+ *                      schedule
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "IoT_Plant_Specific.h"
+#include "Low_Power.h"
+#include "Scheduler.h"
+#include "SPI_Bus.h"
+#include "SPI2_DMA.h"
+#include "I2C_Bus.h"
+#include "DS1722.h"
+#include "Flash_Log.h"
+#include "DS1722_Model.h"
+#include "Flash_Model.h"
+#include "Test.h"
+
+// Simulated time in cycles
+#define TEST_MS(ms)     ((uint64_t)FCY * (ms) / 1000)
+
+// Backing file of the flash, in the build directory
+#define TEST_FILE       "Test_Power.bin"
+
+// Length of the schedule run
+#define TEST_RUN_S      600
+
+// Typical supply current of the dsPIC33EP at 32 MIPS and 3.3 V in mA, for
+// the report only. Sleep includes the watchdog
+#define TEST_RUN_MA     25.0
+#define TEST_IDLE_MA    8.0
+#define TEST_SLEEP_MA   0.05
+
+TEST_MAIN_DATA;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static DS1722_MODEL sensor;
+static FLASH_MODEL flash;
+
+// Display flush stand in, one step per page written
+static I2C_BUS_JOB display_job;
+static uint8_t display_page;
+
+static uint32_t log_last;
+static uint32_t log_time;
+static uint32_t log_count;
+
+// Flash read long enough to go by DMA, in (simulated) data RAM
+static uint8_t dma_tx[64] = { 0x03 };
+static uint8_t dma_rx[64];
+static SPI_TRANSACTION dma_txn;
+
+static const SPI_DEVICE flash_spi =
+{
+    &FLASH_LOG_CS_LAT, FLASH_LOG_CS_MASK, false,
+    SPI_CON1(SPI_MODE0, SPI_PPRE_4, 1), 0
+};
+
+/*******************************************************************************
+ * Function:        bool ADC1_TriggeredAcquisitionHold(void)
+ *
+ * Overview:        The ADC is not simulated, nothing is being converted
+ ******************************************************************************/
+bool ADC1_TriggeredAcquisitionHold(void)
+{
+    return false;
+}
+
+/*******************************************************************************
+ * Function:        void ADC1_TriggeredAcquisitionResume(void)
+ *
+ * Overview:        The ADC is not simulated
+ ******************************************************************************/
+void ADC1_TriggeredAcquisitionResume(void)
+{
+}
+
+/*******************************************************************************
+ * Function:        static bool Test_DisplayStep(void *context)
+ *
+ * Overview:        Writes one of the eight SSD1306 pages, 129 bytes polled
+ *                  at 400 kHz
+ ******************************************************************************/
+static bool Test_DisplayStep(void *context)
+{
+    (void)context;
+
+    Sim_Delay(TEST_MS(3));
+
+    if (++display_page < 8)
+    {
+        return false;
+    }
+
+    display_page = 0;
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_TempTask(void)
+ *
+ * Overview:        Temperature_Task, collects the one-shot conversion and
+ *                  starts the next
+ ******************************************************************************/
+static void Test_TempTask(void)
+{
+    int16_t temp;
+
+    if (DS1722_GetResult(&temp))
+    {
+        DS1722_StartConversion();
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void Test_DisplayTask(void)
+ *
+ * Overview:        Display_Task, queues the flush of the frame buffer
+ ******************************************************************************/
+static void Test_DisplayTask(void)
+{
+    I2C_Bus_Submit(&display_job);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_LogTask(void)
+ *
+ * Overview:        Telemetry_Task, a flash history sample every
+ *                  LOG_INTERVAL_S
+ ******************************************************************************/
+static void Test_LogTask(void)
+{
+    FlashLogSample sample;
+
+    if (TMR1_TimestampGet() - log_last < LOG_INTERVAL_TICKS)
+    {
+        return;
+    }
+
+    sample.time = log_time;
+    sample.flags = 0;
+    sample.light = 500;
+    sample.moisture = 300;
+    sample.temperature = 20 * 256;
+
+    if (Flash_Log_Append(&sample))
+    {
+        log_count++;
+    }
+
+    log_time += LOG_INTERVAL_S;
+    log_last += LOG_INTERVAL_TICKS;
+}
+
+// The tasks of main.c that use the buses, at their periods
+static SCHED_TASK tasks[] =
+{
+    SCHED_TASK_INIT("temp",    Test_TempTask,    TEMP_PERIOD_MS,    1000, 40),
+    SCHED_TASK_INIT("display", Test_DisplayTask, DISPLAY_PERIOD_MS,  500, 60),
+    SCHED_TASK_INIT("log",     Test_LogTask,     TELEMETRY_PERIOD_MS, 500, 150)
+};
+
+#define TEST_TASKS  (sizeof(tasks) / sizeof(tasks[0]))
+
+/*******************************************************************************
+ * Function:        static void Test_Setup(void)
+ *
+ * Overview:        Sensor and erased flash on the bus, the UART idle
+ ******************************************************************************/
+static void Test_Setup(void)
+{
+    DS1722_Model_Init(&sensor);
+    DS1722_Model_Constant(&sensor, 21 * 256);
+    Sim_SPI_Attach(&sensor.dev);
+
+    CHECK(Flash_Model_Open(&flash, TEST_FILE, true));
+    Sim_SPI_Attach(&flash.dev);
+    Sim_SPI_StatsReset();
+
+    // Output goes to stdout, nothing is ever left shifting out
+    U1STAbits.TRMT = 1;
+
+    DS1722_Init(12, true);
+    CHECK(Flash_Log_Init());
+    I2C_Bus_JobInit(&display_job, Test_DisplayStep, NULL, I2C_BUS_PRIO_LOW,
+                    I2C_BUS_CLIENT_DISPLAY);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Gate(void)
+ *
+ * Overview:        Waits with work on either bus idle instead of sleeping,
+ *                  so neither a DMA transfer nor a queued job is stopped
+ ******************************************************************************/
+static void Test_Gate(void)
+{
+    uint32_t sleeps, stamp, ticks;
+    uint64_t start;
+
+    printf("Sleep gate\n");
+    Sim_PowerReset();
+
+    // DMA transfer in flight, the wait ends at its interrupt
+    dma_txn.device = &flash_spi;
+    dma_txn.tx = dma_tx;
+    dma_txn.rx = dma_rx;
+    dma_txn.length = sizeof(dma_rx);
+    dma_txn.done = NULL;
+    CHECK(SPI_Bus_Submit(&dma_txn));
+    CHECK(SPI_Bus_Busy());
+    Low_Power_Wait(SCHED_MS(1000), true);
+    CHECK_EQ(Sim_Power()->sleeps, 0);
+
+    CHECK(SPI_Bus_Tasks());
+    CHECK(SPI2_DMA_IsBusy());
+    Low_Power_Wait(SCHED_MS(1000), true);
+    CHECK_EQ(Sim_Power()->sleeps, 0);
+    CHECK(Sim_Power()->idleCycles > 0);
+    CHECK(!SPI2_DMA_IsBusy());
+    CHECK(SPI_Bus_Busy());
+    CHECK(SPI_Bus_Tasks());
+    CHECK(!dma_txn.busy);
+    CHECK(!SPI_Bus_Busy());
+
+    // Queued I2C job
+    CHECK(I2C_Bus_Submit(&display_job));
+    CHECK(I2C_Bus_Busy());
+    Low_Power_Wait(SCHED_MS(1000), true);
+    CHECK_EQ(Sim_Power()->sleeps, 0);
+    I2C_Bus_Wait(&display_job);
+    CHECK(!I2C_Bus_Busy());
+
+    // Buses quiet, one watchdog timeout asleep and TMR1 moved on by it
+    stamp = TMR1_TimestampGet();
+    start = Sim_Now();
+    Low_Power_Wait(SCHED_MS(1000), true);
+    CHECK_EQ(Sim_Power()->sleeps, 1);
+    CHECK(Sim_Now() - start >= TEST_MS(LOW_POWER_WDT_MS));
+    CHECK(Sim_Now() - start < TEST_MS(LOW_POWER_WDT_MS + 1));
+    ticks = TMR1_TimestampGet() - stamp;
+    CHECK(ticks >= SCHED_MS(LOW_POWER_WDT_MS));
+    CHECK(ticks <= SCHED_MS(LOW_POWER_WDT_MS) + 1);
+    CHECK(!RCONbits.WDTO);
+    CHECK(!RCONbits.SWDTEN);
+    CHECK_EQ(Low_Power_SleepTicks(), SCHED_MS(LOW_POWER_WDT_MS));
+
+    // Too short to sleep, or sleep not allowed, idles to the end of the wait
+    sleeps = Sim_Power()->sleeps;
+    start = Sim_Now();
+    Low_Power_Wait(SCHED_MS(LOW_POWER_SLEEP_MIN_MS - 10), true);
+    CHECK(Sim_Now() - start >= TEST_MS(LOW_POWER_SLEEP_MIN_MS - 11));
+    CHECK(Sim_Now() - start < TEST_MS(LOW_POWER_SLEEP_MIN_MS - 9));
+    Low_Power_Wait(SCHED_MS(200), false);
+    CHECK_EQ(Sim_Power()->sleeps, sleeps);
+
+    CHECK_EQ(Sim_Power()->stalls, 0);
+}
+
+/*******************************************************************************
+ * Function:        static double Test_Report(const char *name,
+ *                  uint64_t start)
+ *
+ * Overview:        Prints the share of time in each power mode since start
+ *                  and the average current it works out to
+ ******************************************************************************/
+static double Test_Report(const char *name, uint64_t start)
+{
+    const SIM_POWER *p = Sim_Power();
+    double total = (double)(Sim_Now() - start);
+    double idle = p->idleCycles / total;
+    double sleep = p->sleepCycles / total;
+    double run = 1.0 - idle - sleep;
+    double current;
+
+    current = run * TEST_RUN_MA + idle * TEST_IDLE_MA + sleep * TEST_SLEEP_MA;
+
+    printf("  %-10s run %5.2f%% idle %5.2f%% sleep %5.2f%% %8.3f mA\n",
+           name, run * 100, idle * 100, sleep * 100, current);
+
+    return current;
+}
+
+/*******************************************************************************
+ * Function:        static double Test_Run(const char *name, bool sleep)
+ *
+ * Overview:        The main loop of main.c for TEST_RUN_S over the task
+ *                  table, returns the average current
+ ******************************************************************************/
+static double Test_Run(const char *name, bool sleep)
+{
+    uint64_t start, end;
+    uint8_t i;
+    bool busy;
+
+    log_last = TMR1_TimestampGet();
+    log_count = 0;
+    for (i = 0; i < TEST_TASKS; i++)
+    {
+        tasks[i].runs = 0;
+        tasks[i].late = 0;
+    }
+
+    Scheduler_Init(tasks, TEST_TASKS);
+    Low_Power_Init();
+    Sim_PowerReset();
+    start = Sim_Now();
+    end = start + TEST_MS(TEST_RUN_S * 1000UL);
+
+    while (Sim_Now() < end)
+    {
+        busy = SPI_Bus_Tasks();
+        busy |= I2C_Bus_Tasks();
+
+        if (!Scheduler_Run() && !busy)
+        {
+            Low_Power_Wait(Scheduler_NextDue(), sleep);
+        }
+    }
+
+    for (i = 0; i < TEST_TASKS; i++)
+    {
+        CHECK_EQ(tasks[i].late, 0);
+        CHECK(tasks[i].runs >= TEST_RUN_S * SCHED_MS(1000) / tasks[i].period - 1);
+    }
+
+    CHECK(log_count >= TEST_RUN_S / LOG_INTERVAL_S - 1);
+    CHECK_EQ(Sim_Power()->stalls, 0);
+    CHECK_EQ(sensor.busyReads, 0);
+    CHECK_EQ(flash.busyCommands, 0);
+
+    return Test_Report(name, start);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Schedule(void)
+ *
+ * Overview:        Same schedule idling only and sleeping between tasks
+ ******************************************************************************/
+static void Test_Schedule(void)
+{
+    double idle, sleep;
+    uint32_t wakes;
+
+    printf("Schedule over %u s\n", TEST_RUN_S);
+
+    idle = Test_Run("idle only", false);
+    CHECK_EQ(Sim_Power()->sleeps, 0);
+
+    sleep = Test_Run("sleep", true);
+    wakes = Sim_Power()->sleeps;
+    printf("  %u watchdog wake ups, %.1f per second\n", (unsigned)wakes,
+           (double)wakes / TEST_RUN_S);
+
+    CHECK(wakes > TEST_RUN_S * 3);
+    CHECK(sleep < idle / 2);
+}
+
+/*******************************************************************************
+ * Function:        int main(void)
+ *
+ * Overview:        Runs the tests
+ ******************************************************************************/
+int main(void)
+{
+    Sim_Reset();
+    Sim_SPI_Init();
+    Sim_DMA_Init();
+    SPI2_Initialize();
+    SPI2_DMA_Initialize();
+
+    Test_Setup();
+    Test_Gate();
+    Test_Schedule();
+
+    Flash_Model_Close(&flash);
+
+    return TEST_RESULT("Test_Power");
+}
@@ -0,0 +1,657 @@
+/*******************************************************************************
+ * File: Test_SPI.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Host tests of the SPI2 drivers. Runs the DS1722 driver
+ *                      unmodified against the SPI bus simulation and a DS1722
+ *                      model, checks the configuration, conversion timing and
+ *                      the values read back for several temperature waveforms.
+ *                      Checks that queued transactions moved by DMA put the
+ *                      same bytes on the bus and read back the same data as
+ *                      the polled exchange
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "DS1722.h"
+#include "Classifier.h"
+#include "IoT_Plant_Specific.h"
+#include "SPI_Bus.h"
+#include "SPI2_DMA.h"
+#include "DS1722_Model.h"
+#include "Test.h"
+#include <string.h>
+
+// Simulated time in cycles
+#define TEST_MS(ms)     ((uint64_t)FCY * (ms) / 1000)
+
+// Longest transaction of the DMA test
+#define TEST_DMA_MAX    300
+
+TEST_MAIN_DATA;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static DS1722_MODEL sensor;
+
+// Slave that records what it is sent and answers with a pseudo random
+// sequence, on RB12
+static struct
+{
+    SIM_SPI_DEVICE dev;
+    uint16_t lfsr;
+    uint16_t count;
+    uint8_t mosi[TEST_DMA_MAX];
+} recorder;
+
+static const SPI_DEVICE recorder_spi =
+{
+    &LATB, 1 << 12, false, SPI_CON1(SPI_MODE0, SPI_PPRE_4, 1), 0
+};
+
+// DMA buffers must be in (simulated) data RAM, not on the stack
+static uint8_t dma_tx[TEST_DMA_MAX];
+static uint8_t dma_rx[TEST_DMA_MAX];
+static uint8_t poll_rx[TEST_DMA_MAX];
+static uint8_t poll_mosi[TEST_DMA_MAX];
+
+/*******************************************************************************
+ * Function:        static void Test_Bench(const char *name, uint64_t start,
+ *                  const SIM_SPI_STATS *before)
+ *
+ * Overview:        Prints the simulated time and bus traffic since start
+ ******************************************************************************/
+static void Test_Bench(const char *name, uint64_t start,
+                       const SIM_SPI_STATS *before)
+{
+    const SIM_SPI_STATS *s = Sim_SPI_Stats();
+
+    printf("  %-28s %9.1f us %6u bytes %5u selects\n", name,
+           Sim_Microseconds(Sim_Now() - start),
+           (unsigned)(s->bytes - before->bytes),
+           (unsigned)(s->selects - before->selects));
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Setup(void)
+ *
+ * Overview:        Fresh sensor in its power on state on the bus. The
+ *                  simulation keeps running across tests, like the SPI2
+ *                  setup the driver has loaded
+ ******************************************************************************/
+static void Test_Setup(void)
+{
+    DS1722_Model_Init(&sensor);
+    Sim_SPI_Attach(&sensor.dev);
+    Sim_SPI_StatsReset();
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Errors(void)
+ *
+ * Overview:        Checks nothing went wrong on the bus
+ ******************************************************************************/
+static void Test_Errors(void)
+{
+    const SIM_SPI_STATS *s = Sim_SPI_Stats();
+
+    CHECK_EQ(s->modeErrors, 0);
+    CHECK_EQ(s->unselected, 0);
+    CHECK_EQ(s->conflicts, 0);
+    CHECK_EQ(s->overruns, 0);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Init(void)
+ *
+ * Overview:        Configuration write and read back, each a single chip
+ *                  select cycle at a clock the part allows
+ ******************************************************************************/
+static void Test_Init(void)
+{
+    SIM_SPI_STATS before;
+    uint8_t regs[3];
+    uint64_t start;
+
+    printf("DS1722 configuration\n");
+    Test_Setup();
+
+    before = *Sim_SPI_Stats();
+    start = Sim_Now();
+    DS1722_Init(12, true);
+    Test_Bench("DS1722_Init", start, &before);
+
+    CHECK_EQ(sensor.regs[DS1722_REG_CONFIG],
+             DS1722_CFG_FIXED | DS1722_CFG_RES(12) | DS1722_CFG_SD);
+    CHECK_EQ(sensor.configWrites, 1);
+    CHECK(!sensor.converting);
+    CHECK_EQ(Sim_SPI_Stats()->selects, 1);
+    CHECK_EQ(Sim_SPI_Stats()->bytes, 2);
+
+    // Straight after the write, the chip select has to go inactive between
+    before = *Sim_SPI_Stats();
+    start = Sim_Now();
+    DS1722_ReadRegisters(DS1722_REG_CONFIG, regs, 3);
+    Test_Bench("DS1722_ReadRegisters x3", start, &before);
+
+    CHECK_EQ(Sim_SPI_Stats()->selects, 2);
+    CHECK_EQ(Sim_SPI_Stats()->bytes, 6);
+    CHECK_EQ(regs[0], sensor.regs[DS1722_REG_CONFIG]);
+    CHECK_EQ(regs[1], 0);
+    CHECK_EQ(regs[2], 0);
+
+    DS1722_Init(9, false);
+    CHECK_EQ(sensor.regs[DS1722_REG_CONFIG],
+             DS1722_CFG_FIXED | DS1722_CFG_RES(9));
+    CHECK(sensor.converting);
+
+    Test_Errors();
+}
+
+/*******************************************************************************
+ * Function:        static void Test_OneShot(void)
+ *
+ * Overview:        One-shot conversion at every resolution. The result is
+ *                  not collected before the conversion time and then
+ *                  holds the temperature truncated to the resolution
+ ******************************************************************************/
+static void Test_OneShot(void)
+{
+    static const int32_t temps[] = { 0x17F5, -0x0A11 };
+    uint64_t start, elapsed;
+    uint8_t bits, i;
+    int16_t temp;
+
+    printf("DS1722 one-shot\n");
+
+    for (bits = 8; bits <= 12; bits++)
+    {
+        for (i = 0; i < sizeof(temps) / sizeof(temps[0]); i++)
+        {
+            Test_Setup();
+            DS1722_Model_Constant(&sensor, temps[i]);
+            DS1722_Init(bits, true);
+
+            start = Sim_Now();
+            CHECK(DS1722_StartConversion());
+            CHECK(!DS1722_StartConversion());
+            CHECK(sensor.converting);
+            CHECK(!DS1722_GetResult(&temp));
+
+            Sim_Delay(TEST_MS(DS1722_CONV_MS(bits) - 1));
+            CHECK(!DS1722_GetResult(&temp));
+
+            while (!DS1722_GetResult(&temp))
+            {
+                Sim_Delay(TEST_MS(1) / 10);
+            }
+            elapsed = Sim_Now() - start;
+
+            CHECK_EQ(temp, DS1722_Model_Quantize(temps[i], bits));
+            CHECK_EQ(sensor.conversions, 1);
+            CHECK_EQ(sensor.busyReads, 0);
+            CHECK(!sensor.converting);
+            CHECK(!(sensor.regs[DS1722_REG_CONFIG] & DS1722_CFG_1SHOT));
+            CHECK(elapsed >= TEST_MS(DS1722_CONV_MS(bits)));
+            CHECK(elapsed < TEST_MS(DS1722_CONV_MS(bits) + 1));
+            Test_Errors();
+        }
+
+        printf("  %2u bits %35.1f ms %7d\n", bits,
+               Sim_Microseconds(elapsed) / 1000, temp);
+    }
+
+    // A part faster than the datasheet maximum latches the temperature
+    // early, the driver still waits the maximum
+    Test_Setup();
+    sensor.convPercent = 50;
+    DS1722_Init(12, true);
+    DS1722_Model_Step(&sensor, 20 * 256, 30 * 256,
+                      Sim_Now() + TEST_MS(DS1722_CONV_MS(12) * 3 / 4));
+    CHECK(DS1722_StartConversion());
+    while (!DS1722_GetResult(&temp))
+    {
+        Sim_Delay(TEST_MS(1));
+    }
+    CHECK_EQ(temp, 20 * 256);
+    CHECK_EQ(sensor.busyReads, 0);
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Continuous(void)
+ *
+ * Overview:        Continuous conversion of a triangle wave. Each read
+ *                  returns the latest completed conversion and follows the
+ *                  wave within one conversion time. Shutting down stops
+ *                  after the conversion in progress
+ ******************************************************************************/
+static void Test_Continuous(void)
+{
+    const uint8_t bits = 10;
+    uint64_t conv, start;
+    int32_t lag, worst = 0, last;
+    uint32_t conversions;
+    uint16_t i;
+    int16_t temp;
+
+    printf("DS1722 continuous\n");
+    Test_Setup();
+    DS1722_Model_Triangle(&sensor, 15 * 256, 35 * 256, 60000);
+    conv = DS1722_Model_ConvCycles(&sensor, bits);
+
+    start = Sim_Now();
+    DS1722_Init(bits, false);
+    Sim_Delay(conv);
+
+    // 20 C per 30 s, plus the resolution
+    lag = (20 * 256) * DS1722_CONV_MS(bits) / 30000 + (1 << (16 - bits));
+
+    for (i = 0; i < 240; i++)
+    {
+        Sim_Delay(TEST_MS(250));
+
+        temp = DS1722_Read();
+        CHECK_EQ(temp, DS1722_Model_Quantize(
+                     DS1722_Model_Temperature(&sensor, sensor.lastConversion),
+                     bits));
+
+        last = temp - DS1722_Model_Temperature(&sensor, Sim_Now());
+        last = (last < 0) ? -last : last;
+        worst = (last > worst) ? last : worst;
+    }
+
+    CHECK(worst <= lag);
+    CHECK_EQ(sensor.busyReads, 0);
+    CHECK(sensor.conversions >= (Sim_Now() - start) / conv - 1);
+    CHECK(sensor.conversions <= (Sim_Now() - start) / conv);
+    printf("  %u conversions, worst lag %.3f C\n",
+           (unsigned)sensor.conversions, worst / 256.0);
+
+    // Back to shutdown, the conversion in progress completes
+    DS1722_Init(bits, true);
+    CHECK(sensor.converting);
+    Sim_Delay(conv);
+    DS1722_ReadRegisters(DS1722_REG_CONFIG, (uint8_t *)&temp, 1);
+    CHECK(!sensor.converting);
+    conversions = sensor.conversions;
+    Sim_Delay(10 * conv);
+    DS1722_Read();
+    CHECK_EQ(sensor.conversions, conversions);
+
+    Test_Errors();
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Step(void)
+ *
+ * Overview:        Response of continuous conversion to a temperature step,
+ *                  the new value shows within two conversion times
+ ******************************************************************************/
+static void Test_Step(void)
+{
+    const uint8_t bits = 8;
+    uint64_t step, seen;
+
+    printf("DS1722 step response\n");
+    Test_Setup();
+    DS1722_Init(bits, false);
+
+    step = Sim_Now() + TEST_MS(1000);
+    DS1722_Model_Step(&sensor, 20 * 256, 40 * 256, step);
+
+    while (DS1722_Read() != 40 * 256 && Sim_Now() < step + TEST_MS(1000))
+    {
+        Sim_Delay(TEST_MS(1));
+    }
+    seen = Sim_Now();
+
+    CHECK(seen > step);
+    CHECK(seen - step <= 2 * DS1722_Model_ConvCycles(&sensor, bits) +
+                         TEST_MS(1));
+    printf("  seen after %.1f ms\n", Sim_Microseconds(seen - step) / 1000);
+
+    Test_Errors();
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Test_RecorderExchange(SIM_SPI_DEVICE *dev,
+ *                  uint8_t data)
+ *
+ * Overview:        Records the byte sent and steps the reply sequence
+ ******************************************************************************/
+static uint8_t Test_RecorderExchange(SIM_SPI_DEVICE *dev, uint8_t data)
+{
+    (void)dev;
+
+    if (recorder.count < TEST_DMA_MAX)
+    {
+        recorder.mosi[recorder.count] = data;
+    }
+    recorder.count++;
+
+    recorder.lfsr = (recorder.lfsr >> 1) ^ (-(recorder.lfsr & 1) & 0xB400);
+    return recorder.lfsr;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_RecorderReset(void)
+ *
+ * Overview:        Clears the recording and restarts the reply sequence
+ ******************************************************************************/
+static void Test_RecorderReset(void)
+{
+    recorder.lfsr = 0xACE1;
+    recorder.count = 0;
+    Sim_SPI_StatsReset();
+    Sim_DMA_StatsReset();
+}
+
+/*******************************************************************************
+ * Function:        static void Test_DmaCompare(uint16_t length, bool send,
+ *                  bool receive)
+ *
+ * Overview:        Runs one exchange polled, then the same exchange as a
+ *                  queued transaction and compares what the slave was sent
+ *                  and what was read back
+ ******************************************************************************/
+static void Test_DmaCompare(uint16_t length, bool send, bool receive)
+{
+    static SPI_TRANSACTION t;
+    uint64_t start, polled;
+    uint16_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        dma_tx[i] = i * 7 + length;
+    }
+
+    // Polled
+    Test_RecorderReset();
+    memset(poll_rx, 0, sizeof(poll_rx));
+    start = Sim_Now();
+    SPI_Bus_Begin(&recorder_spi);
+    SPI_Bus_Exchange(send ? dma_tx : NULL, receive ? poll_rx : NULL, length);
+    SPI_Bus_End();
+    polled = Sim_Now() - start;
+
+    memcpy(poll_mosi, recorder.mosi, sizeof(poll_mosi));
+    CHECK_EQ(recorder.count, length);
+    CHECK_EQ(Sim_SPI_Stats()->selects, 1);
+    Test_Errors();
+
+    // Queued, on DMA from SPI_BUS_DMA_MIN bytes
+    Test_RecorderReset();
+    memset(dma_rx, 0, sizeof(dma_rx));
+    t.device = &recorder_spi;
+    t.tx = send ? dma_tx : NULL;
+    t.rx = receive ? dma_rx : NULL;
+    t.length = length;
+    t.done = NULL;
+
+    start = Sim_Now();
+    CHECK(SPI_Bus_Submit(&t));
+    SPI_Bus_Wait(&t);
+
+    CHECK(!t.busy);
+    CHECK(!SPI2_DMA_IsBusy());
+    CHECK_EQ(recorder.count, length);
+    CHECK_EQ(Sim_SPI_Stats()->selects, 1);
+    CHECK(!recorder.dev.selected);
+    Test_Errors();
+
+    CHECK(memcmp(recorder.mosi, poll_mosi, length) == 0);
+    if (receive)
+    {
+        CHECK(memcmp(dma_rx, poll_rx, length) == 0);
+    }
+    else
+    {
+        // Discarded bytes must not land anywhere near the buffer
+        for (i = 0; i < length && dma_rx[i] == 0; i++);
+        CHECK_EQ(i, length);
+    }
+
+    if (length >= SPI_BUS_DMA_MIN)
+    {
+        CHECK_EQ(Sim_DMA_Stats(0)->transfers, length);
+        CHECK_EQ(Sim_DMA_Stats(1)->transfers, length);
+        CHECK_EQ(Sim_DMA_Stats(0)->blocks, 1);
+        CHECK_EQ(Sim_DMA_Stats(1)->blocks, 1);
+        CHECK_EQ(Sim_DMA_Stats(0)->forced, 1);
+    }
+    else
+    {
+        CHECK_EQ(Sim_DMA_Stats(0)->transfers, 0);
+        CHECK_EQ(Sim_DMA_Stats(1)->transfers, 0);
+    }
+
+    if (send && receive)
+    {
+        printf("  %3u bytes  polled %8.1f us  queued %8.1f us\n",
+               length, Sim_Microseconds(polled),
+               Sim_Microseconds(Sim_Now() - start));
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Dma(void)
+ *
+ * Overview:        DMA against polled exchanges either side of
+ *                  SPI_BUS_DMA_MIN, with and without send and receive
+ *                  buffers
+ ******************************************************************************/
+static void Test_Dma(void)
+{
+    static const uint16_t lengths[] = { 1, 15, 16, 17, 100, 256, 300 };
+    uint8_t i;
+
+    printf("SPI2 DMA against polled\n");
+
+    Sim_SPI_Detach(&sensor.dev);
+
+    recorder.dev.csLat = &LATB;
+    recorder.dev.csMask = 1 << 12;
+    recorder.dev.csActiveHigh = false;
+    recorder.dev.mode = SPI_MODE0;
+    recorder.dev.maxHz = 50000000UL;
+    recorder.dev.exchange = Test_RecorderExchange;
+    Sim_SPI_Attach(&recorder.dev);
+    SPI_Bus_DeviceInit(&recorder_spi);
+
+    for (i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++)
+    {
+        Test_DmaCompare(lengths[i], true, true);
+        Test_DmaCompare(lengths[i], false, true);
+        Test_DmaCompare(lengths[i], true, false);
+    }
+
+    Sim_SPI_Detach(&recorder.dev);
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Test_FloatBand(uint8_t band, float c)
+ *
+ * Overview:        Temperature band of the old float code, the classifier
+ *                  rules with the edges and hysteresis in degrees
+ ******************************************************************************/
+static uint8_t Test_FloatBand(uint8_t band, float c)
+{
+    const float edges[] = { TEMP_COLD_Q8_8 / 256.0f, TEMP_HOT_Q8_8 / 256.0f };
+    const float margin = TEMP_HYSTERESIS_Q8_8 / 256.0f;
+
+    while ((band < 2) && (c >= edges[band] + margin))
+    {
+        band++;
+    }
+
+    while ((band > 0) && (c < edges[band - 1] - margin))
+    {
+        band--;
+    }
+
+    return band;
+}
+
+/*******************************************************************************
+ * Function:        static void Test_Fixed(void)
+ *
+ * Overview:        Q8.8 formatting, thresholds and banding against the float
+ *                  code they replace, for every reading the DS1722 can
+ *                  return at any resolution
+ ******************************************************************************/
+static void Test_Fixed(void)
+{
+    static const uint16_t edges[] =
+    {
+        DS1722_ORDERED(TEMP_COLD_Q8_8), DS1722_ORDERED(TEMP_HOT_Q8_8)
+    };
+    static const CLASSIFIER_CONFIG config =
+    {
+        edges, 3, TEMP_HYSTERESIS_Q8_8, 1, 1, 0
+    };
+    CLASSIFIER fixed;
+    char text[DS1722_FORMAT_SIZE];
+    char expect[16];
+    unsigned ties = 0;
+    unsigned steps = 0;
+    unsigned changes = 0;
+    uint8_t band = 0;
+    uint16_t lfsr = 0xACE1;
+    int32_t raw;
+    float c;
+    float f;
+
+    printf("Q8.8 against float\n");
+
+    for (raw = DS1722_Q8_8(-55); raw <= DS1722_Q8_8(125); raw++)
+    {
+        c = raw;
+        c /= 256;
+        f = c * 9 / 5 + 32;
+
+        snprintf(expect, sizeof(expect), "%.2f", c);
+        CHECK_EQ(strcmp(DS1722_Format(text, raw, false), expect), 0);
+
+        // F * 100 is an exact half only when raw is 32 mod 64, there the
+        // float rounding of C * 9 / 5 + 32 picks the digit
+        snprintf(expect, sizeof(expect), "%.2f", f);
+        if ((raw & 63) == 32)
+        {
+            ties++;
+        }
+        else
+        {
+            CHECK_EQ(strcmp(DS1722_Format(text, raw, true), expect), 0);
+        }
+
+        CHECK_EQ(raw < TEMP_COLD_Q8_8, c < TEMP_COLD_Q8_8 / 256.0f);
+        CHECK_EQ(raw > TEMP_HOT_Q8_8, c > TEMP_HOT_Q8_8 / 256.0f);
+
+        if (raw > DS1722_Q8_8(-55))
+        {
+            CHECK(DS1722_ORDERED(raw) > DS1722_ORDERED(raw - 1));
+        }
+    }
+
+    printf("  %u F readings on an exact half of a hundredth\n", ties);
+
+    // Sweep up and down across both edges, then wander at random over the
+    // bands in 1/16 degree steps
+    Classifier_Init(&fixed, &config);
+    raw = DS1722_Q8_8(0);
+    c = 0;
+    CHECK(Classifier_Update(&fixed, DS1722_ORDERED(raw), 0));
+    CHECK_EQ(Classifier_State(&fixed), band);
+
+    for (steps = 1; steps <= 60000; steps++)
+    {
+        if (steps <= 320)
+        {
+            raw += 32;
+        }
+        else if (steps <= 640)
+        {
+            raw -= 32;
+        }
+        else
+        {
+            lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xB400);
+            raw += (lfsr & 1) ? 16 : -16;
+            if (raw < DS1722_Q8_8(5)) raw = DS1722_Q8_8(5);
+            if (raw > DS1722_Q8_8(40)) raw = DS1722_Q8_8(40);
+        }
+
+        c = raw;
+        c /= 256;
+        band = Test_FloatBand(band, c);
+        if (Classifier_Update(&fixed, DS1722_ORDERED(raw), steps))
+        {
+            changes++;
+        }
+        CHECK_EQ(Classifier_State(&fixed), band);
+    }
+
+    CHECK(changes >= 4);
+    printf("  %u readings banded the same, %u changes\n", steps - 1,
+           changes);
+}
+
+/*******************************************************************************
+ * Function:        int main(void)
+ *
+ * Overview:        Runs the tests
+ ******************************************************************************/
+int main(void)
+{
+    Sim_Reset();
+    Sim_SPI_Init();
+    Sim_DMA_Init();
+    SPI2_Initialize();
+    SPI2_DMA_Initialize();
+
+    Test_Init();
+    Test_OneShot();
+    Test_Continuous();
+    Test_Step();
+    Test_Dma();
+    Test_Fixed();
+
+    return TEST_RESULT("Test_SPI");
+}
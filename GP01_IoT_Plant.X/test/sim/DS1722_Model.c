@@ -0,0 +1,457 @@
+/*******************************************************************************
+ * File: DS1722_Model.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Behavioural model of a DS1722 digital thermometer. See
+ *                      DS1722_Model.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "DS1722.h"
+#include "SPI_Bus.h"
+#include "DS1722_Model.h"
+#include <string.h>
+#include <math.h>
+
+/*******************************************************************************
+ * Function:        static DS1722_MODEL *DS1722_Model_Of(SIM_SPI_DEVICE *dev)
+ *
+ * Overview:        Returns the model a bus device belongs to
+ ******************************************************************************/
+static DS1722_MODEL *DS1722_Model_Of(SIM_SPI_DEVICE *dev)
+{
+    return (DS1722_MODEL *)dev;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t DS1722_Model_Bits(uint8_t config)
+ *
+ * Overview:        Resolution set by a configuration register value, the
+ *                  R2..R0 codes above 12 bits also give 12 bits
+ ******************************************************************************/
+static uint8_t DS1722_Model_Bits(uint8_t config)
+{
+    uint8_t bits = ((config >> 1) & 0x07) + 8;
+
+    return (bits > 12) ? 12 : bits;
+}
+
+/*******************************************************************************
+ * Function:        static void DS1722_Model_Begin(DS1722_MODEL *m,
+ *                  uint64_t start)
+ *
+ * Overview:        Starts a conversion at the configured resolution
+ ******************************************************************************/
+static void DS1722_Model_Begin(DS1722_MODEL *m, uint64_t start)
+{
+    m->converting = true;
+    m->convBits = DS1722_Model_Bits(m->regs[DS1722_REG_CONFIG]);
+    m->convStart = start;
+    m->convEnd = start + DS1722_Model_ConvCycles(m, m->convBits);
+}
+
+/*******************************************************************************
+ * Function:        static void DS1722_Model_Update(DS1722_MODEL *m)
+ *
+ * Overview:        Completes the conversions that ended by now, latching the
+ *                  temperature at the end of each. A one-shot conversion
+ *                  clears 1SHOT, in continuous mode the next one follows
+ *                  straight away unless SD was set meanwhile
+ ******************************************************************************/
+static void DS1722_Model_Update(DS1722_MODEL *m)
+{
+    uint64_t now = Sim_Now();
+    int16_t temp;
+
+    while (m->converting && m->convEnd <= now)
+    {
+        temp = DS1722_Model_Quantize(
+                   DS1722_Model_Temperature(m, m->convEnd), m->convBits);
+
+        m->regs[DS1722_REG_TEMP_LSB] = (uint16_t)temp & 0xFF;
+        m->regs[DS1722_REG_TEMP_MSB] = (uint16_t)temp >> 8;
+        m->lastConversion = m->convEnd;
+        m->conversions++;
+
+        if (m->regs[DS1722_REG_CONFIG] & DS1722_CFG_SD)
+        {
+            m->regs[DS1722_REG_CONFIG] &= ~DS1722_CFG_1SHOT;
+            m->converting = false;
+        }
+        else
+        {
+            DS1722_Model_Begin(m, m->convEnd);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void DS1722_Model_Config(DS1722_MODEL *m,
+ *                  uint8_t config)
+ *
+ * Overview:        Configuration register write. Leaving shutdown or a
+ *                  1SHOT request in shutdown starts a conversion, 1SHOT has
+ *                  no effect in continuous mode
+ ******************************************************************************/
+static void DS1722_Model_Config(DS1722_MODEL *m, uint8_t config)
+{
+    config |= DS1722_CFG_FIXED;
+
+    if (!(config & DS1722_CFG_SD))
+    {
+        config &= ~DS1722_CFG_1SHOT;
+    }
+    else if (m->converting &&
+             (m->regs[DS1722_REG_CONFIG] & DS1722_CFG_1SHOT))
+    {
+        config |= DS1722_CFG_1SHOT;
+    }
+
+    m->regs[DS1722_REG_CONFIG] = config;
+    m->configWrites++;
+
+    if (!m->converting &&
+        (!(config & DS1722_CFG_SD) || (config & DS1722_CFG_1SHOT)))
+    {
+        DS1722_Model_Begin(m, Sim_Now());
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void DS1722_Model_Select(SIM_SPI_DEVICE *dev)
+ *
+ * Overview:        CE went active, the first byte is an address
+ ******************************************************************************/
+static void DS1722_Model_Select(SIM_SPI_DEVICE *dev)
+{
+    DS1722_MODEL *m = DS1722_Model_Of(dev);
+
+    m->addressPhase = true;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t DS1722_Model_Exchange(SIM_SPI_DEVICE *dev,
+ *                  uint8_t data)
+ *
+ * Overview:        Address byte then data bytes, the address increments
+ *                  after each. SDO is not driven during the address byte,
+ *                  writes and reads of undefined registers
+ ******************************************************************************/
+static uint8_t DS1722_Model_Exchange(SIM_SPI_DEVICE *dev, uint8_t data)
+{
+    DS1722_MODEL *m = DS1722_Model_Of(dev);
+    uint8_t out = 0xFF;
+
+    DS1722_Model_Update(m);
+
+    if (m->addressPhase)
+    {
+        m->addressPhase = false;
+        m->address = data & ~DS1722_WRITE;
+        m->write = (data & DS1722_WRITE) != 0;
+        return out;
+    }
+
+    if (m->write)
+    {
+        if (m->address == DS1722_REG_CONFIG)
+        {
+            DS1722_Model_Config(m, data);
+        }
+    }
+    else if (m->address < sizeof(m->regs))
+    {
+        out = m->regs[m->address];
+
+        if (m->address != DS1722_REG_CONFIG && m->converting &&
+            (m->regs[DS1722_REG_CONFIG] & DS1722_CFG_SD))
+        {
+            m->busyReads++;
+        }
+    }
+
+    m->address++;
+
+    return out;
+}
+
+/*******************************************************************************
+ * Function:        void DS1722_Model_Init(DS1722_MODEL *m)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model
+ *
+ * Output:          None
+ *
+ * Overview:        Sets up a part in its power on state, shut down at 8 bits,
+ *                  with CE on the pin of the firmware and a constant 25 C
+ *
+ * Usage:           DS1722_Model_Init(&sensor);
+ *                  Sim_SPI_Attach(&sensor.dev);
+ *
+ * Note:            The temperature registers read 0 until the first
+ *                  conversion has completed
+ ******************************************************************************/
+void DS1722_Model_Init(DS1722_MODEL *m)
+{
+    memset(m, 0, sizeof(*m));
+
+    m->dev.csLat = &DS1722_CE_LAT;
+    m->dev.csMask = DS1722_CE_MASK;
+    m->dev.csActiveHigh = true;
+    m->dev.mode = SPI_MODE1;
+    m->dev.maxHz = DS1722_MODEL_MAX_HZ;
+    m->dev.select = DS1722_Model_Select;
+    m->dev.exchange = DS1722_Model_Exchange;
+
+    m->regs[DS1722_REG_CONFIG] = DS1722_CFG_FIXED | DS1722_CFG_SD;
+    m->convPercent = 100;
+
+    DS1722_Model_Constant(m, 25 * 256);
+}
+
+/*******************************************************************************
+ * Function:        void DS1722_Model_Constant(DS1722_MODEL *m, int32_t temp)
+ *
+ * PreCondition:    DS1722_Model_Init() should have been called
+ *
+ * Input:           Model and temperature in Q8.8
+ *
+ * Output:          None
+ *
+ * Overview:        Holds the temperature constant
+ *
+ * Usage:           DS1722_Model_Constant(&sensor, -10 * 256);
+ *
+ * Note:            None
+ ******************************************************************************/
+void DS1722_Model_Constant(DS1722_MODEL *m, int32_t temp)
+{
+    m->wave = DS1722_WAVE_CONSTANT;
+    m->low = temp;
+}
+
+/*******************************************************************************
+ * Function:        void DS1722_Model_Triangle(DS1722_MODEL *m, int32_t low,
+ *                  int32_t high, uint32_t periodMs)
+ *
+ * PreCondition:    DS1722_Model_Init() should have been called
+ *
+ * Input:           Model, temperature range in Q8.8 and period in ms
+ *
+ * Output:          None
+ *
+ * Overview:        Ramps linearly from low to high and back, starting at low
+ *                  at cycle 0
+ *
+ * Usage:           DS1722_Model_Triangle(&sensor, 15 * 256, 35 * 256, 600000);
+ *
+ * Note:            None
+ ******************************************************************************/
+void DS1722_Model_Triangle(DS1722_MODEL *m, int32_t low, int32_t high,
+                           uint32_t periodMs)
+{
+    m->wave = DS1722_WAVE_TRIANGLE;
+    m->low = low;
+    m->high = high;
+    m->period = (uint64_t)FCY * periodMs / 1000;
+}
+
+/*******************************************************************************
+ * Function:        void DS1722_Model_Sine(DS1722_MODEL *m, int32_t low,
+ *                  int32_t high, uint32_t periodMs)
+ *
+ * PreCondition:    DS1722_Model_Init() should have been called
+ *
+ * Input:           Model, temperature range in Q8.8 and period in ms
+ *
+ * Output:          None
+ *
+ * Overview:        Follows a raised cosine from low to high and back,
+ *                  starting at low at cycle 0
+ *
+ * Usage:           DS1722_Model_Sine(&sensor, 18 * 256, 26 * 256, 86400000);
+ *
+ * Note:            None
+ ******************************************************************************/
+void DS1722_Model_Sine(DS1722_MODEL *m, int32_t low, int32_t high,
+                       uint32_t periodMs)
+{
+    DS1722_Model_Triangle(m, low, high, periodMs);
+    m->wave = DS1722_WAVE_SINE;
+}
+
+/*******************************************************************************
+ * Function:        void DS1722_Model_Step(DS1722_MODEL *m, int32_t before,
+ *                  int32_t after, uint64_t at)
+ *
+ * PreCondition:    DS1722_Model_Init() should have been called
+ *
+ * Input:           Model, temperatures in Q8.8 and cycle count of the step
+ *
+ * Output:          None
+ *
+ * Overview:        Jumps from one temperature to another at a given time
+ *
+ * Usage:           DS1722_Model_Step(&sensor, 20 * 256, 40 * 256,
+ *                                    Sim_Now() + FCY);
+ *
+ * Note:            None
+ ******************************************************************************/
+void DS1722_Model_Step(DS1722_MODEL *m, int32_t before, int32_t after,
+                       uint64_t at)
+{
+    m->wave = DS1722_WAVE_STEP;
+    m->low = before;
+    m->high = after;
+    m->stepAt = at;
+}
+
+/*******************************************************************************
+ * Function:        int32_t DS1722_Model_Temperature(const DS1722_MODEL *m,
+ *                  uint64_t now)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model and cycle count
+ *
+ * Output:          Temperature of the waveform in Q8.8, limited to the
+ *                  measuring range
+ *
+ * Overview:        Evaluates the waveform. Set wave to DS1722_WAVE_FUNCTION
+ *                  and function to supply any other shape
+ *
+ * Usage:           temp = DS1722_Model_Temperature(&sensor, Sim_Now());
+ *
+ * Note:            None
+ ******************************************************************************/
+int32_t DS1722_Model_Temperature(const DS1722_MODEL *m, uint64_t now)
+{
+    uint64_t phase;
+    int32_t temp;
+
+    switch (m->wave)
+    {
+    case DS1722_WAVE_TRIANGLE:
+        phase = now % m->period;
+        if (phase * 2 >= m->period)
+        {
+            phase = m->period - phase;
+        }
+        temp = m->low + (int32_t)((int64_t)(m->high - m->low) *
+                                  (int64_t)phase * 2 / (int64_t)m->period);
+        break;
+
+    case DS1722_WAVE_SINE:
+        temp = m->low + (int32_t)lround((m->high - m->low) *
+               (1.0 - cos(2.0 * M_PI * (double)(now % m->period) /
+                          (double)m->period)) / 2.0);
+        break;
+
+    case DS1722_WAVE_STEP:
+        temp = (now < m->stepAt) ? m->low : m->high;
+        break;
+
+    case DS1722_WAVE_FUNCTION:
+        temp = m->function(m, now);
+        break;
+
+    case DS1722_WAVE_CONSTANT:
+    default:
+        temp = m->low;
+        break;
+    }
+
+    if (temp < DS1722_MODEL_MIN)
+    {
+        temp = DS1722_MODEL_MIN;
+    }
+    else if (temp > DS1722_MODEL_MAX)
+    {
+        temp = DS1722_MODEL_MAX;
+    }
+
+    return temp;
+}
+
+/*******************************************************************************
+ * Function:        int16_t DS1722_Model_Quantize(int32_t temp, uint8_t bits)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Temperature in Q8.8 and resolution, 8 to 12 bits
+ *
+ * Output:          Temperature register contents
+ *
+ * Overview:        Drops the bits below the resolution, rounding towards
+ *                  minus infinity as the two's complement register does
+ *
+ * Usage:           expected = DS1722_Model_Quantize(temp, 12);
+ *
+ * Note:            None
+ ******************************************************************************/
+int16_t DS1722_Model_Quantize(int32_t temp, uint8_t bits)
+{
+    return (int16_t)(temp & ~((1L << (16 - bits)) - 1));
+}
+
+/*******************************************************************************
+ * Function:        uint64_t DS1722_Model_ConvCycles(const DS1722_MODEL *m,
+ *                  uint8_t bits)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model and resolution, 8 to 12 bits
+ *
+ * Output:          Conversion time in instruction cycles
+ *
+ * Overview:        DS1722_CONV_MS() scaled by convPercent. Above 100 the
+ *                  part is slower than the datasheet allows, to see how
+ *                  the firmware copes
+ *
+ * Usage:           end = Sim_Now() + DS1722_Model_ConvCycles(&sensor, 12);
+ *
+ * Note:            None
+ ******************************************************************************/
+uint64_t DS1722_Model_ConvCycles(const DS1722_MODEL *m, uint8_t bits)
+{
+    return (uint64_t)FCY * DS1722_CONV_MS(bits) * m->convPercent / 100000;
+}
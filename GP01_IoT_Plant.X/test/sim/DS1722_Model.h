@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * File: DS1722_Model.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Behavioural model of a DS1722 digital thermometer on
+ *                      SPI. Decodes register reads and writes, converts in
+ *                      one-shot or continuous mode with the conversion time of
+ *                      the configured resolution and latches a temperature
+ *                      taken from a configurable waveform.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef DS1722_MODEL_H
+#define DS1722_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Sim_SPI.h"
+
+// Fastest SCK the part allows
+#define DS1722_MODEL_MAX_HZ     5000000UL
+
+// Measuring range, Q8.8
+#define DS1722_MODEL_MIN        (-55 * 256)
+#define DS1722_MODEL_MAX        (120 * 256)
+
+/*******************************************************************************
+ * Temperature waveforms, all in Q8.8
+ ******************************************************************************/
+typedef enum
+{
+    DS1722_WAVE_CONSTANT,           // low
+    DS1722_WAVE_TRIANGLE,           // low up to high and back each period
+    DS1722_WAVE_SINE,               // low to high and back each period
+    DS1722_WAVE_STEP,               // low, then high from stepAt on
+    DS1722_WAVE_FUNCTION            // function(model, cycle count)
+} DS1722_WAVE;
+
+/*******************************************************************************
+ * Model state
+ ******************************************************************************/
+typedef struct DS1722_MODEL
+{
+    SIM_SPI_DEVICE dev;
+
+    // Waveform
+    DS1722_WAVE wave;
+    int32_t low, high;
+    uint64_t period;                // cycles, triangle and sine
+    uint64_t stepAt;                // cycle count, step
+    int32_t (*function)(const struct DS1722_MODEL *m, uint64_t now);
+
+    // Conversion time in percent of the datasheet maximum
+    uint16_t convPercent;
+
+    // Registers
+    uint8_t regs[3];                // configuration, temperature LSB, MSB
+
+    // Transaction state
+    bool addressPhase;              // next byte is the address byte
+    uint8_t address;
+    bool write;
+
+    // Conversion state
+    bool converting;
+    uint8_t convBits;               // resolution of the running conversion
+    uint64_t convStart;
+    uint64_t convEnd;
+    uint64_t lastConversion;        // end of the latest conversion
+
+    // Statistics
+    uint32_t configWrites;
+    uint32_t conversions;
+    uint32_t busyReads;             // temperature read during a one-shot
+} DS1722_MODEL;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void DS1722_Model_Init(DS1722_MODEL *m);
+void DS1722_Model_Constant(DS1722_MODEL *m, int32_t temp);
+void DS1722_Model_Triangle(DS1722_MODEL *m, int32_t low, int32_t high,
+                           uint32_t periodMs);
+void DS1722_Model_Sine(DS1722_MODEL *m, int32_t low, int32_t high,
+                       uint32_t periodMs);
+void DS1722_Model_Step(DS1722_MODEL *m, int32_t before, int32_t after,
+                       uint64_t at);
+int32_t DS1722_Model_Temperature(const DS1722_MODEL *m, uint64_t now);
+int16_t DS1722_Model_Quantize(int32_t temp, uint8_t bits);
+uint64_t DS1722_Model_ConvCycles(const DS1722_MODEL *m, uint8_t bits);
+
+#endif  // DS1722_MODEL_H
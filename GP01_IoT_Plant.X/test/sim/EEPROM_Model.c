@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * File: EEPROM_Model.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Behavioural model of a 24LC series I2C EEPROM. See
+ *                      EEPROM_Model.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "EEPROM_Model.h"
+#include <string.h>
+
+/*******************************************************************************
+ * Function:        static EEPROM_MODEL *EEPROM_Model_Of(SIM_I2C_DEVICE *dev)
+ *
+ * Overview:        Returns the model a bus device belongs to
+ ******************************************************************************/
+static EEPROM_MODEL *EEPROM_Model_Of(SIM_I2C_DEVICE *dev)
+{
+    return (EEPROM_MODEL *)dev;
+}
+
+/*******************************************************************************
+ * Function:        static bool EEPROM_Model_Select(SIM_I2C_DEVICE *dev,
+ *                  uint8_t address, bool read)
+ *
+ * Overview:        Control byte. Low density parts take the block (address
+ *                  bits 10..8) from it, high density parts expect two
+ *                  address bytes. Refused during a write cycle
+ ******************************************************************************/
+static bool EEPROM_Model_Select(SIM_I2C_DEVICE *dev, uint8_t address,
+                                bool read)
+{
+    EEPROM_MODEL *m = EEPROM_Model_Of(dev);
+
+    if (EEPROM_Model_Busy(m))
+    {
+        m->busyNacks++;
+        return false;
+    }
+
+    if (!m->highDensity)
+    {
+        m->address = ((uint32_t)(address & 0x07) << 8) |
+                     (m->address & 0xFF);
+    }
+
+    m->addressBytes = read ? 0 : (m->highDensity ? 2 : 1);
+    m->latched = 0;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static bool EEPROM_Model_Write(SIM_I2C_DEVICE *dev,
+ *                  uint8_t data)
+ *
+ * Overview:        Word address bytes then data, which goes into the page
+ *                  latch at the address pointer. The pointer wraps at the
+ *                  page boundary, overwriting earlier bytes of the latch
+ ******************************************************************************/
+static bool EEPROM_Model_Write(SIM_I2C_DEVICE *dev, uint8_t data)
+{
+    EEPROM_MODEL *m = EEPROM_Model_Of(dev);
+    uint32_t offset;
+
+    if (m->addressBytes)
+    {
+        if (m->highDensity && m->addressBytes == 2)
+        {
+            m->address = (uint32_t)data << 8;
+        }
+        else
+        {
+            m->address = (m->address & ~0xFFUL) | data;
+        }
+        m->address %= m->size;
+        m->addressBytes--;
+        return true;
+    }
+
+    if (m->latched == 0)
+    {
+        m->latchPage = m->address - (m->address % m->pageSize);
+        m->latchStart = m->address - m->latchPage;
+        memcpy(m->latch, &m->memory[m->latchPage], m->pageSize);
+    }
+
+    offset = m->address - m->latchPage;
+    m->latch[offset] = data;
+    m->latched++;
+
+    m->address = m->latchPage + (offset + 1) % m->pageSize;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t EEPROM_Model_Read(SIM_I2C_DEVICE *dev)
+ *
+ * Overview:        Sequential read, the pointer runs through the whole
+ *                  array and wraps at the end
+ ******************************************************************************/
+static uint8_t EEPROM_Model_Read(SIM_I2C_DEVICE *dev)
+{
+    EEPROM_MODEL *m = EEPROM_Model_Of(dev);
+    uint8_t data = m->memory[m->address];
+
+    m->address = (m->address + 1) % m->size;
+    m->bytesRead++;
+
+    return data;
+}
+
+/*******************************************************************************
+ * Function:        static void EEPROM_Model_Stop(SIM_I2C_DEVICE *dev)
+ *
+ * Overview:        Programs the page latch if data was written and starts
+ *                  the write cycle
+ ******************************************************************************/
+static void EEPROM_Model_Stop(SIM_I2C_DEVICE *dev)
+{
+    EEPROM_MODEL *m = EEPROM_Model_Of(dev);
+
+    if (m->latched == 0)
+    {
+        return;
+    }
+
+    // Bytes past the end of the page went to its start
+    if (m->latchStart + m->latched > m->pageSize)
+    {
+        m->rollovers++;
+    }
+
+    memcpy(&m->memory[m->latchPage], m->latch, m->pageSize);
+
+    if (m->wear)
+    {
+        m->wear[m->latchPage / m->pageSize]++;
+    }
+
+    m->pageWrites++;
+    m->bytesWritten += m->latched;
+    m->latched = 0;
+    m->busyUntil = Sim_Now() + m->writeCycle;
+}
+
+/*******************************************************************************
+ * Function:        void EEPROM_Model_Init(EEPROM_MODEL *m, uint8_t *memory,
+ *                  uint32_t size, uint16_t pageSize, bool highDensity)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model, array contents, size in bytes, page size and
+ *                  addressing (false: 24LC01B..24LC16B, true: 24LC32 up)
+ *
+ * Output:          None
+ *
+ * Overview:        Sets up the model with A2..A0 tied low. Low density parts
+ *                  answer the eight addresses 0x50..0x57
+ *
+ * Usage:           EEPROM_Model_Init(&ee, mem, 2048, 16, false);
+ *                  Sim_I2C_Attach(&ee.dev);
+ *
+ * Note:            The array is used as is, fill it with 0xFF for a blank
+ *                  part
+ ******************************************************************************/
+void EEPROM_Model_Init(EEPROM_MODEL *m, uint8_t *memory, uint32_t size,
+                       uint16_t pageSize, bool highDensity)
+{
+    memset(m, 0, sizeof(*m));
+
+    m->dev.address = 0x50;
+    m->dev.mask = highDensity ? 0x7F : 0x78;
+    m->dev.select = EEPROM_Model_Select;
+    m->dev.write = EEPROM_Model_Write;
+    m->dev.read = EEPROM_Model_Read;
+    m->dev.stop = EEPROM_Model_Stop;
+
+    m->memory = memory;
+    m->size = size;
+    m->pageSize = pageSize;
+    m->highDensity = highDensity;
+    m->writeCycle = (uint64_t)FCY * EEPROM_MODEL_TWC_MS / 1000;
+}
+
+/*******************************************************************************
+ * Function:        bool EEPROM_Model_Busy(const EEPROM_MODEL *m)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model
+ *
+ * Output:          true during a write cycle
+ *
+ * Overview:        Returns the state of the internal write cycle
+ *
+ * Usage:           while (EEPROM_Model_Busy(&ee)) ...
+ *
+ * Note:            None
+ ******************************************************************************/
+bool EEPROM_Model_Busy(const EEPROM_MODEL *m)
+{
+    return Sim_Now() < m->busyUntil;
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * File: EEPROM_Model.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Behavioural model of a 24LC series I2C EEPROM. Page
+ *                      writes go through a page latch that wraps at the page
+ *                      boundary and are programmed after the stop condition,
+ *                      the part does not acknowledge its address during the
+ *                      write cycle.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef EEPROM_MODEL_H
+#define EEPROM_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Sim_I2C.h"
+
+// Largest page of the family, 24LC512
+#define EEPROM_MODEL_PAGE_MAX   128
+
+// Worst case write cycle time of the family, ms
+#define EEPROM_MODEL_TWC_MS     5
+
+/*******************************************************************************
+ * Model state
+ ******************************************************************************/
+typedef struct
+{
+    SIM_I2C_DEVICE dev;
+
+    // Geometry
+    uint8_t *memory;
+    uint32_t size;
+    uint16_t pageSize;
+    bool highDensity;               // two address bytes, else block bits
+    uint64_t writeCycle;            // write cycle time in cycles
+
+    // Transaction state
+    uint8_t addressBytes;           // address bytes still expected
+    uint32_t address;               // internal address pointer
+    uint8_t latch[EEPROM_MODEL_PAGE_MAX];
+    uint32_t latchPage;             // address of the latched page
+    uint16_t latchStart;            // page offset of the first data byte
+    uint16_t latched;               // data bytes received this transaction
+    uint64_t busyUntil;             // end of the write cycle
+
+    // Statistics
+    uint32_t pageWrites;            // write cycles
+    uint32_t bytesWritten;
+    uint32_t bytesRead;
+    uint32_t rollovers;             // writes that wrapped within the page
+    uint32_t busyNacks;             // addresses refused during write cycles
+    uint32_t *wear;                 // write cycles per page, may be NULL
+} EEPROM_MODEL;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void EEPROM_Model_Init(EEPROM_MODEL *m, uint8_t *memory, uint32_t size,
+                       uint16_t pageSize, bool highDensity);
+bool EEPROM_Model_Busy(const EEPROM_MODEL *m);
+
+#endif  // EEPROM_MODEL_H
@@ -0,0 +1,419 @@
+/*******************************************************************************
+ * File: Flash_Model.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Behavioural model of a 25 series SPI NOR flash. See
+ *                      Flash_Model.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Flash_Log.h"
+#include "SPI_Bus.h"
+#include "Flash_Model.h"
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Commands decoded
+#define FLASH_MODEL_WREN        0x06
+#define FLASH_MODEL_RDSR        0x05
+#define FLASH_MODEL_READ        0x03
+#define FLASH_MODEL_PP          0x02
+#define FLASH_MODEL_SE          0x20
+#define FLASH_MODEL_JEDEC       0x9F
+
+// Status register
+#define FLASH_MODEL_WIP         0x01
+#define FLASH_MODEL_WEL         0x02
+
+// Typical page program and sector erase times in us
+#define FLASH_MODEL_PROGRAM_US  700
+#define FLASH_MODEL_ERASE_US    45000
+
+/*******************************************************************************
+ * Function:        static FLASH_MODEL *Flash_Model_Of(SIM_SPI_DEVICE *dev)
+ *
+ * Overview:        Returns the model a bus device belongs to
+ ******************************************************************************/
+static FLASH_MODEL *Flash_Model_Of(SIM_SPI_DEVICE *dev)
+{
+    return (FLASH_MODEL *)dev;
+}
+
+/*******************************************************************************
+ * Function:        static void Flash_Model_Update(FLASH_MODEL *m)
+ *
+ * Overview:        Completes an erase whose time is up
+ ******************************************************************************/
+static void Flash_Model_Update(FLASH_MODEL *m)
+{
+    if (m->erasing && Sim_Now() >= m->busyUntil)
+    {
+        memset(&m->mem[m->eraseAddress], 0xFF, FLASH_MODEL_SECTOR);
+        m->erasing = false;
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void Flash_Model_Select(SIM_SPI_DEVICE *dev)
+ *
+ * Overview:        /CS went low, the first byte is a command
+ ******************************************************************************/
+static void Flash_Model_Select(SIM_SPI_DEVICE *dev)
+{
+    FLASH_MODEL *m = Flash_Model_Of(dev);
+
+    m->count = 0;
+    m->address = 0;
+    m->pageBytes = 0;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Flash_Model_Exchange(SIM_SPI_DEVICE *dev,
+ *                  uint8_t data)
+ *
+ * Overview:        Command byte, 24 bit address then data. Only the status
+ *                  register answers while the part is busy
+ ******************************************************************************/
+static uint8_t Flash_Model_Exchange(SIM_SPI_DEVICE *dev, uint8_t data)
+{
+    FLASH_MODEL *m = Flash_Model_Of(dev);
+    uint16_t n = m->count++;
+    bool busy;
+
+    if (m->dead)
+    {
+        return 0xFF;
+    }
+
+    busy = Flash_Model_Busy(m);
+
+    if (n == 0)
+    {
+        m->command = data;
+        if (busy && data != FLASH_MODEL_RDSR)
+        {
+            m->busyCommands++;
+        }
+        return 0xFF;
+    }
+
+    if (m->command == FLASH_MODEL_RDSR)
+    {
+        return (busy ? FLASH_MODEL_WIP : 0) | (m->wel ? FLASH_MODEL_WEL : 0);
+    }
+
+    if (busy)
+    {
+        return 0xFF;
+    }
+
+    if (m->command == FLASH_MODEL_JEDEC)
+    {
+        return (n <= sizeof(m->jedec)) ? m->jedec[n - 1] : 0xFF;
+    }
+
+    if (n <= 3)
+    {
+        m->address = (m->address << 8) | data;
+        return 0xFF;
+    }
+
+    switch (m->command)
+    {
+    case FLASH_MODEL_READ:
+        m->readBytes++;
+        return m->mem[m->address++ % FLASH_MODEL_SIZE];
+
+    case FLASH_MODEL_PP:
+        m->page[m->pageBytes++ % FLASH_MODEL_PAGE] = data;
+        break;
+
+    default:
+        break;
+    }
+
+    return 0xFF;
+}
+
+/*******************************************************************************
+ * Function:        static void Flash_Model_Program(FLASH_MODEL *m)
+ *
+ * Overview:        Programs the bytes clocked in, wrapping within the page.
+ *                  Power fails once cutBytes bytes have been programmed
+ ******************************************************************************/
+static void Flash_Model_Program(FLASH_MODEL *m)
+{
+    uint32_t base = (m->address % FLASH_MODEL_SIZE) & ~(FLASH_MODEL_PAGE - 1);
+    uint16_t length = (m->pageBytes > FLASH_MODEL_PAGE) ?
+                      FLASH_MODEL_PAGE : m->pageBytes;
+    uint16_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        uint32_t a = base + ((m->address + i) & (FLASH_MODEL_PAGE - 1));
+        uint8_t data = m->page[i];
+
+        if (m->programBytes == m->cutBytes)
+        {
+            m->dead = true;
+            return;
+        }
+
+        if ((m->mem[a] & data) != data)
+        {
+            m->overwrites++;
+        }
+        m->mem[a] &= data;
+        m->programBytes++;
+    }
+
+    m->programs++;
+    m->busyUntil = Sim_Now() + m->programCycles;
+}
+
+/*******************************************************************************
+ * Function:        static void Flash_Model_Deselect(SIM_SPI_DEVICE *dev)
+ *
+ * Overview:        /CS went high, write enable, program and erase take
+ *                  effect. Program and erase need the write enable latch
+ *                  and clear it
+ ******************************************************************************/
+static void Flash_Model_Deselect(SIM_SPI_DEVICE *dev)
+{
+    FLASH_MODEL *m = Flash_Model_Of(dev);
+
+    if (m->dead || m->count == 0 || Flash_Model_Busy(m))
+    {
+        return;
+    }
+
+    switch (m->command)
+    {
+    case FLASH_MODEL_WREN:
+        m->wel = true;
+        return;
+
+    case FLASH_MODEL_PP:
+    case FLASH_MODEL_SE:
+        if (m->count < 4)
+        {
+            return;
+        }
+        if (!m->wel)
+        {
+            m->unlatched++;
+            return;
+        }
+        break;
+
+    default:
+        return;
+    }
+
+    m->wel = false;
+
+    if (m->command == FLASH_MODEL_PP)
+    {
+        Flash_Model_Program(m);
+    }
+    else
+    {
+        m->erasing = true;
+        m->eraseAddress = (m->address % FLASH_MODEL_SIZE) &
+                          ~(FLASH_MODEL_SECTOR - 1);
+        m->busyUntil = Sim_Now() + m->eraseCycles;
+        m->erases++;
+    }
+}
+
+/*******************************************************************************
+ * Function:        bool Flash_Model_Open(FLASH_MODEL *m, const char *path,
+ *                  bool blank)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model, backing file and whether to erase it
+ *
+ * Output:          false if the file could not be mapped
+ *
+ * Overview:        Powers up a part with the contents of the file, created
+ *                  erased if it does not exist, with /CS on the pin of the
+ *                  firmware and typical program and erase times
+ *
+ * Usage:           Flash_Model_Open(&flash, "Test_Flash.bin", true);
+ *                  Sim_SPI_Attach(&flash.dev);
+ *
+ * Note:            Programs reach the file as they happen, Flash_Model_Close
+ *                  then Flash_Model_Open again is a power cycle
+ ******************************************************************************/
+bool Flash_Model_Open(FLASH_MODEL *m, const char *path, bool blank)
+{
+    struct stat st;
+
+    memset(m, 0, sizeof(*m));
+
+    m->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (m->fd < 0 || fstat(m->fd, &st) != 0)
+    {
+        return false;
+    }
+
+    if (st.st_size != FLASH_MODEL_SIZE)
+    {
+        blank = true;
+        if (ftruncate(m->fd, FLASH_MODEL_SIZE) != 0)
+        {
+            close(m->fd);
+            return false;
+        }
+    }
+
+    m->mem = mmap(NULL, FLASH_MODEL_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+                  m->fd, 0);
+    if (m->mem == MAP_FAILED)
+    {
+        close(m->fd);
+        return false;
+    }
+
+    if (blank)
+    {
+        memset(m->mem, 0xFF, FLASH_MODEL_SIZE);
+    }
+
+    m->dev.csLat = &FLASH_LOG_CS_LAT;
+    m->dev.csMask = FLASH_LOG_CS_MASK;
+    m->dev.csActiveHigh = false;
+    m->dev.mode = SPI_MODE0;
+    m->dev.maxHz = FLASH_MODEL_MAX_HZ;
+    m->dev.select = Flash_Model_Select;
+    m->dev.exchange = Flash_Model_Exchange;
+    m->dev.deselect = Flash_Model_Deselect;
+
+    m->jedec[0] = 0xEF;
+    m->jedec[1] = 0x40;
+    m->jedec[2] = 0x14;
+
+    m->programCycles = (uint64_t)FCY * FLASH_MODEL_PROGRAM_US / 1000000;
+    m->eraseCycles = (uint64_t)FCY * FLASH_MODEL_ERASE_US / 1000000;
+    m->cutBytes = FLASH_MODEL_NO_CUT;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        void Flash_Model_Close(FLASH_MODEL *m)
+ *
+ * PreCondition:    Flash_Model_Open() should have succeeded
+ *
+ * Input:           Model
+ *
+ * Output:          None
+ *
+ * Overview:        Writes the contents back to the file and unmaps it. An
+ *                  erase still running is cut short
+ *
+ * Usage:           Flash_Model_Close(&flash);
+ *
+ * Note:            Detach the model from the bus first
+ ******************************************************************************/
+void Flash_Model_Close(FLASH_MODEL *m)
+{
+    Flash_Model_PowerFail(m);
+
+    msync(m->mem, FLASH_MODEL_SIZE, MS_SYNC);
+    munmap(m->mem, FLASH_MODEL_SIZE);
+    close(m->fd);
+    m->mem = NULL;
+}
+
+/*******************************************************************************
+ * Function:        void Flash_Model_PowerFail(FLASH_MODEL *m)
+ *
+ * PreCondition:    Flash_Model_Open() should have succeeded
+ *
+ * Input:           Model
+ *
+ * Output:          None
+ *
+ * Overview:        Removes power. An erase in progress leaves the first
+ *                  half of its sector erased and the rest as it was
+ *
+ * Usage:           Flash_Model_PowerFail(&flash);
+ *
+ * Note:            The part reads 0xFF until it is opened again
+ ******************************************************************************/
+void Flash_Model_PowerFail(FLASH_MODEL *m)
+{
+    Flash_Model_Update(m);
+
+    if (m->erasing)
+    {
+        memset(&m->mem[m->eraseAddress], 0xFF, FLASH_MODEL_SECTOR / 2);
+        m->erasing = false;
+    }
+
+    m->dead = true;
+}
+
+/*******************************************************************************
+ * Function:        bool Flash_Model_Busy(FLASH_MODEL *m)
+ *
+ * PreCondition:    Flash_Model_Open() should have succeeded
+ *
+ * Input:           Model
+ *
+ * Output:          true while a program or erase runs, or the part hangs
+ *
+ * Overview:        Returns the WIP status bit
+ *
+ * Usage:           while (Flash_Model_Busy(&flash)) Sim_Delay(FCY / 1000);
+ *
+ * Note:            None
+ ******************************************************************************/
+bool Flash_Model_Busy(FLASH_MODEL *m)
+{
+    Flash_Model_Update(m);
+
+    return m->stuck || Sim_Now() < m->busyUntil;
+}
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * File: Flash_Model.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Behavioural model of a 25 series SPI NOR flash, backed
+ *                      by a file so its contents survive a simulated reset.
+ *                      Decodes JEDEC ID, status, read, write enable, page
+ *                      program and sector erase, keeps the part busy for the
+ *                      program and erase times and only ever clears bits when
+ *                      programming. Power can be cut before a chosen programmed
+ *                      byte or during an erase, and the part can be made to
+ *                      hang busy.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef FLASH_MODEL_H
+#define FLASH_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Sim_SPI.h"
+
+// W25Q80, 1 MB
+#define FLASH_MODEL_SIZE        0x100000UL
+#define FLASH_MODEL_SECTOR      4096U
+#define FLASH_MODEL_PAGE        256U
+
+// Fastest SCK for the READ command
+#define FLASH_MODEL_MAX_HZ      50000000UL
+
+// No power cut
+#define FLASH_MODEL_NO_CUT      UINT32_MAX
+
+/*******************************************************************************
+ * Model state
+ ******************************************************************************/
+typedef struct
+{
+    SIM_SPI_DEVICE dev;
+
+    // Contents, the file mapped into memory
+    int fd;
+    uint8_t *mem;
+    uint8_t jedec[3];
+
+    // Program and erase times in cycles
+    uint64_t programCycles;
+    uint64_t eraseCycles;
+
+    // Transaction state
+    uint8_t command;
+    uint32_t address;
+    uint16_t count;                 // bytes since chip select
+    uint8_t page[FLASH_MODEL_PAGE];
+    uint16_t pageBytes;
+
+    // Device state
+    bool wel;                       // write enable latch
+    uint64_t busyUntil;
+    bool erasing;                   // erase of eraseAddress pending
+    uint32_t eraseAddress;
+
+    // Faults
+    uint32_t cutBytes;              // power fails before programBytes gets here
+    bool dead;                      // no power, SO floats high
+    bool stuck;                     // WIP never clears
+
+    // Statistics
+    uint32_t readBytes;
+    uint32_t programs;
+    uint32_t programBytes;
+    uint32_t erases;
+    uint32_t overwrites;            // bytes programmed over cleared bits
+    uint32_t busyCommands;          // commands other than RDSR while busy
+    uint32_t unlatched;             // program or erase without WREN
+} FLASH_MODEL;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+bool Flash_Model_Open(FLASH_MODEL *m, const char *path, bool blank);
+void Flash_Model_Close(FLASH_MODEL *m);
+void Flash_Model_PowerFail(FLASH_MODEL *m);
+bool Flash_Model_Busy(FLASH_MODEL *m);
+
+#endif  // FLASH_MODEL_H
@@ -0,0 +1,370 @@
+/*******************************************************************************
+ * File: SSD1306_Model.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Behavioural model of an SSD1306 OLED controller. See
+ *                      SSD1306_Model.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "SSD1306_Model.h"
+#include <stdio.h>
+#include <string.h>
+
+// Control byte bits
+#define SSD1306_MODEL_CO        0x80    // one byte then another control byte
+#define SSD1306_MODEL_DC        0x40    // bytes are display data
+
+/*******************************************************************************
+ * Function:        static SSD1306_MODEL *SSD1306_Model_Of(
+ *                  SIM_I2C_DEVICE *dev)
+ *
+ * Overview:        Returns the model a bus device belongs to
+ ******************************************************************************/
+static SSD1306_MODEL *SSD1306_Model_Of(SIM_I2C_DEVICE *dev)
+{
+    return (SSD1306_MODEL *)dev;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t SSD1306_Model_Arguments(uint8_t cmd)
+ *
+ * Overview:        Number of argument bytes following a command byte
+ ******************************************************************************/
+static uint8_t SSD1306_Model_Arguments(uint8_t cmd)
+{
+    switch (cmd)
+    {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void SSD1306_Model_Command(SSD1306_MODEL *m)
+ *
+ * Overview:        Executes a complete command held in m->cmd
+ ******************************************************************************/
+static void SSD1306_Model_Command(SSD1306_MODEL *m)
+{
+    uint8_t c = m->cmd[0];
+
+    m->commands++;
+
+    if (c <= 0x0F && m->memoryMode == 2)
+    {
+        m->col = (m->col & 0xF0) | c;
+    }
+    else if (c >= 0x10 && c <= 0x1F && m->memoryMode == 2)
+    {
+        m->col = ((c & 0x07) << 4) | (m->col & 0x0F);
+    }
+    else if (c >= 0x40 && c <= 0x7F)
+    {
+        m->startLine = c & 0x3F;
+    }
+    else if (c >= 0xB0 && c <= 0xB7)
+    {
+        m->page = c & 0x07;
+    }
+    else
+    {
+        switch (c)
+        {
+        case 0x20: m->memoryMode = m->cmd[1] & 0x03; break;
+        case 0x21:
+            m->colStart = m->cmd[1] & 0x7F;
+            m->colEnd = m->cmd[2] & 0x7F;
+            m->col = m->colStart;
+            break;
+        case 0x22:
+            m->pageStart = m->cmd[1] & 0x07;
+            m->pageEnd = m->cmd[2] & 0x07;
+            m->page = m->pageStart;
+            break;
+        case 0x81: m->contrast = m->cmd[1]; break;
+        case 0x8D: m->chargePump = (m->cmd[1] & 0x04) != 0; break;
+        case 0xA0: case 0xA1: m->segRemap = c & 1; break;
+        case 0xA4: case 0xA5: m->entireOn = c & 1; break;
+        case 0xA6: case 0xA7: m->inverse = c & 1; break;
+        case 0xA8: m->multiplex = (m->cmd[1] & 0x3F) + 1; break;
+        case 0xAE: case 0xAF: m->displayOn = c & 1; break;
+        case 0xC0: case 0xC8: m->comRemap = (c & 0x08) != 0; break;
+        // Timing, scrolling and analogue settings without visible effect
+        case 0x26: case 0x27: case 0x29: case 0x2A: case 0x2E: case 0x2F:
+        case 0xA3: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        case 0xE3:
+            break;
+        default:
+            m->unknown++;
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void SSD1306_Model_Data(SSD1306_MODEL *m,
+ *                  uint8_t data)
+ *
+ * Overview:        Stores a display data byte and advances the address
+ *                  pointer as the selected addressing mode does
+ ******************************************************************************/
+static void SSD1306_Model_Data(SSD1306_MODEL *m, uint8_t data)
+{
+    m->gddram[m->page][m->col] = data;
+    m->dataBytes++;
+
+    switch (m->memoryMode)
+    {
+    case 0:     // horizontal
+        if (m->col++ >= m->colEnd)
+        {
+            m->col = m->colStart;
+            m->page = (m->page >= m->pageEnd) ? m->pageStart : m->page + 1;
+        }
+        break;
+    case 1:     // vertical
+        if (m->page++ >= m->pageEnd)
+        {
+            m->page = m->pageStart;
+            m->col = (m->col >= m->colEnd) ? m->colStart : m->col + 1;
+        }
+        break;
+    default:    // page, wraps within the page
+        m->col = (m->col + 1) & 0x7F;
+        break;
+    }
+}
+
+/*******************************************************************************
+ * Function:        static bool SSD1306_Model_Select(SIM_I2C_DEVICE *dev,
+ *                  uint8_t address, bool read)
+ *
+ * Overview:        Address byte, a control byte follows. Reads are not
+ *                  supported over I2C and are not acknowledged
+ ******************************************************************************/
+static bool SSD1306_Model_Select(SIM_I2C_DEVICE *dev, uint8_t address,
+                                 bool read)
+{
+    SSD1306_MODEL *m = SSD1306_Model_Of(dev);
+
+    (void)address;
+    m->control = true;
+
+    return !read;
+}
+
+/*******************************************************************************
+ * Function:        static bool SSD1306_Model_Write(SIM_I2C_DEVICE *dev,
+ *                  uint8_t byte)
+ *
+ * Overview:        Control byte, command byte or display data byte
+ ******************************************************************************/
+static bool SSD1306_Model_Write(SIM_I2C_DEVICE *dev, uint8_t byte)
+{
+    SSD1306_MODEL *m = SSD1306_Model_Of(dev);
+
+    if (m->control)
+    {
+        m->data = (byte & SSD1306_MODEL_DC) != 0;
+        m->single = (byte & SSD1306_MODEL_CO) != 0;
+        m->control = false;
+        return true;
+    }
+
+    if (m->data)
+    {
+        SSD1306_Model_Data(m, byte);
+    }
+    else
+    {
+        // Arguments may arrive in later transactions, as the driver sends
+        // every command byte on its own
+        m->cmd[m->cmdLength++] = byte;
+
+        if (m->cmdLength > SSD1306_Model_Arguments(m->cmd[0]))
+        {
+            SSD1306_Model_Command(m);
+            m->cmdLength = 0;
+        }
+    }
+
+    m->control = m->single;
+
+    return true;
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t SSD1306_Model_Read(SIM_I2C_DEVICE *dev)
+ *
+ * Overview:        Never called, reads are not acknowledged
+ ******************************************************************************/
+static uint8_t SSD1306_Model_Read(SIM_I2C_DEVICE *dev)
+{
+    (void)dev;
+
+    return 0xFF;
+}
+
+/*******************************************************************************
+ * Function:        void SSD1306_Model_Init(SSD1306_MODEL *m,
+ *                  uint8_t address)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model and 7-bit address (0x3C or 0x3D)
+ *
+ * Output:          None
+ *
+ * Overview:        Puts the model in its reset state, display off and RAM
+ *                  cleared, and sets up its bus device
+ *
+ * Usage:           SSD1306_Model_Init(&oled, 0x3C);
+ *                  Sim_I2C_Attach(&oled.dev);
+ *
+ * Note:            Real parts power up with random RAM contents
+ ******************************************************************************/
+void SSD1306_Model_Init(SSD1306_MODEL *m, uint8_t address)
+{
+    memset(m, 0, sizeof(*m));
+
+    m->dev.address = address;
+    m->dev.mask = 0x7F;
+    m->dev.select = SSD1306_Model_Select;
+    m->dev.write = SSD1306_Model_Write;
+    m->dev.read = SSD1306_Model_Read;
+
+    m->contrast = 0x7F;
+    m->memoryMode = 2;
+    m->colEnd = SSD1306_MODEL_WIDTH - 1;
+    m->pageEnd = SSD1306_MODEL_PAGES - 1;
+    m->multiplex = SSD1306_MODEL_HEIGHT;
+}
+
+/*******************************************************************************
+ * Function:        bool SSD1306_Model_Pixel(const SSD1306_MODEL *m,
+ *                  uint8_t x, uint8_t y)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model and panel coordinates, 0,0 top left
+ *
+ * Output:          true if the pixel is lit
+ *
+ * Overview:        Maps a panel position to display RAM through the start
+ *                  line, segment remap and COM scan direction, then applies
+ *                  display on, entire display on and inverse settings
+ *
+ * Usage:           lit = SSD1306_Model_Pixel(&oled, 10, 20);
+ *
+ * Note:            Panels are taken to be mounted like the common modules,
+ *                  which need 0xA1 and 0xC8 to show the RAM upright
+ ******************************************************************************/
+bool SSD1306_Model_Pixel(const SSD1306_MODEL *m, uint8_t x, uint8_t y)
+{
+    uint8_t col = m->segRemap ? x : SSD1306_MODEL_WIDTH - 1 - x;
+    uint8_t row = m->comRemap ? y : SSD1306_MODEL_HEIGHT - 1 - y;
+    bool lit;
+
+    if (!m->displayOn || y >= m->multiplex)
+    {
+        return false;
+    }
+
+    row = (row + m->startLine) % SSD1306_MODEL_HEIGHT;
+    lit = m->entireOn || ((m->gddram[row / 8][col] >> (row & 7)) & 1);
+
+    return lit != m->inverse;
+}
+
+/*******************************************************************************
+ * Function:        bool SSD1306_Model_WritePBM(const SSD1306_MODEL *m,
+ *                  const char *path)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Model and output file name
+ *
+ * Output:          false if the file could not be written
+ *
+ * Overview:        Saves what the panel shows as a binary PBM image, lit
+ *                  pixels black
+ *
+ * Usage:           SSD1306_Model_WritePBM(&oled, "build/oled.pbm");
+ *
+ * Note:            None
+ ******************************************************************************/
+bool SSD1306_Model_WritePBM(const SSD1306_MODEL *m, const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    uint8_t x, y;
+
+    if (f == NULL)
+    {
+        return false;
+    }
+
+    fprintf(f, "P4\n%u %u\n", SSD1306_MODEL_WIDTH, SSD1306_MODEL_HEIGHT);
+
+    // Rows of 16 bytes, leftmost pixel in the top bit
+    for (y = 0; y < SSD1306_MODEL_HEIGHT; y++)
+    {
+        for (x = 0; x < SSD1306_MODEL_WIDTH; x += 8)
+        {
+            uint8_t bits = 0;
+            uint8_t i;
+
+            for (i = 0; i < 8; i++)
+            {
+                bits = (bits << 1) | SSD1306_Model_Pixel(m, x + i, y);
+            }
+            fputc(bits, f);
+        }
+    }
+
+    return fclose(f) == 0;
+}
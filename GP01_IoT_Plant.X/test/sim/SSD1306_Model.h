@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * File: SSD1306_Model.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Behavioural model of an SSD1306 128x64 OLED controller
+ *                      on I2C. Decodes the command set, keeps the display RAM
+ *                      and renders what the panel shows to a PBM image.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SSD1306_MODEL_H
+#define SSD1306_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Sim_I2C.h"
+
+#define SSD1306_MODEL_WIDTH     128
+#define SSD1306_MODEL_PAGES     8
+#define SSD1306_MODEL_HEIGHT    (SSD1306_MODEL_PAGES * 8)
+
+// Longest command, the scroll setups take 6 argument bytes
+#define SSD1306_MODEL_CMD_MAX   7
+
+/*******************************************************************************
+ * Model state
+ ******************************************************************************/
+typedef struct
+{
+    SIM_I2C_DEVICE dev;
+
+    uint8_t gddram[SSD1306_MODEL_PAGES][SSD1306_MODEL_WIDTH];
+
+    // Control byte handling
+    bool control;                   // next byte is a control byte
+    bool data;                      // D/C# of the bytes that follow
+    bool single;                    // Co set, one byte then control again
+
+    // Command being collected
+    uint8_t cmd[SSD1306_MODEL_CMD_MAX];
+    uint8_t cmdLength;
+
+    // Settings
+    bool displayOn;
+    bool inverse;
+    bool entireOn;
+    bool chargePump;
+    uint8_t contrast;
+    uint8_t memoryMode;             // 0 horizontal, 1 vertical, 2 page
+    uint8_t colStart, colEnd, pageStart, pageEnd;
+    uint8_t col, page;              // address pointer
+    uint8_t startLine;
+    bool segRemap;
+    bool comRemap;
+    uint8_t multiplex;
+
+    // Statistics
+    uint32_t commands;
+    uint32_t dataBytes;
+    uint32_t unknown;               // commands the model does not know
+} SSD1306_MODEL;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void SSD1306_Model_Init(SSD1306_MODEL *m, uint8_t address);
+bool SSD1306_Model_Pixel(const SSD1306_MODEL *m, uint8_t x, uint8_t y);
+bool SSD1306_Model_WritePBM(const SSD1306_MODEL *m, const char *path);
+
+#endif  // SSD1306_MODEL_H
@@ -0,0 +1,675 @@
+/*******************************************************************************
+ * File: Sim.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Core of the host simulation. See Sim.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#define SIM_DEFINE_SFRS
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Sim.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint64_t sim_now;                // instruction cycles since reset
+static uint64_t sim_next;               // earliest due of any peripheral
+static SIM_PERIPHERAL *sim_peripherals;
+static bool sim_watching;               // some peripheral has a watch hook
+static bool sim_stepping;               // inside a peripheral step or watch
+
+static bool sim_gie = true;             // global interrupt enable
+static bool sim_in_isr;
+static void (*sim_pending[SIM_IRQ_SLOTS])(void);
+static uint8_t sim_pending_count;
+static uint32_t sim_irq_count;          // interrupts delivered
+
+static int64_t sim_tmr1_offset;         // TMR1 count less the cycle count
+static uint64_t sim_wake;               // cycle of the TMR1 wake up interrupt
+static SIM_POWER sim_power;
+
+/*******************************************************************************
+ * Function:        static void Sim_Update(void)
+ *
+ * Overview:        Runs every peripheral that is due and works out when the
+ *                  next one is
+ ******************************************************************************/
+static void Sim_Update(void)
+{
+    SIM_PERIPHERAL *p;
+
+    sim_next = SIM_NEVER;
+    sim_stepping = true;
+
+    for (p = sim_peripherals; p; p = p->next)
+    {
+        if (p->due <= sim_now)
+        {
+            p->due = SIM_NEVER;
+            p->step(sim_now);
+        }
+    }
+
+    sim_stepping = false;
+
+    // A step may have scheduled another peripheral for right now
+    for (p = sim_peripherals; p; p = p->next)
+    {
+        if (p->due < sim_next)
+        {
+            sim_next = p->due;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_Dispatch(void)
+ *
+ * Overview:        Runs pending interrupts, oldest first
+ ******************************************************************************/
+static void Sim_Dispatch(void)
+{
+    while (sim_gie && !sim_in_isr && sim_pending_count)
+    {
+        void (*isr)(void) = sim_pending[0];
+        uint8_t i;
+
+        for (i = 1; i < sim_pending_count; i++)
+        {
+            sim_pending[i - 1] = sim_pending[i];
+        }
+        sim_pending_count--;
+
+        sim_in_isr = true;
+        sim_irq_count++;
+        isr();
+        sim_in_isr = false;
+    }
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Reset(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Restarts the cycle count and drops all peripherals and
+ *                  pending interrupts. Register contents are kept
+ *
+ * Usage:           Sim_Reset();
+ *
+ * Note:            Models keep their state, reattach them afterwards
+ ******************************************************************************/
+void Sim_Reset(void)
+{
+    sim_now = 0;
+    sim_next = SIM_NEVER;
+    sim_peripherals = NULL;
+    sim_watching = false;
+    sim_gie = true;
+    sim_in_isr = false;
+    sim_pending_count = 0;
+    sim_tmr1_offset = 0;
+    sim_wake = SIM_NEVER;
+    Sim_PowerReset();
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Attach(SIM_PERIPHERAL *p)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Peripheral
+ *
+ * Output:          None
+ *
+ * Overview:        Adds a peripheral to the simulation
+ *
+ * Usage:           Sim_Attach(&i2c1);
+ *
+ * Note:            Attaching twice is harmless
+ ******************************************************************************/
+void Sim_Attach(SIM_PERIPHERAL *p)
+{
+    SIM_PERIPHERAL *q;
+
+    for (q = sim_peripherals; q; q = q->next)
+    {
+        if (q == p)
+        {
+            return;
+        }
+    }
+
+    p->due = SIM_NEVER;
+    p->next = sim_peripherals;
+    sim_peripherals = p;
+
+    if (p->watch)
+    {
+        sim_watching = true;
+    }
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Schedule(SIM_PERIPHERAL *p, uint64_t due)
+ *
+ * PreCondition:    Peripheral attached
+ *
+ * Input:           Peripheral and cycle count at which it should step
+ *
+ * Output:          None
+ *
+ * Overview:        Sets the next step of a peripheral, SIM_NEVER cancels it
+ *
+ * Usage:           Sim_Schedule(&i2c1, Sim_Now() + 9 * bit);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_Schedule(SIM_PERIPHERAL *p, uint64_t due)
+{
+    p->due = due;
+
+    if (due < sim_next)
+    {
+        sim_next = due;
+    }
+}
+
+/*******************************************************************************
+ * Function:        uint64_t Sim_Now(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Instruction cycles (1 / FCY) since Sim_Reset()
+ *
+ * Overview:        Returns the simulated time
+ *
+ * Usage:           start = Sim_Now();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint64_t Sim_Now(void)
+{
+    return sim_now;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Tick(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Advances one instruction cycle. Called on every register
+ *                  access, so polling loops let the peripherals progress
+ *
+ * Usage:           Sim_Tick();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_Tick(void)
+{
+    SIM_PERIPHERAL *p;
+
+    sim_now++;
+
+    if (sim_watching)
+    {
+        sim_stepping = true;
+
+        for (p = sim_peripherals; p; p = p->next)
+        {
+            if (p->watch)
+            {
+                p->watch();
+            }
+        }
+
+        sim_stepping = false;
+    }
+
+    if (sim_now >= sim_next)
+    {
+        Sim_Update();
+    }
+
+    Sim_Dispatch();
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Delay(uint64_t cycles)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Number of instruction cycles
+ *
+ * Output:          None
+ *
+ * Overview:        Lets time pass without register accesses, jumping from
+ *                  one peripheral event to the next. Backs __delay_ms()
+ *
+ * Usage:           Sim_Delay(FCY / 1000);
+ *
+ * Note:            Interrupts raised meanwhile run at the time they occur
+ ******************************************************************************/
+void Sim_Delay(uint64_t cycles)
+{
+    uint64_t end = sim_now + cycles;
+
+    Sim_Tick();
+
+    while (sim_now < end)
+    {
+        sim_now = (sim_next < end) ? sim_next : end;
+        Sim_Update();
+        Sim_Dispatch();
+    }
+}
+
+/*******************************************************************************
+ * Function:        double Sim_Microseconds(uint64_t cycles)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Instruction cycles
+ *
+ * Output:          Time in microseconds
+ *
+ * Overview:        Converts a cycle count for reports
+ *
+ * Usage:           printf("%.1f us", Sim_Microseconds(end - start));
+ *
+ * Note:            None
+ ******************************************************************************/
+double Sim_Microseconds(uint64_t cycles)
+{
+    return (double)cycles * 1e6 / FCY;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Interrupts(bool enable)
+ *
+ * PreCondition:    None
+ *
+ * Input:           true to enable interrupts
+ *
+ * Output:          None
+ *
+ * Overview:        Global interrupt enable, backs
+ *                  INTERRUPT_GlobalEnable()/Disable(). Interrupts raised
+ *                  while disabled run as soon as they are enabled again
+ *
+ * Usage:           Sim_Interrupts(true);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_Interrupts(bool enable)
+{
+    sim_gie = enable;
+    Sim_Tick();
+}
+
+/*******************************************************************************
+ * Function:        bool Sim_InterruptsEnabled(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Global interrupt enable
+ *
+ * Overview:        Lets tests check critical sections
+ *
+ * Usage:           if (!Sim_InterruptsEnabled()) ...
+ *
+ * Note:            None
+ ******************************************************************************/
+bool Sim_InterruptsEnabled(void)
+{
+    return sim_gie;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Interrupt(void (*isr)(void))
+ *
+ * PreCondition:    None
+ *
+ * Input:           Interrupt service routine
+ *
+ * Output:          None
+ *
+ * Overview:        Raises an interrupt. It runs straight away unless
+ *                  interrupts are disabled or another one is running, when
+ *                  raised by a peripheral once its step or watch has run
+ *
+ * Usage:           Sim_Interrupt(_DMA1Interrupt);
+ *
+ * Note:            The same routine is only pending once
+ ******************************************************************************/
+void Sim_Interrupt(void (*isr)(void))
+{
+    uint8_t i;
+
+    for (i = 0; i < sim_pending_count; i++)
+    {
+        if (sim_pending[i] == isr)
+        {
+            return;
+        }
+    }
+
+    if (sim_pending_count == SIM_IRQ_SLOTS)
+    {
+        fprintf(stderr, "sim: too many pending interrupts\n");
+        return;
+    }
+
+    sim_pending[sim_pending_count++] = isr;
+
+    if (!sim_stepping)
+    {
+        Sim_Dispatch();
+    }
+}
+
+/*******************************************************************************
+ * Function:        void Sim_ClrWdt(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        ClrWdt() instruction, the watchdog only ends a Sleep
+ *                  and never resets the simulation
+ *
+ * Usage:           ClrWdt();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_ClrWdt(void)
+{
+    Sim_Tick();
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Idle(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Idle() instruction, time passes until an interrupt has
+ *                  run, the TMR1 interrupt set by TMR1_WakeSet() is due or
+ *                  nothing is scheduled
+ *
+ * Usage:           Idle();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_Idle(void)
+{
+    uint32_t irqs = sim_irq_count;
+    uint64_t start = sim_now;
+    uint64_t until;
+
+    while (sim_irq_count == irqs)
+    {
+        until = (sim_next < sim_wake) ? sim_next : sim_wake;
+
+        if (until == SIM_NEVER)
+        {
+            break;
+        }
+
+        Sim_Delay((until > sim_now) ? until - sim_now : 1);
+
+        if (sim_now >= sim_wake)
+        {
+            sim_wake = SIM_NEVER;
+            break;
+        }
+    }
+
+    sim_power.idleCycles += sim_now - start;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_Sleep(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Sleep() instruction. The CPU, TMR1 and the peripherals
+ *                  stop until the watchdog times out after SIM_WDT_MS, sets
+ *                  RCON WDTO and wakes the CPU. Time moves on for the
+ *                  external models. A pending interrupt prevents the Sleep
+ *
+ * Usage:           Sleep();
+ *
+ * Note:            A peripheral with a step scheduled was stopped mid
+ *                  transfer, counted in the stalls
+ ******************************************************************************/
+void Sim_Sleep(void)
+{
+    uint64_t slept = (uint64_t)FCY * SIM_WDT_MS / 1000;
+    SIM_PERIPHERAL *p;
+    bool stalled = false;
+
+    Sim_Tick();
+
+    if (sim_pending_count)
+    {
+        return;
+    }
+
+    if (!RCONbits.SWDTEN)
+    {
+        fprintf(stderr, "sim: Sleep with the watchdog off never wakes\n");
+        return;
+    }
+
+    // Steps resume where they stopped once the clock is back
+    for (p = sim_peripherals; p; p = p->next)
+    {
+        if (p->due != SIM_NEVER)
+        {
+            p->due += slept;
+            stalled = true;
+        }
+    }
+
+    if (sim_next != SIM_NEVER)
+    {
+        sim_next += slept;
+    }
+
+    if (sim_wake != SIM_NEVER)
+    {
+        sim_wake += slept;
+    }
+
+    sim_now += slept;
+    sim_tmr1_offset -= (int64_t)slept;
+
+    sim_power.sleepCycles += slept;
+    sim_power.sleeps++;
+    if (stalled)
+    {
+        sim_power.stalls++;
+    }
+
+    RCONbits.SLEEP = 1;
+    RCONbits.WDTO = 1;
+}
+
+/*******************************************************************************
+ * Function:        const SIM_POWER *Sim_Power(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Time idle and asleep
+ *
+ * Overview:        Returns the power mode accounting since Sim_Reset() or
+ *                  Sim_PowerReset()
+ *
+ * Usage:           asleep = Sim_Power()->sleepCycles;
+ *
+ * Note:            The rest of the time the CPU ran
+ ******************************************************************************/
+const SIM_POWER *Sim_Power(void)
+{
+    return &sim_power;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_PowerReset(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Clears the power mode accounting
+ *
+ * Usage:           Sim_PowerReset();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_PowerReset(void)
+{
+    sim_power.idleCycles = 0;
+    sim_power.sleepCycles = 0;
+    sim_power.sleeps = 0;
+    sim_power.stalls = 0;
+}
+
+/*******************************************************************************
+ * Function:        uint32_t TMR1_TimestampGet(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Timestamp in FCY / TMR1_TIMESTAMP_PRESCALER ticks
+ *
+ * Overview:        Replaces the TMR1 driver, derived from the cycle count
+ *                  less the time asleep, plus what was added with
+ *                  TMR1_TimestampAdvance()
+ *
+ * Usage:           t = TMR1_TimestampGet();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint32_t TMR1_TimestampGet(void)
+{
+    return (uint32_t)(((int64_t)sim_now + sim_tmr1_offset) /
+                      TMR1_TIMESTAMP_PRESCALER);
+}
+
+/*******************************************************************************
+ * Function:        void TMR1_WakeSet(uint32_t counts)
+ *
+ * PreCondition:    None
+ *
+ * Input:           TMR1 counts until the interrupt
+ *
+ * Output:          None
+ *
+ * Overview:        Replaces the TMR1 driver, sets when Idle() is ended by
+ *                  the TMR1 interrupt. Limited like PR1 is
+ *
+ * Usage:           TMR1_WakeSet(Scheduler_NextDue());
+ *
+ * Note:            None
+ ******************************************************************************/
+void TMR1_WakeSet(uint32_t counts)
+{
+    if (counts < TMR1_WAKE_MIN_COUNTS)
+    {
+        counts = TMR1_WAKE_MIN_COUNTS;
+    }
+
+    if (counts > 0x10000)
+    {
+        counts = 0x10000;
+    }
+
+    sim_wake = sim_now + (uint64_t)counts * TMR1_TIMESTAMP_PRESCALER;
+}
+
+/*******************************************************************************
+ * Function:        void TMR1_TimestampAdvance(uint32_t counts)
+ *
+ * PreCondition:    None
+ *
+ * Input:           TMR1 counts to add
+ *
+ * Output:          None
+ *
+ * Overview:        Replaces the TMR1 driver, moves the timestamp on by the
+ *                  time the firmware reckons it slept
+ *
+ * Usage:           TMR1_TimestampAdvance(slept);
+ *
+ * Note:            None
+ ******************************************************************************/
+void TMR1_TimestampAdvance(uint32_t counts)
+{
+    sim_tmr1_offset += (int64_t)counts * TMR1_TIMESTAMP_PRESCALER;
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * File: Sim.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Core of the host simulation. Keeps the instruction cycle
+ *                      count, steps the simulated peripherals as the firmware
+ *                      touches their registers and delivers their interrupts.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Never, for peripherals with nothing scheduled
+#define SIM_NEVER           UINT64_MAX
+
+// Interrupts that can be pending at once
+#define SIM_IRQ_SLOTS       8
+
+// Watchdog timeout that ends a Sleep, WDTPRE 1:32 and WDTPOST 1:128 of the
+// 32 kHz LPRC
+#define SIM_WDT_MS          128
+
+/*******************************************************************************
+ * Simulated peripheral. step() runs once the cycle count reaches due and
+ * reschedules itself with Sim_Schedule(), watch() runs on every cycle the
+ * firmware spends touching registers, for pins written through pointers
+ ******************************************************************************/
+typedef struct SIM_PERIPHERAL
+{
+    void (*step)(uint64_t now);
+    void (*watch)(void);            // optional
+    uint64_t due;
+    struct SIM_PERIPHERAL *next;
+} SIM_PERIPHERAL;
+
+/*******************************************************************************
+ * Time spent with the CPU stopped. Peripherals step only while the CPU runs or
+ * idles, in Sleep they hold still and only the external models carry on
+ ******************************************************************************/
+typedef struct
+{
+    uint64_t idleCycles;
+    uint64_t sleepCycles;
+    uint32_t sleeps;                // watchdog wake ups
+    uint32_t stalls;                // sleeps with a peripheral mid transfer
+} SIM_POWER;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Sim_Reset(void);
+void Sim_Attach(SIM_PERIPHERAL *p);
+void Sim_Schedule(SIM_PERIPHERAL *p, uint64_t due);
+uint64_t Sim_Now(void);
+void Sim_Tick(void);
+void Sim_Delay(uint64_t cycles);
+double Sim_Microseconds(uint64_t cycles);
+
+void Sim_Interrupts(bool enable);
+bool Sim_InterruptsEnabled(void);
+void Sim_Interrupt(void (*isr)(void));
+
+void Sim_ClrWdt(void);
+void Sim_Idle(void);
+void Sim_Sleep(void);
+const SIM_POWER *Sim_Power(void);
+void Sim_PowerReset(void);
+
+#endif  // SIM_H
@@ -0,0 +1,306 @@
+/*******************************************************************************
+ * File: Sim_DMA.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Simulation of DMA channels 0 and 1. See Sim_DMA.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Sim_DMA.h"
+#include <stdio.h>
+
+// DMAxCON fields
+#define SIM_DMA_CHEN        0x8000
+#define SIM_DMA_SIZE_BYTE   0x4000
+#define SIM_DMA_DIR_TO_PER  0x2000
+#define SIM_DMA_AMODE       0x0030
+#define SIM_DMA_NO_INC      0x0010
+#define SIM_DMA_MODE        0x0003
+#define SIM_DMA_ONE_SHOT    0x0001
+
+// DMAxREQ fields
+#define SIM_DMA_FORCE       0x8000
+#define SIM_DMA_IRQSEL      0x00FF
+
+/*******************************************************************************
+ * Channel registers and state
+ ******************************************************************************/
+typedef struct
+{
+    volatile unsigned int *con, *req, *sta, *pad, *cnt;
+    uint16_t flag;                  // DMAxIF and DMAxIE bit in IFS0, IEC0
+    void (*isr)(void);
+    bool enabled;                   // CHEN seen set
+    uint16_t done;                  // transfers of the current block
+    SIM_DMA_STATS stats;
+} SIM_DMA_CHANNEL;
+
+// Interrupt routines of the firmware, if linked
+extern void _DMA0Interrupt(void) __attribute__((weak));
+extern void _DMA1Interrupt(void) __attribute__((weak));
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static SIM_PERIPHERAL sim_dma;
+
+static SIM_DMA_CHANNEL sim_dma_channels[SIM_DMA_CHANNELS] =
+{
+    { &SIM_DMA0CON, &SIM_DMA0REQ, &SIM_DMA0STAL, &SIM_DMA0PAD, &SIM_DMA0CNT,
+      1 << 4, _DMA0Interrupt },
+    { &SIM_DMA1CON, &SIM_DMA1REQ, &SIM_DMA1STAL, &SIM_DMA1PAD, &SIM_DMA1CNT,
+      1 << 14, _DMA1Interrupt }
+};
+
+/*******************************************************************************
+ * Function:        static void Sim_DMA_Enable(SIM_DMA_CHANNEL *ch)
+ *
+ * Overview:        Follows CHEN, setting it starts a new block
+ ******************************************************************************/
+static void Sim_DMA_Enable(SIM_DMA_CHANNEL *ch)
+{
+    bool enabled = (*ch->con & SIM_DMA_CHEN) != 0;
+
+    if (enabled && !ch->enabled)
+    {
+        ch->done = 0;
+    }
+
+    ch->enabled = enabled;
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_DMA_Transfer(SIM_DMA_CHANNEL *ch)
+ *
+ * Overview:        Moves one element between RAM at DMAxSTAL and the
+ *                  peripheral at DMAxPAD. The end of the block sets DMAxIF,
+ *                  raises the interrupt if enabled and in one-shot mode
+ *                  clears CHEN
+ ******************************************************************************/
+static void Sim_DMA_Transfer(SIM_DMA_CHANNEL *ch)
+{
+    unsigned int con = *ch->con;
+    uint8_t *ram = (uint8_t *)(uintptr_t)*ch->sta;
+
+    if ((con & SIM_DMA_AMODE) != SIM_DMA_NO_INC)
+    {
+        ram += (con & SIM_DMA_SIZE_BYTE) ? ch->done : 2 * ch->done;
+    }
+
+    if (*ch->pad != (unsigned int)(uintptr_t)&SIM_SPI2BUF ||
+        !(con & SIM_DMA_SIZE_BYTE))
+    {
+        fprintf(stderr, "sim: DMA to 0x%X in word mode or to an unmodelled "
+                "peripheral\n", *ch->pad);
+        return;
+    }
+
+    if (con & SIM_DMA_DIR_TO_PER)
+    {
+        Sim_SPI2_DmaWrite(*ram);
+    }
+    else
+    {
+        *ram = Sim_SPI2_DmaRead();
+    }
+
+    ch->stats.transfers++;
+
+    if (ch->done++ < (*ch->cnt & 0x3FFF))
+    {
+        return;
+    }
+
+    ch->done = 0;
+    ch->stats.blocks++;
+
+    if ((con & SIM_DMA_MODE) & SIM_DMA_ONE_SHOT)
+    {
+        *ch->con &= ~SIM_DMA_CHEN;
+        ch->enabled = false;
+    }
+
+    SIM_IFS0 |= ch->flag;
+    if ((SIM_IEC0 & ch->flag) && ch->isr)
+    {
+        Sim_Interrupt(ch->isr);
+    }
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_DMA_Watch(void)
+ *
+ * Overview:        Runs every cycle, picks up CHEN changes and software
+ *                  requests made through DMAxREQ FORCE
+ ******************************************************************************/
+static void Sim_DMA_Watch(void)
+{
+    SIM_DMA_CHANNEL *ch;
+
+    for (ch = sim_dma_channels; ch < &sim_dma_channels[SIM_DMA_CHANNELS]; ch++)
+    {
+        Sim_DMA_Enable(ch);
+
+        if (*ch->req & SIM_DMA_FORCE)
+        {
+            *ch->req &= ~SIM_DMA_FORCE;
+            ch->stats.forced++;
+
+            if (ch->enabled)
+            {
+                Sim_DMA_Transfer(ch);
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        void Sim_DMA_Init(void)
+ *
+ * PreCondition:    Sim_Reset() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Resets the channel registers and attaches the DMA
+ *                  controller to the simulation
+ *
+ * Usage:           Sim_DMA_Init();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_DMA_Init(void)
+{
+    SIM_DMA_CHANNEL *ch;
+
+    sim_dma.step = NULL;
+    sim_dma.watch = Sim_DMA_Watch;
+    Sim_Attach(&sim_dma);
+
+    for (ch = sim_dma_channels; ch < &sim_dma_channels[SIM_DMA_CHANNELS]; ch++)
+    {
+        *ch->con = 0;
+        *ch->req = 0;
+        *ch->sta = 0;
+        *ch->pad = 0;
+        *ch->cnt = 0;
+        ch->enabled = false;
+    }
+
+    Sim_DMA_StatsReset();
+}
+
+/*******************************************************************************
+ * Function:        void Sim_DMA_Request(uint8_t irq)
+ *
+ * PreCondition:    None
+ *
+ * Input:           DMAxREQ IRQSEL of the event
+ *
+ * Output:          None
+ *
+ * Overview:        Peripheral event, every enabled channel listening to it
+ *                  moves one element. Channel 0 goes first as it has the
+ *                  highest priority
+ *
+ * Usage:           Sim_DMA_Request(SIM_DMA_IRQ_SPI2);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_DMA_Request(uint8_t irq)
+{
+    SIM_DMA_CHANNEL *ch;
+
+    for (ch = sim_dma_channels; ch < &sim_dma_channels[SIM_DMA_CHANNELS]; ch++)
+    {
+        Sim_DMA_Enable(ch);
+
+        if (ch->enabled && (*ch->req & SIM_DMA_IRQSEL) == irq)
+        {
+            Sim_DMA_Transfer(ch);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        const SIM_DMA_STATS *Sim_DMA_Stats(uint8_t channel)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Channel, 0 or 1
+ *
+ * Output:          Statistics of the channel since the last reset
+ *
+ * Overview:        Returns the channel statistics
+ *
+ * Usage:           blocks = Sim_DMA_Stats(1)->blocks;
+ *
+ * Note:            None
+ ******************************************************************************/
+const SIM_DMA_STATS *Sim_DMA_Stats(uint8_t channel)
+{
+    return &sim_dma_channels[channel].stats;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_DMA_StatsReset(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Clears the channel statistics
+ *
+ * Usage:           Sim_DMA_StatsReset();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_DMA_StatsReset(void)
+{
+    uint8_t i;
+
+    for (i = 0; i < SIM_DMA_CHANNELS; i++)
+    {
+        sim_dma_channels[i].stats = (SIM_DMA_STATS){0};
+    }
+}
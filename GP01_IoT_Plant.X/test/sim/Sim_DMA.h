@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * File: Sim_DMA.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Simulation of DMA channels 0 and 1. A channel moves one
+ *                      byte or word between RAM and a peripheral register per
+ *                      request, from the peripheral selected by DMAxREQ or
+ *                      forced by software, and raises its interrupt at the end
+ *                      of the block. SPI2BUF is the peripheral modelled.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SIM_DMA_H
+#define SIM_DMA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Channels modelled
+#define SIM_DMA_CHANNELS    2
+
+// DMAxREQ IRQSEL of the SPI2 transfer done event
+#define SIM_DMA_IRQ_SPI2    0x21
+
+/*******************************************************************************
+ * Channel statistics
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t transfers;             // bytes or words moved
+    uint32_t blocks;                // blocks completed
+    uint32_t forced;                // software requests
+} SIM_DMA_STATS;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Sim_DMA_Init(void);
+void Sim_DMA_Request(uint8_t irq);
+const SIM_DMA_STATS *Sim_DMA_Stats(uint8_t channel);
+void Sim_DMA_StatsReset(void);
+
+#endif  // SIM_DMA_H
@@ -0,0 +1,464 @@
+/*******************************************************************************
+ * File: Sim_I2C.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: I2C1 master and bus simulation. See Sim_I2C.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Sim_I2C.h"
+
+// I2C1TRN holds this while no byte is waiting, the driver only writes bytes
+#define SIM_I2C_TRN_EMPTY   0x10000
+
+// Bit fields on the register storage, without the sync of the xc.h names
+#define CON     (*(volatile I2C1CONBITS *)&SIM_I2C1CON)
+#define STAT    (*(volatile I2C1STATBITS *)&SIM_I2C1STAT)
+
+// Operations of the master, one runs at a time
+typedef enum
+{
+    SIM_I2C_IDLE,
+    SIM_I2C_START,
+    SIM_I2C_RESTART,
+    SIM_I2C_STOP,
+    SIM_I2C_TRANSMIT,
+    SIM_I2C_RECEIVE,
+    SIM_I2C_ACK
+} SIM_I2C_OP;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static SIM_PERIPHERAL sim_i2c;
+static SIM_I2C_DEVICE *sim_i2c_devices;
+static SIM_I2C_DEVICE *sim_i2c_slave;   // addressed device, NULL if none
+static SIM_I2C_OP sim_i2c_op;
+static uint64_t sim_i2c_op_start;
+static uint8_t sim_i2c_tx;              // byte being shifted out
+static bool sim_i2c_address;            // next byte is an address byte
+static bool sim_i2c_read;               // slave transmits
+static SIM_I2C_STATS sim_i2c_stats;
+
+static void Sim_I2C_Step(uint64_t now);
+
+/*******************************************************************************
+ * Function:        uint32_t Sim_I2C_BitCycles(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Instruction cycles per SCL period
+ *
+ * Overview:        Inverse of the I2CxBRG formula of the datasheet, the
+ *                  period is BRG + 2 cycles plus the 130 ns pulse gobbler
+ *
+ * Usage:           bit = Sim_I2C_BitCycles();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint32_t Sim_I2C_BitCycles(void)
+{
+    return (SIM_I2C1BRG & 0xFFFF) + 2 + (FCY / 1000000UL) * 130UL / 1000UL;
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_I2C_Begin(SIM_I2C_OP op, uint32_t bits)
+ *
+ * Overview:        Starts a master operation lasting a number of SCL periods
+ ******************************************************************************/
+static void Sim_I2C_Begin(SIM_I2C_OP op, uint32_t bits)
+{
+    sim_i2c_op = op;
+    sim_i2c_op_start = Sim_Now();
+    Sim_Schedule(&sim_i2c, Sim_Now() + bits * Sim_I2C_BitCycles());
+}
+
+/*******************************************************************************
+ * Function:        static SIM_I2C_DEVICE *Sim_I2C_Find(uint8_t address)
+ *
+ * Overview:        Returns the device answering a 7-bit address
+ ******************************************************************************/
+static SIM_I2C_DEVICE *Sim_I2C_Find(uint8_t address)
+{
+    SIM_I2C_DEVICE *dev;
+
+    for (dev = sim_i2c_devices; dev; dev = dev->next)
+    {
+        if (((address ^ dev->address) & dev->mask) == 0)
+        {
+            return dev;
+        }
+    }
+
+    return NULL;
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_I2C_Release(void)
+ *
+ * Overview:        Ends the transaction with the addressed slave
+ ******************************************************************************/
+static void Sim_I2C_Release(void)
+{
+    if (sim_i2c_slave && sim_i2c_slave->stop)
+    {
+        sim_i2c_slave->stop(sim_i2c_slave);
+    }
+
+    sim_i2c_slave = NULL;
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_I2C_Step(uint64_t now)
+ *
+ * Overview:        Completes the running operation, updating I2C1CON and
+ *                  I2C1STAT the way the module does
+ ******************************************************************************/
+static void Sim_I2C_Step(uint64_t now)
+{
+    bool ack;
+
+    sim_i2c_stats.busy += now - sim_i2c_op_start;
+
+    switch (sim_i2c_op)
+    {
+    case SIM_I2C_START:
+    case SIM_I2C_RESTART:
+        // A repeated start ends the write phase of a random read
+        CON.SEN = 0;
+        CON.RSEN = 0;
+        STAT.S = 1;
+        STAT.P = 0;
+        sim_i2c_address = true;
+        sim_i2c_stats.starts++;
+        break;
+
+    case SIM_I2C_STOP:
+        Sim_I2C_Release();
+        CON.PEN = 0;
+        STAT.S = 0;
+        STAT.P = 1;
+        sim_i2c_stats.stops++;
+        break;
+
+    case SIM_I2C_TRANSMIT:
+        if (sim_i2c_address)
+        {
+            SIM_I2C_DEVICE *dev = Sim_I2C_Find(sim_i2c_tx >> 1);
+
+            sim_i2c_address = false;
+            sim_i2c_read = sim_i2c_tx & 1;
+            ack = dev && dev->select(dev, sim_i2c_tx >> 1, sim_i2c_read);
+
+            if (sim_i2c_slave && sim_i2c_slave != dev)
+            {
+                Sim_I2C_Release();
+            }
+            sim_i2c_slave = ack ? dev : NULL;
+        }
+        else if (sim_i2c_slave && !sim_i2c_read)
+        {
+            ack = sim_i2c_slave->write(sim_i2c_slave, sim_i2c_tx);
+        }
+        else
+        {
+            ack = false;
+        }
+
+        if (!ack)
+        {
+            sim_i2c_stats.nacks++;
+        }
+        sim_i2c_stats.written++;
+
+        STAT.ACKSTAT = !ack;
+        STAT.TBF = 0;
+        STAT.TRSTAT = 0;
+        break;
+
+    case SIM_I2C_RECEIVE:
+        if (STAT.RBF)
+        {
+            STAT.I2COV = 1;
+        }
+        else
+        {
+            SIM_I2C1RCV = (sim_i2c_slave && sim_i2c_read) ?
+                          sim_i2c_slave->read(sim_i2c_slave) : 0xFF;
+        }
+        sim_i2c_stats.read++;
+
+        STAT.RBF = 1;
+        CON.RCEN = 0;
+        break;
+
+    case SIM_I2C_ACK:
+        CON.ACKEN = 0;
+        break;
+
+    case SIM_I2C_IDLE:
+        break;
+    }
+
+    sim_i2c_op = SIM_I2C_IDLE;
+    SIM_IFS1 |= 1 << 1;     // MI2C1IF
+}
+
+/*******************************************************************************
+ * Function:        void Sim_I2C_Init(void)
+ *
+ * PreCondition:    Sim_Reset() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Resets the I2C1 registers and attaches the module to the
+ *                  simulation. Attached devices stay on the bus
+ *
+ * Usage:           Sim_I2C_Init();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_I2C_Init(void)
+{
+    sim_i2c.step = Sim_I2C_Step;
+    sim_i2c.watch = NULL;
+    Sim_Attach(&sim_i2c);
+
+    SIM_I2C1CON = 0;
+    SIM_I2C1STAT = 0;
+    SIM_I2C1BRG = 0;
+    SIM_I2C1TRN = SIM_I2C_TRN_EMPTY;
+    SIM_I2C1RCV = 0;
+
+    sim_i2c_slave = NULL;
+    sim_i2c_op = SIM_I2C_IDLE;
+    Sim_I2C_StatsReset();
+}
+
+/*******************************************************************************
+ * Function:        void Sim_I2C_Attach(SIM_I2C_DEVICE *dev)
+ *
+ * PreCondition:    Device filled in
+ *
+ * Input:           Device model
+ *
+ * Output:          None
+ *
+ * Overview:        Connects a slave to the bus
+ *
+ * Usage:           Sim_I2C_Attach(&eeprom.dev);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_I2C_Attach(SIM_I2C_DEVICE *dev)
+{
+    Sim_I2C_Detach(dev);
+
+    dev->next = sim_i2c_devices;
+    sim_i2c_devices = dev;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_I2C_Detach(SIM_I2C_DEVICE *dev)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Device model
+ *
+ * Output:          None
+ *
+ * Overview:        Disconnects a slave, it no longer answers its address
+ *
+ * Usage:           Sim_I2C_Detach(&eeprom.dev);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_I2C_Detach(SIM_I2C_DEVICE *dev)
+{
+    SIM_I2C_DEVICE **p;
+
+    for (p = &sim_i2c_devices; *p; p = &(*p)->next)
+    {
+        if (*p == dev)
+        {
+            *p = dev->next;
+            break;
+        }
+    }
+
+    if (sim_i2c_slave == dev)
+    {
+        sim_i2c_slave = NULL;
+    }
+}
+
+/*******************************************************************************
+ * Function:        const SIM_I2C_STATS *Sim_I2C_Stats(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Bus statistics since the last reset
+ *
+ * Overview:        Returns the bus statistics
+ *
+ * Usage:           bytes = Sim_I2C_Stats()->written;
+ *
+ * Note:            None
+ ******************************************************************************/
+const SIM_I2C_STATS *Sim_I2C_Stats(void)
+{
+    return &sim_i2c_stats;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_I2C_StatsReset(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Clears the bus statistics
+ *
+ * Usage:           Sim_I2C_StatsReset();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_I2C_StatsReset(void)
+{
+    sim_i2c_stats = (SIM_I2C_STATS){0};
+}
+
+/*******************************************************************************
+ * Function:        void Sim_I2C1_Sync(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Runs before every access to an I2C1 register. Lets one
+ *                  cycle pass, then starts the operation the driver asked
+ *                  for since the last access: a byte written to I2C1TRN or
+ *                  a SEN, RSEN, PEN, RCEN or ACKEN request
+ *
+ * Usage:           Called through the register names in xc.h
+ *
+ * Note:            Writing I2C1TRN while the module is busy sets IWCOL
+ ******************************************************************************/
+void Sim_I2C1_Sync(void)
+{
+    Sim_Tick();
+
+    if (SIM_I2C1TRN != SIM_I2C_TRN_EMPTY)
+    {
+        if (sim_i2c_op != SIM_I2C_IDLE || CON.SEN || CON.RSEN || CON.PEN ||
+            CON.RCEN || CON.ACKEN)
+        {
+            STAT.IWCOL = 1;
+        }
+        else
+        {
+            sim_i2c_tx = SIM_I2C1TRN;
+            STAT.TBF = 1;
+            STAT.TRSTAT = 1;
+            Sim_I2C_Begin(SIM_I2C_TRANSMIT, 9);
+        }
+
+        SIM_I2C1TRN = SIM_I2C_TRN_EMPTY;
+    }
+
+    if (sim_i2c_op != SIM_I2C_IDLE || !CON.I2CEN)
+    {
+        return;
+    }
+
+    if (CON.SEN)
+    {
+        Sim_I2C_Begin(SIM_I2C_START, 1);
+    }
+    else if (CON.RSEN)
+    {
+        Sim_I2C_Begin(SIM_I2C_RESTART, 1);
+    }
+    else if (CON.PEN)
+    {
+        Sim_I2C_Begin(SIM_I2C_STOP, 1);
+    }
+    else if (CON.RCEN)
+    {
+        Sim_I2C_Begin(SIM_I2C_RECEIVE, 8);
+    }
+    else if (CON.ACKEN)
+    {
+        Sim_I2C_Begin(SIM_I2C_ACK, 1);
+    }
+}
+
+/*******************************************************************************
+ * Function:        volatile unsigned int *Sim_I2C1_Receive(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          I2C1RCV storage
+ *
+ * Overview:        Read access to I2C1RCV, which empties the receive buffer
+ *
+ * Usage:           Called through I2C1RCV in xc.h
+ *
+ * Note:            None
+ ******************************************************************************/
+volatile unsigned int *Sim_I2C1_Receive(void)
+{
+    Sim_I2C1_Sync();
+    STAT.RBF = 0;
+
+    return &SIM_I2C1RCV;
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * File: Sim_I2C.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: I2C1 master and bus simulation. Start, stop, byte and
+ *                      acknowledge timing follows I2C1BRG, slaves are pluggable
+ *                      device models.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SIM_I2C_H
+#define SIM_I2C_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+ * Slave device model. The bus calls select() with the 7-bit address of
+ * every address byte that matches, then write() or read() per data byte
+ * and stop() when the transaction ends. Returning false sends a NACK
+ ******************************************************************************/
+typedef struct SIM_I2C_DEVICE
+{
+    uint8_t address;                // 7-bit address
+    uint8_t mask;                   // address bits compared, 0x7F for all
+    bool (*select)(struct SIM_I2C_DEVICE *dev, uint8_t address, bool read);
+    bool (*write)(struct SIM_I2C_DEVICE *dev, uint8_t data);
+    uint8_t (*read)(struct SIM_I2C_DEVICE *dev);
+    void (*stop)(struct SIM_I2C_DEVICE *dev);
+    struct SIM_I2C_DEVICE *next;
+} SIM_I2C_DEVICE;
+
+/*******************************************************************************
+ * Bus statistics
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t starts;                // start and repeated start conditions
+    uint32_t stops;
+    uint32_t written;               // bytes sent by the master, incl address
+    uint32_t read;                  // bytes received by the master
+    uint32_t nacks;                 // bytes not acknowledged by a slave
+    uint64_t busy;                  // cycles the bus was driven
+} SIM_I2C_STATS;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Sim_I2C_Init(void);
+void Sim_I2C_Attach(SIM_I2C_DEVICE *dev);
+void Sim_I2C_Detach(SIM_I2C_DEVICE *dev);
+const SIM_I2C_STATS *Sim_I2C_Stats(void);
+void Sim_I2C_StatsReset(void);
+uint32_t Sim_I2C_BitCycles(void);
+
+// Register access hooks used by xc.h
+void Sim_I2C1_Sync(void);
+volatile unsigned int *Sim_I2C1_Receive(void);
+
+#endif  // SIM_I2C_H
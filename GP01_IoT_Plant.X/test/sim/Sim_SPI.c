@@ -0,0 +1,574 @@
+/*******************************************************************************
+ * File: Sim_SPI.c
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Simulation of the SPI2 master. See Sim_SPI.h
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Includes and defines
+ ******************************************************************************/
+#include "mcc_generated_files/mcc.h"
+#include "dsPIC33_STD.h"
+#include "Sim_SPI.h"
+#include "Sim_DMA.h"
+
+// SPI2BUF holds this flag plus the receive buffer head after the driver
+// reached it, a value without the flag was written by the driver
+#define SIM_SPI_BUF_READ    0x10000
+
+// SPI2CON1 clock polarity and phase, compared with SIM_SPI_DEVICE.mode
+#define SIM_SPI_MODE_MASK   0x0140
+
+// Bit fields on the register storage, without the sync of the xc.h names
+#define CON1    (*(volatile SPI2CON1BITS *)&SIM_SPI2CON1)
+#define CON2    (*(volatile SPI2CON2BITS *)&SIM_SPI2CON2)
+#define STAT    (*(volatile SPI2STATBITS *)&SIM_SPI2STAT)
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static SIM_PERIPHERAL sim_spi;
+static SIM_SPI_DEVICE *sim_spi_devices;
+
+static uint8_t sim_spi_tx[SIM_SPI_FIFO];   // transmit buffer
+static uint8_t sim_spi_tx_head, sim_spi_tx_count;
+static uint8_t sim_spi_rx[SIM_SPI_FIFO];   // receive buffer
+static uint8_t sim_spi_rx_head, sim_spi_rx_count;
+
+static bool sim_spi_shifting;           // a byte is in the shift register
+static uint8_t sim_spi_shift;
+static uint64_t sim_spi_shift_start;
+
+static bool sim_spi_access;             // SPI2BUF reached since last cycle
+static bool sim_spi_peeked;             // it held a received byte
+
+static SIM_SPI_STATS sim_spi_stats;
+
+/*******************************************************************************
+ * Function:        uint32_t Sim_SPI_ByteCycles(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Instruction cycles to shift one byte
+ *
+ * Overview:        Eight SCK periods, SCK = FCY / (primary * secondary
+ *                  prescaler) as loaded in SPI2CON1
+ *
+ * Usage:           byte = Sim_SPI_ByteCycles();
+ *
+ * Note:            None
+ ******************************************************************************/
+uint32_t Sim_SPI_ByteCycles(void)
+{
+    static const uint8_t primary[4] = { 64, 16, 4, 1 };
+
+    return 8UL * primary[CON1.PPRE] * (8 - CON1.SPRE);
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Sim_SPI_Depth(void)
+ *
+ * Overview:        Buffer depth, the standard mode has a single buffer
+ ******************************************************************************/
+static uint8_t Sim_SPI_Depth(void)
+{
+    return CON2.SPIBEN ? SIM_SPI_FIFO : 1;
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_SPI_Status(void)
+ *
+ * Overview:        Updates the read only SPI2STAT flags from the buffers
+ ******************************************************************************/
+static void Sim_SPI_Status(void)
+{
+    uint8_t depth = Sim_SPI_Depth();
+
+    STAT.SPITBF = sim_spi_tx_count >= depth;
+    STAT.SRXMPT = sim_spi_rx_count == 0;
+    STAT.SPIRBF = sim_spi_rx_count >= depth;
+    STAT.SRMPT = !sim_spi_shifting && sim_spi_tx_count == 0;
+    STAT.SPIBEC = (sim_spi_tx_count < 7) ? sim_spi_tx_count : 7;
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_SPI_Flush(void)
+ *
+ * Overview:        Module disabled, empties the buffers and stops shifting
+ ******************************************************************************/
+static void Sim_SPI_Flush(void)
+{
+    sim_spi_tx_count = 0;
+    sim_spi_rx_count = 0;
+    sim_spi_shifting = false;
+    Sim_Schedule(&sim_spi, SIM_NEVER);
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_SPI_Start(void)
+ *
+ * Overview:        Moves the next byte to send into the shift register
+ ******************************************************************************/
+static void Sim_SPI_Start(void)
+{
+    if (sim_spi_shifting || sim_spi_tx_count == 0 || !STAT.SPIEN)
+    {
+        return;
+    }
+
+    sim_spi_shift = sim_spi_tx[sim_spi_tx_head];
+    sim_spi_tx_head = (sim_spi_tx_head + 1) % SIM_SPI_FIFO;
+    sim_spi_tx_count--;
+
+    sim_spi_shifting = true;
+    sim_spi_shift_start = Sim_Now();
+    Sim_Schedule(&sim_spi, Sim_Now() + Sim_SPI_ByteCycles());
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_SPI_Push(uint8_t data)
+ *
+ * Overview:        Queues a byte to send, ignored while the module is off
+ *                  or the transmit buffer is full
+ ******************************************************************************/
+static void Sim_SPI_Push(uint8_t data)
+{
+    if (!STAT.SPIEN || sim_spi_tx_count >= Sim_SPI_Depth())
+    {
+        return;
+    }
+
+    sim_spi_tx[(sim_spi_tx_head + sim_spi_tx_count) % SIM_SPI_FIFO] = data;
+    sim_spi_tx_count++;
+    Sim_SPI_Start();
+}
+
+/*******************************************************************************
+ * Function:        static uint8_t Sim_SPI_Exchange(uint8_t data)
+ *
+ * Overview:        Exchanges a byte with the selected devices. An undriven
+ *                  MISO reads 0xFF, several drivers read as their AND
+ ******************************************************************************/
+static uint8_t Sim_SPI_Exchange(uint8_t data)
+{
+    SIM_SPI_DEVICE *dev;
+    uint8_t miso = 0xFF;
+    uint8_t drivers = 0;
+
+    for (dev = sim_spi_devices; dev; dev = dev->next)
+    {
+        if (!dev->selected)
+        {
+            continue;
+        }
+
+        if ((SIM_SPI2CON1 & SIM_SPI_MODE_MASK) != dev->mode ||
+            (uint64_t)FCY * 8 > (uint64_t)dev->maxHz * Sim_SPI_ByteCycles())
+        {
+            sim_spi_stats.modeErrors++;
+        }
+
+        miso &= dev->exchange(dev, data);
+        drivers++;
+    }
+
+    if (drivers == 0)
+    {
+        sim_spi_stats.unselected++;
+    }
+    else if (drivers > 1)
+    {
+        sim_spi_stats.conflicts++;
+    }
+
+    return miso;
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_SPI_Step(uint64_t now)
+ *
+ * Overview:        Completes the byte in the shift register and starts the
+ *                  next one. A byte arriving at a full receive buffer is
+ *                  lost and sets SPIROV. The transfer done event is a DMA
+ *                  request
+ ******************************************************************************/
+static void Sim_SPI_Step(uint64_t now)
+{
+    uint8_t data;
+
+    if (!sim_spi_shifting)
+    {
+        return;
+    }
+
+    data = Sim_SPI_Exchange(sim_spi_shift);
+    sim_spi_shifting = false;
+    sim_spi_stats.busy += now - sim_spi_shift_start;
+    sim_spi_stats.bytes++;
+
+    if (sim_spi_rx_count >= Sim_SPI_Depth())
+    {
+        STAT.SPIROV = 1;
+        sim_spi_stats.overruns++;
+    }
+    else
+    {
+        sim_spi_rx[(sim_spi_rx_head + sim_spi_rx_count) % SIM_SPI_FIFO] =
+            data;
+        sim_spi_rx_count++;
+    }
+
+    Sim_SPI_Status();
+    Sim_DMA_Request(SIM_DMA_IRQ_SPI2);
+
+    Sim_SPI_Start();
+    Sim_SPI_Status();
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_SPI_Commit(void)
+ *
+ * Overview:        Completes the SPI2BUF access of the driver. A write is
+ *                  queued for sending, a read removes the byte it returned
+ *                  from the receive buffer
+ ******************************************************************************/
+static void Sim_SPI_Commit(void)
+{
+    if (!sim_spi_access)
+    {
+        return;
+    }
+
+    sim_spi_access = false;
+
+    if (SIM_SPI2BUF & SIM_SPI_BUF_READ)
+    {
+        if (sim_spi_peeked)
+        {
+            sim_spi_rx_head = (sim_spi_rx_head + 1) % SIM_SPI_FIFO;
+            sim_spi_rx_count--;
+        }
+    }
+    else
+    {
+        Sim_SPI_Push(SIM_SPI2BUF);
+    }
+
+    SIM_SPI2BUF = SIM_SPI_BUF_READ;
+    Sim_SPI_Status();
+}
+
+/*******************************************************************************
+ * Function:        static void Sim_SPI_Watch(void)
+ *
+ * Overview:        Runs every cycle. Completes a pending SPI2BUF access and
+ *                  follows the chip selects, which the drivers write through
+ *                  pointers
+ ******************************************************************************/
+static void Sim_SPI_Watch(void)
+{
+    SIM_SPI_DEVICE *dev;
+    bool active;
+
+    Sim_SPI_Commit();
+
+    for (dev = sim_spi_devices; dev; dev = dev->next)
+    {
+        active = ((*dev->csLat & dev->csMask) != 0) == dev->csActiveHigh;
+
+        if (active == dev->selected)
+        {
+            continue;
+        }
+
+        dev->selected = active;
+
+        if (active)
+        {
+            sim_spi_stats.selects++;
+            if (dev->select)
+            {
+                dev->select(dev);
+            }
+        }
+        else if (dev->deselect)
+        {
+            dev->deselect(dev);
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        void Sim_SPI_Init(void)
+ *
+ * PreCondition:    Sim_Reset() should have been called
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Resets the SPI2 registers and attaches the module to the
+ *                  simulation. Attached devices stay on the bus
+ *
+ * Usage:           Sim_SPI_Init();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_SPI_Init(void)
+{
+    sim_spi.step = Sim_SPI_Step;
+    sim_spi.watch = Sim_SPI_Watch;
+    Sim_Attach(&sim_spi);
+
+    SIM_SPI2CON1 = 0;
+    SIM_SPI2CON2 = 0;
+    SIM_SPI2STAT = 0;
+    SIM_SPI2BUF = SIM_SPI_BUF_READ;
+
+    sim_spi_access = false;
+    Sim_SPI_Flush();
+    Sim_SPI_Status();
+    Sim_SPI_StatsReset();
+}
+
+/*******************************************************************************
+ * Function:        void Sim_SPI_Attach(SIM_SPI_DEVICE *dev)
+ *
+ * PreCondition:    Device filled in
+ *
+ * Input:           Device model
+ *
+ * Output:          None
+ *
+ * Overview:        Connects a slave to the bus, its chip select is sampled
+ *                  from the next cycle on
+ *
+ * Usage:           Sim_SPI_Attach(&sensor.dev);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_SPI_Attach(SIM_SPI_DEVICE *dev)
+{
+    Sim_SPI_Detach(dev);
+
+    dev->selected = false;
+    dev->next = sim_spi_devices;
+    sim_spi_devices = dev;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_SPI_Detach(SIM_SPI_DEVICE *dev)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Device model
+ *
+ * Output:          None
+ *
+ * Overview:        Disconnects a slave, it no longer drives MISO
+ *
+ * Usage:           Sim_SPI_Detach(&sensor.dev);
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_SPI_Detach(SIM_SPI_DEVICE *dev)
+{
+    SIM_SPI_DEVICE **p;
+
+    for (p = &sim_spi_devices; *p; p = &(*p)->next)
+    {
+        if (*p == dev)
+        {
+            *p = dev->next;
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+ * Function:        const SIM_SPI_STATS *Sim_SPI_Stats(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Bus statistics since the last reset
+ *
+ * Overview:        Returns the bus statistics
+ *
+ * Usage:           bytes = Sim_SPI_Stats()->bytes;
+ *
+ * Note:            None
+ ******************************************************************************/
+const SIM_SPI_STATS *Sim_SPI_Stats(void)
+{
+    return &sim_spi_stats;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_SPI_StatsReset(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Clears the bus statistics
+ *
+ * Usage:           Sim_SPI_StatsReset();
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_SPI_StatsReset(void)
+{
+    sim_spi_stats = (SIM_SPI_STATS){0};
+}
+
+/*******************************************************************************
+ * Function:        void Sim_SPI2_Sync(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          None
+ *
+ * Overview:        Runs before every access to an SPI2 register. Lets one
+ *                  cycle pass, empties the module while SPIEN is clear and
+ *                  brings the status flags up to date
+ *
+ * Usage:           Called through the register names in xc.h
+ *
+ * Note:            None
+ ******************************************************************************/
+void Sim_SPI2_Sync(void)
+{
+    Sim_Tick();
+
+    if (!STAT.SPIEN)
+    {
+        Sim_SPI_Flush();
+    }
+
+    Sim_SPI_Status();
+}
+
+/*******************************************************************************
+ * Function:        volatile unsigned int *Sim_SPI2_Buffer(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          SPI2BUF storage
+ *
+ * Overview:        Access to SPI2BUF. Reads return the oldest received
+ *                  byte, the access is completed on the next cycle once it
+ *                  is known whether the driver read or wrote
+ *
+ * Usage:           Called through SPI2BUF in xc.h
+ *
+ * Note:            Only 8-bit transfers are modelled
+ ******************************************************************************/
+volatile unsigned int *Sim_SPI2_Buffer(void)
+{
+    Sim_SPI2_Sync();
+
+    sim_spi_access = true;
+    sim_spi_peeked = sim_spi_rx_count != 0;
+    SIM_SPI2BUF = SIM_SPI_BUF_READ |
+                  (sim_spi_peeked ? sim_spi_rx[sim_spi_rx_head] : 0);
+
+    return &SIM_SPI2BUF;
+}
+
+/*******************************************************************************
+ * Function:        void Sim_SPI2_DmaWrite(uint8_t data)
+ *
+ * PreCondition:    None
+ *
+ * Input:           Byte to send
+ *
+ * Output:          None
+ *
+ * Overview:        DMA write to SPI2BUF, queued for sending like a write by
+ *                  the CPU
+ *
+ * Usage:           Called by the DMA simulation
+ *
+ * Note:            The byte is lost if the transmit buffer is full
+ ******************************************************************************/
+void Sim_SPI2_DmaWrite(uint8_t data)
+{
+    Sim_SPI_Push(data);
+    Sim_SPI_Status();
+}
+
+/*******************************************************************************
+ * Function:        uint8_t Sim_SPI2_DmaRead(void)
+ *
+ * PreCondition:    None
+ *
+ * Input:           None
+ *
+ * Output:          Oldest received byte
+ *
+ * Overview:        DMA read of SPI2BUF, removes the byte from the receive
+ *                  buffer
+ *
+ * Usage:           Called by the DMA simulation
+ *
+ * Note:            Reads 0 from an empty buffer
+ ******************************************************************************/
+uint8_t Sim_SPI2_DmaRead(void)
+{
+    uint8_t data = 0;
+
+    if (sim_spi_rx_count)
+    {
+        data = sim_spi_rx[sim_spi_rx_head];
+        sim_spi_rx_head = (sim_spi_rx_head + 1) % SIM_SPI_FIFO;
+        sim_spi_rx_count--;
+    }
+
+    Sim_SPI_Status();
+
+    return data;
+}
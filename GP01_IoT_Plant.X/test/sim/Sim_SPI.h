@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * File: Sim_SPI.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Simulation of the SPI2 master with its 8 byte enhanced
+ *                      buffers. Bytes written to SPI2BUF are shifted out at the
+ *                      SCK rate set by SPI2CON1 and exchanged with the device
+ *                      models whose chip select is asserted, chip selects are
+ *                      sampled from their LAT registers.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Enhanced buffer depth of the SPI modules
+#define SIM_SPI_FIFO        8
+
+/*******************************************************************************
+ * Slave device model. select() runs when the chip select goes active,
+ * exchange() once per byte while it is active and deselect() when it goes
+ * inactive again. mode and maxHz are checked on every byte
+ ******************************************************************************/
+typedef struct SIM_SPI_DEVICE
+{
+    volatile unsigned int *csLat;   // LATx register of the chip select pin
+    uint16_t csMask;                // chip select pin mask
+    bool csActiveHigh;
+    uint16_t mode;                  // SPI2CON1 CKP/CKE bits, SPI_MODEx
+    uint32_t maxHz;                 // fastest SCK the part allows
+    void (*select)(struct SIM_SPI_DEVICE *dev);         // optional
+    uint8_t (*exchange)(struct SIM_SPI_DEVICE *dev, uint8_t data);
+    void (*deselect)(struct SIM_SPI_DEVICE *dev);       // optional
+    bool selected;                  // chip select seen active
+    struct SIM_SPI_DEVICE *next;
+} SIM_SPI_DEVICE;
+
+/*******************************************************************************
+ * Bus statistics
+ ******************************************************************************/
+typedef struct
+{
+    uint32_t selects;               // chip select assertions
+    uint32_t bytes;                 // bytes shifted
+    uint32_t unselected;            // bytes shifted with no device selected
+    uint32_t conflicts;             // bytes with several devices selected
+    uint32_t modeErrors;            // bytes in the wrong mode or too fast
+    uint32_t overruns;              // bytes lost to a full receive buffer
+    uint64_t busy;                  // cycles spent shifting
+} SIM_SPI_STATS;
+
+/*******************************************************************************
+ * Function Prototypes
+ ******************************************************************************/
+void Sim_SPI_Init(void);
+void Sim_SPI_Attach(SIM_SPI_DEVICE *dev);
+void Sim_SPI_Detach(SIM_SPI_DEVICE *dev);
+const SIM_SPI_STATS *Sim_SPI_Stats(void);
+void Sim_SPI_StatsReset(void);
+uint32_t Sim_SPI_ByteCycles(void);
+
+// Register access hooks used by xc.h
+void Sim_SPI2_Sync(void);
+volatile unsigned int *Sim_SPI2_Buffer(void);
+
+// SPI2BUF as seen by the DMA simulation
+void Sim_SPI2_DmaWrite(uint8_t data);
+uint8_t Sim_SPI2_DmaRead(void);
+
+#endif  // SIM_SPI_H
@@ -0,0 +1,334 @@
+/*******************************************************************************
+ * File: xc.h
+ * Author: Armstrong Subero
+ * PIC: None, Linux host build of the firmware
+ * Compiler: gcc (C99 with GNU extensions)
+ * Program Version: 1.0
+ *
+ * Program Description: Stands in for the XC16 device header on the host.
+ *                      Special function registers are plain variables, those of
+ *                      simulated peripherals are reached through a sync call so
+ *                      the peripheral sees every access. Bit positions follow
+ *                      the dsPIC33EP datasheet, only fields used by the
+ *                      firmware are named.
+ *
+ * Hardware Description: None
+ *
+ * Created October 19th, 2026, 9:00 AM
+ *
+ *
+ * License:
+ *
+ * "Copyright (c) 2017 Armstrong Subero ("AUTHORS")"
+ * All rights reserved.
+ *
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation for any purpose, without fee, and without written agreement is
+ * hereby granted, provided that the above copyright notice, the following
+ * two paragraphs and the authors appear in all copies of this software.
+ *
+ * IN NO EVENT SHALL THE "AUTHORS" BE LIABLE TO ANY PARTY FOR
+ * DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT
+ * OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE "AUTHORS"
+ * HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * THE "AUTHORS" SPECIFICALLY DISCLAIMS ANY WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS FOR A PARTICULAR PURPOSE.  THE SOFTWARE PROVIDED HEREUNDER IS
+ * ON AN "AS IS" BASIS, AND THE "AUTHORS" HAS NO OBLIGATION TO
+ * PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
+ *
+ * Please maintain this header in its entirety when copying/modifying
+ * these files.
+ *
+ ******************************************************************************/
+#ifndef SIM_XC_H
+#define SIM_XC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Sim.h"
+#include "Sim_I2C.h"
+#include "Sim_SPI.h"
+#include "Sim_DMA.h"
+
+// XC16 attributes with no host meaning
+#define interrupt
+#define no_auto_psv
+
+#ifdef SIM_DEFINE_SFRS
+#define SIM_REG(name)   volatile unsigned int SIM_##name
+#else
+#define SIM_REG(name)   extern volatile unsigned int SIM_##name
+#endif
+
+// Register and bit field access, sync runs before the access
+#define SIM_SFR(name, sync)             (*((sync), &SIM_##name))
+#define SIM_SFRBITS(name, type, sync) \
+    (*((sync), (volatile type *)&SIM_##name))
+
+// Port registers stay plain, drivers keep pointers to them
+#define SIM_PORT(name)                  SIM_##name
+#define SIM_PORTBITS(name, type)        (*(volatile type *)&SIM_##name)
+
+/*******************************************************************************
+ * Bit field layouts
+ ******************************************************************************/
+typedef struct
+{
+    unsigned SEN:1; unsigned RSEN:1; unsigned PEN:1; unsigned RCEN:1;
+    unsigned ACKEN:1; unsigned ACKDT:1; unsigned STREN:1; unsigned GCEN:1;
+    unsigned SMEN:1; unsigned DISSLW:1; unsigned A10M:1; unsigned IPMIEN:1;
+    unsigned SCLREL:1; unsigned I2CSIDL:1; unsigned :1; unsigned I2CEN:1;
+} I2C1CONBITS;
+
+typedef struct
+{
+    unsigned TBF:1; unsigned RBF:1; unsigned R_W:1; unsigned S:1;
+    unsigned P:1; unsigned D_A:1; unsigned I2COV:1; unsigned IWCOL:1;
+    unsigned ADD10:1; unsigned GCSTAT:1; unsigned BCL:1; unsigned :3;
+    unsigned TRSTAT:1; unsigned ACKSTAT:1;
+} I2C1STATBITS;
+
+typedef struct
+{
+    unsigned SPIRBF:1; unsigned SPITBF:1; unsigned SISEL:3; unsigned SRXMPT:1;
+    unsigned SPIROV:1; unsigned SRMPT:1; unsigned SPIBEC:3; unsigned :2;
+    unsigned SPISIDL:1; unsigned :1; unsigned SPIEN:1;
+} SPI2STATBITS;
+
+typedef struct
+{
+    unsigned PPRE:2; unsigned SPRE:3; unsigned MSTEN:1; unsigned CKP:1;
+    unsigned SSEN:1; unsigned CKE:1; unsigned SMP:1; unsigned MODE16:1;
+    unsigned DISSDO:1; unsigned DISSCK:1;
+} SPI2CON1BITS;
+
+typedef struct
+{
+    unsigned SPIBEN:1; unsigned FRMDLY:1; unsigned :11; unsigned FRMPOL:1;
+    unsigned SPIFSD:1; unsigned FRMEN:1;
+} SPI2CON2BITS;
+
+typedef struct
+{
+    unsigned MODE:2; unsigned :2; unsigned AMODE:2; unsigned :5;
+    unsigned NULLW:1; unsigned HALF:1; unsigned DIR:1; unsigned SIZE:1;
+    unsigned CHEN:1;
+} DMACONBITS;
+
+typedef struct
+{
+    unsigned IRQSEL:8; unsigned :7; unsigned FORCE:1;
+} DMAREQBITS;
+
+typedef struct
+{
+    unsigned INT0IF:1; unsigned IC1IF:1; unsigned OC1IF:1; unsigned T1IF:1;
+    unsigned DMA0IF:1; unsigned IC2IF:1; unsigned OC2IF:1; unsigned T2IF:1;
+    unsigned T3IF:1; unsigned SPI1EIF:1; unsigned SPI1IF:1; unsigned U1RXIF:1;
+    unsigned U1TXIF:1; unsigned AD1IF:1; unsigned DMA1IF:1; unsigned NVMIF:1;
+} IFS0BITS;
+
+typedef struct
+{
+    unsigned INT0IE:1; unsigned IC1IE:1; unsigned OC1IE:1; unsigned T1IE:1;
+    unsigned DMA0IE:1; unsigned IC2IE:1; unsigned OC2IE:1; unsigned T2IE:1;
+    unsigned T3IE:1; unsigned SPI1EIE:1; unsigned SPI1IE:1; unsigned U1RXIE:1;
+    unsigned U1TXIE:1; unsigned AD1IE:1; unsigned DMA1IE:1; unsigned NVMIE:1;
+} IEC0BITS;
+
+typedef struct
+{
+    unsigned SI2C1IF:1; unsigned MI2C1IF:1; unsigned CMIF:1; unsigned CNIF:1;
+    unsigned INT1IF:1; unsigned :3; unsigned DMA2IF:1;
+} IFS1BITS;
+
+typedef struct
+{
+    unsigned SI2C1IE:1; unsigned MI2C1IE:1; unsigned CMIE:1; unsigned CNIE:1;
+    unsigned INT1IE:1; unsigned :3; unsigned DMA2IE:1;
+} IEC1BITS;
+
+typedef struct
+{
+    unsigned U1TXIP:3; unsigned :1; unsigned AD1IP:3; unsigned :1;
+    unsigned DMA1IP:3; unsigned :1; unsigned NVMIP:3;
+} IPC3BITS;
+
+typedef struct
+{
+    unsigned POR:1; unsigned BOR:1; unsigned IDLE:1; unsigned SLEEP:1;
+    unsigned WDTO:1; unsigned SWDTEN:1; unsigned SWR:1; unsigned EXTR:1;
+    unsigned VREGS:1; unsigned CM:1; unsigned :1; unsigned VREGSF:1;
+    unsigned :2; unsigned IOPUWR:1; unsigned TRAPR:1;
+} RCONBITS;
+
+typedef struct
+{
+    unsigned URXDA:1; unsigned OERR:1; unsigned FERR:1; unsigned PERR:1;
+    unsigned RIDLE:1; unsigned ADDEN:1; unsigned URXISEL:2; unsigned TRMT:1;
+    unsigned UTXBF:1; unsigned UTXEN:1; unsigned UTXBRK:1;
+} U1STABITS;
+
+typedef struct
+{
+    unsigned DONE:1; unsigned SAMP:1; unsigned ASAM:1; unsigned SIMSAM:1;
+    unsigned SSRCG:1; unsigned SSRC:3; unsigned FORM:2; unsigned AD12B:1;
+    unsigned :1; unsigned ADDMABM:1; unsigned ADSIDL:1; unsigned :1;
+    unsigned ADON:1;
+} AD1CON1BITS;
+
+typedef struct
+{
+    unsigned ALTS:1; unsigned BUFM:1; unsigned SMPI:5; unsigned BUFS:1;
+    unsigned CHPS:2; unsigned CSCNA:1; unsigned :2; unsigned VCFG:3;
+} AD1CON2BITS;
+
+typedef struct
+{
+    unsigned ADCS:8; unsigned SAMC:5; unsigned :2; unsigned ADRC:1;
+} AD1CON3BITS;
+
+typedef struct
+{
+    unsigned CH0SA:5; unsigned :2; unsigned CH0NA:1; unsigned CH0SB:5;
+    unsigned :2; unsigned CH0NB:1;
+} AD1CHS0BITS;
+
+typedef struct
+{
+    unsigned CH123SA:1; unsigned CH123NA:2; unsigned :5; unsigned CH123SB:1;
+    unsigned CH123NB:2;
+} AD1CHS123BITS;
+
+typedef struct
+{
+    unsigned LATB0:1; unsigned LATB1:1; unsigned LATB2:1; unsigned LATB3:1;
+    unsigned LATB4:1; unsigned LATB5:1; unsigned LATB6:1; unsigned LATB7:1;
+    unsigned LATB8:1; unsigned LATB9:1; unsigned LATB10:1; unsigned LATB11:1;
+    unsigned LATB12:1; unsigned LATB13:1; unsigned LATB14:1; unsigned LATB15:1;
+} LATBBITS;
+
+typedef struct
+{
+    unsigned TRISB0:1; unsigned TRISB1:1; unsigned TRISB2:1;
+    unsigned TRISB3:1; unsigned TRISB4:1; unsigned TRISB5:1;
+    unsigned TRISB6:1; unsigned TRISB7:1; unsigned TRISB8:1;
+    unsigned TRISB9:1; unsigned TRISB10:1; unsigned TRISB11:1;
+    unsigned TRISB12:1; unsigned TRISB13:1; unsigned TRISB14:1;
+    unsigned TRISB15:1;
+} TRISBBITS;
+
+/*******************************************************************************
+ * Register storage
+ ******************************************************************************/
+SIM_REG(I2C1CON); SIM_REG(I2C1STAT); SIM_REG(I2C1BRG);
+SIM_REG(I2C1TRN); SIM_REG(I2C1RCV);
+SIM_REG(SPI2CON1); SIM_REG(SPI2CON2); SIM_REG(SPI2STAT); SIM_REG(SPI2BUF);
+SIM_REG(DMA0CON); SIM_REG(DMA0REQ); SIM_REG(DMA0STAL); SIM_REG(DMA0STAH);
+SIM_REG(DMA0PAD); SIM_REG(DMA0CNT);
+SIM_REG(DMA1CON); SIM_REG(DMA1REQ); SIM_REG(DMA1STAL); SIM_REG(DMA1STAH);
+SIM_REG(DMA1PAD); SIM_REG(DMA1CNT);
+SIM_REG(IFS0); SIM_REG(IFS1); SIM_REG(IEC0); SIM_REG(IEC1); SIM_REG(IPC3);
+SIM_REG(RCON); SIM_REG(CORCON); SIM_REG(U1STA); SIM_REG(U1TXREG);
+SIM_REG(AD1CON1); SIM_REG(AD1CON2); SIM_REG(AD1CON3);
+SIM_REG(AD1CHS0); SIM_REG(AD1CHS123);
+SIM_REG(ADC1BUF0); SIM_REG(ADC1BUF1); SIM_REG(ADC1BUF2); SIM_REG(ADC1BUF3);
+SIM_REG(LATA); SIM_REG(LATB); SIM_REG(TRISA); SIM_REG(TRISB);
+SIM_REG(PORTA); SIM_REG(PORTB);
+
+/*******************************************************************************
+ * Register names as used by the firmware
+ ******************************************************************************/
+#define I2C1CON         SIM_SFR(I2C1CON, Sim_I2C1_Sync())
+#define I2C1CONbits     SIM_SFRBITS(I2C1CON, I2C1CONBITS, Sim_I2C1_Sync())
+#define I2C1STAT        SIM_SFR(I2C1STAT, Sim_I2C1_Sync())
+#define I2C1STATbits    SIM_SFRBITS(I2C1STAT, I2C1STATBITS, Sim_I2C1_Sync())
+#define I2C1BRG         SIM_SFR(I2C1BRG, Sim_I2C1_Sync())
+#define I2C1TRN         SIM_SFR(I2C1TRN, Sim_I2C1_Sync())
+#define I2C1RCV         (*Sim_I2C1_Receive())
+
+#define SPI2CON1        SIM_SFR(SPI2CON1, Sim_SPI2_Sync())
+#define SPI2CON1bits    SIM_SFRBITS(SPI2CON1, SPI2CON1BITS, Sim_SPI2_Sync())
+#define SPI2CON2        SIM_SFR(SPI2CON2, Sim_SPI2_Sync())
+#define SPI2CON2bits    SIM_SFRBITS(SPI2CON2, SPI2CON2BITS, Sim_SPI2_Sync())
+#define SPI2STAT        SIM_SFR(SPI2STAT, Sim_SPI2_Sync())
+#define SPI2STATbits    SIM_SFRBITS(SPI2STAT, SPI2STATBITS, Sim_SPI2_Sync())
+#define SPI2BUF         (*Sim_SPI2_Buffer())
+
+#define DMA0CON         SIM_SFR(DMA0CON, Sim_Tick())
+#define DMA0CONbits     SIM_SFRBITS(DMA0CON, DMACONBITS, Sim_Tick())
+#define DMA0REQ         SIM_SFR(DMA0REQ, Sim_Tick())
+#define DMA0REQbits     SIM_SFRBITS(DMA0REQ, DMAREQBITS, Sim_Tick())
+#define DMA0STAL        SIM_SFR(DMA0STAL, Sim_Tick())
+#define DMA0STAH        SIM_SFR(DMA0STAH, Sim_Tick())
+#define DMA0PAD         SIM_SFR(DMA0PAD, Sim_Tick())
+#define DMA0CNT         SIM_SFR(DMA0CNT, Sim_Tick())
+#define DMA1CON         SIM_SFR(DMA1CON, Sim_Tick())
+#define DMA1CONbits     SIM_SFRBITS(DMA1CON, DMACONBITS, Sim_Tick())
+#define DMA1REQ         SIM_SFR(DMA1REQ, Sim_Tick())
+#define DMA1REQbits     SIM_SFRBITS(DMA1REQ, DMAREQBITS, Sim_Tick())
+#define DMA1STAL        SIM_SFR(DMA1STAL, Sim_Tick())
+#define DMA1STAH        SIM_SFR(DMA1STAH, Sim_Tick())
+#define DMA1PAD         SIM_SFR(DMA1PAD, Sim_Tick())
+#define DMA1CNT         SIM_SFR(DMA1CNT, Sim_Tick())
+
+#define IFS0            SIM_SFR(IFS0, Sim_Tick())
+#define IFS0bits        SIM_SFRBITS(IFS0, IFS0BITS, Sim_Tick())
+#define IFS1            SIM_SFR(IFS1, Sim_Tick())
+#define IFS1bits        SIM_SFRBITS(IFS1, IFS1BITS, Sim_Tick())
+#define IEC0            SIM_SFR(IEC0, Sim_Tick())
+#define IEC0bits        SIM_SFRBITS(IEC0, IEC0BITS, Sim_Tick())
+#define IEC1            SIM_SFR(IEC1, Sim_Tick())
+#define IEC1bits        SIM_SFRBITS(IEC1, IEC1BITS, Sim_Tick())
+#define IPC3            SIM_SFR(IPC3, Sim_Tick())
+#define IPC3bits        SIM_SFRBITS(IPC3, IPC3BITS, Sim_Tick())
+
+#define RCON            SIM_SFR(RCON, Sim_Tick())
+#define RCONbits        SIM_SFRBITS(RCON, RCONBITS, Sim_Tick())
+#define CORCON          SIM_SFR(CORCON, Sim_Tick())
+#define U1STA           SIM_SFR(U1STA, Sim_Tick())
+#define U1STAbits       SIM_SFRBITS(U1STA, U1STABITS, Sim_Tick())
+#define U1TXREG         SIM_SFR(U1TXREG, Sim_Tick())
+
+#define AD1CON1         SIM_SFR(AD1CON1, Sim_Tick())
+#define AD1CON1bits     SIM_SFRBITS(AD1CON1, AD1CON1BITS, Sim_Tick())
+#define AD1CON2         SIM_SFR(AD1CON2, Sim_Tick())
+#define AD1CON2bits     SIM_SFRBITS(AD1CON2, AD1CON2BITS, Sim_Tick())
+#define AD1CON3         SIM_SFR(AD1CON3, Sim_Tick())
+#define AD1CON3bits     SIM_SFRBITS(AD1CON3, AD1CON3BITS, Sim_Tick())
+#define AD1CHS0         SIM_SFR(AD1CHS0, Sim_Tick())
+#define AD1CHS0bits     SIM_SFRBITS(AD1CHS0, AD1CHS0BITS, Sim_Tick())
+#define AD1CHS123       SIM_SFR(AD1CHS123, Sim_Tick())
+#define AD1CHS123bits   SIM_SFRBITS(AD1CHS123, AD1CHS123BITS, Sim_Tick())
+#define ADC1BUF0        SIM_SFR(ADC1BUF0, Sim_Tick())
+#define ADC1BUF1        SIM_SFR(ADC1BUF1, Sim_Tick())
+#define ADC1BUF2        SIM_SFR(ADC1BUF2, Sim_Tick())
+#define ADC1BUF3        SIM_SFR(ADC1BUF3, Sim_Tick())
+
+#define LATA            SIM_PORT(LATA)
+#define LATB            SIM_PORT(LATB)
+#define LATBbits        SIM_PORTBITS(LATB, LATBBITS)
+#define TRISA           SIM_PORT(TRISA)
+#define TRISB           SIM_PORT(TRISB)
+#define TRISBbits       SIM_PORTBITS(TRISB, TRISBBITS)
+#define PORTA           SIM_PORT(PORTA)
+#define PORTB           SIM_PORT(PORTB)
+
+#define _AD1IP          IPC3bits.AD1IP
+#define _SWDTEN         RCONbits.SWDTEN
+
+/*******************************************************************************
+ * Instructions and builtins
+ ******************************************************************************/
+#define Nop()                           Sim_Tick()
+#define ClrWdt()                        Sim_ClrWdt()
+#define Idle()                          Sim_Idle()
+#define Sleep()                         Sim_Sleep()
+#define __builtin_enable_interrupts()   Sim_Interrupts(true)
+#define __builtin_disable_interrupts()  Sim_Interrupts(false)
+#define __builtin_disi(n)               ((void)(n))
+#define __DEVID_BASE                    0xFF0000
+
+#endif  // SIM_XC_H
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""
+Decode bus trace dumps captured from UART1 (see Bus_Trace.h).
+
+The firmware sends a "BTRC" header followed by up to BUS_TRACE_DUMP_RECORDS
+fixed size records, oldest first, on every logging task run when built with
+BUS_TRACE_ENABLE=1. Capture the serial stream to a file (the dumps are mixed
+with the normal printf text) and run:
+
+    python3 bus_trace_decode.py capture.bin
+
+Prints a timeline of every transaction followed by a per-device utilisation
+summary.
+"""
+
+import struct
+import sys
+
+HEADER = struct.Struct('<4sBBHHI')   # magic, version, record size, count, dropped, tick Hz
+RECORD = struct.Struct('<IHHBBBb')   # start, duration, length, bus, device, direction, status
+
+BUSES = {0: 'I2C1', 1: 'SPI2'}
+DEVICES = {
+    (0, 0x3C): 'SSD1306',
+    (0, 0x50): '24LCxx',
+    (1, 0): 'DS1722',
+    (1, 1): 'FLASH',
+}
+
+
+def device_name(bus, device):
+    name = DEVICES.get((bus, device))
+    if name:
+        return name
+    return '0x%02X' % device if bus == 0 else 'cs%d' % device
+
+
+def parse(data):
+    """Yield (tick_hz, dropped, records) for every dump found in data."""
+    pos = data.find(b'BTRC')
+    while pos >= 0 and pos + HEADER.size <= len(data):
+        magic, version, size, count, dropped, tick_hz = HEADER.unpack_from(data, pos)
+        body = pos + HEADER.size
+        if version != 1 or size != RECORD.size or body + count * size > len(data):
+            pos = data.find(b'BTRC', pos + 1)
+            continue
+        records = [RECORD.unpack_from(data, body + i * size) for i in range(count)]
+        yield tick_hz, dropped, records
+        pos = data.find(b'BTRC', body + count * size)
+
+
+def main(path):
+    data = open(path, 'rb').read()
+
+    # Timestamps wrap modulo 2^32, unwrap them across all dumps
+    timeline = []
+    last = None
+    epoch = 0
+    tick_hz = None
+    dropped_total = 0
+    for hz, dropped, records in parse(data):
+        tick_hz = hz
+        dropped_total += dropped
+        for start, duration, length, bus, device, direction, status in records:
+            if last is not None and start < last and last - start > 1 << 31:
+                epoch += 1 << 32
+            last = start
+            timeline.append((epoch + start, duration, length, bus, device, direction, status))
+
+    if not timeline:
+        print('no trace dumps found')
+        return 1
+
+    us_per_tick = 1e6 / tick_hz
+    t0 = timeline[0][0]
+
+    print('%12s %10s  %-4s %-8s %-2s %5s %6s' %
+          ('start(us)', 'dur(us)', 'bus', 'device', 'rw', 'bytes', 'status'))
+    for start, duration, length, bus, device, direction, status in timeline:
+        print('%12.0f %10.0f  %-4s %-8s %-2s %5d %6d' %
+              ((start - t0) * us_per_tick, duration * us_per_tick,
+               BUSES.get(bus, '?'), device_name(bus, device),
+               'R' if direction else 'W', length, status))
+
+    span = (timeline[-1][0] + timeline[-1][1] - t0) * us_per_tick
+    usage = {}
+    for start, duration, length, bus, device, direction, status in timeline:
+        key = (bus, device)
+        n, busy, nbytes, errors = usage.get(key, (0, 0, 0, 0))
+        usage[key] = (n + 1, busy + duration, nbytes + length, errors + (status != 0))
+
+    print()
+    print('span %.1f ms, %d records, %d dropped' % (span / 1000, len(timeline), dropped_total))
+    print('%-4s %-8s %6s %10s %8s %8s %6s' %
+          ('bus', 'device', 'xfers', 'busy(ms)', 'util(%)', 'bytes', 'errors'))
+    for (bus, device), (n, busy, nbytes, errors) in sorted(usage.items()):
+        busy_us = busy * us_per_tick
+        print('%-4s %-8s %6d %10.2f %8.2f %8d %6d' %
+              (BUSES.get(bus, '?'), device_name(bus, device), n, busy_us / 1000,
+               100.0 * busy_us / span if span else 0.0, nbytes, errors))
+    return 0
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        print(__doc__)
+        sys.exit(2)
+    sys.exit(main(sys.argv[1]))
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""
+Build Lux_Cal_Table.h from calibration points (see Lux_Cal.h).
+
+Build the firmware with LUX_CAL_CAPTURE=1 and note the "LUXCAL <counts>"
+value printed at a few light levels next to a lux meter reading. Put the
+pairs in a text file, one "counts lux" pair per line (commas also work,
+lines starting with # are ignored), then run:
+
+    python3 lux_cal_table.py points.txt > ../Lux_Cal_Table.h
+
+The points are interpolated in log lux, which suits the photoresistor
+response, and resampled to the evenly spaced table the firmware uses.
+Below the first point the table falls linearly to 0 lux, above the last
+point the last segment is extended up to LUX_CAL_MAX.
+"""
+
+import math
+import sys
+
+SEGMENT_BITS = 5        # LUX_CAL_SEGMENT_BITS
+RESULT_BITS = 12        # ADC1_RESULT_BITS
+LUX_MAX = 65535         # LUX_CAL_MAX
+
+HEADER = """\
+/*******************************************************************************
+ * File: Lux_Cal_Table.h
+ *
+ * Program Description: Lux calibration table for this unit, see Lux_Cal.h.
+ *                      Generated by tools/lux_cal_table.py from:
+ *
+%s
+ ******************************************************************************/
+#ifndef LUX_CAL_TABLE_H
+#define LUX_CAL_TABLE_H
+
+// Lux at counts 0, 1/%d, 2/%d ... %d/%d of full scale
+#define LUX_CAL_TABLE                                                   \\
+{                                                                       \\
+%s
+}
+
+#endif  // LUX_CAL_TABLE_H
+"""
+
+
+def read_points(path):
+    points = {}
+    for line in open(path):
+        line = line.split('#')[0].replace(',', ' ').split()
+        if not line:
+            continue
+        counts, lux = int(line[0]), float(line[1])
+        if lux <= 0:
+            raise ValueError('lux must be positive: %s' % ' '.join(line))
+        points[counts] = lux
+    points = sorted(points.items())
+    if len(points) < 2:
+        raise ValueError('need at least two points')
+    for (c0, l0), (c1, l1) in zip(points, points[1:]):
+        if l1 < l0:
+            raise ValueError('lux must not fall as counts rise (%d, %d)' % (c0, c1))
+    return points
+
+
+def lux_at(points, counts):
+    if counts <= points[0][0]:
+        return points[0][1] * counts / points[0][0] if points[0][0] else points[0][1]
+    if counts >= points[-1][0]:
+        (c0, l0), (c1, l1) = points[-2], points[-1]
+    else:
+        for (c0, l0), (c1, l1) in zip(points, points[1:]):
+            if counts <= c1:
+                break
+    t = (counts - c0) / (c1 - c0)
+    return math.exp(math.log(l0) + t * (math.log(l1) - math.log(l0)))
+
+
+def main(path):
+    points = read_points(path)
+    step = 1 << (RESULT_BITS - SEGMENT_BITS)
+    segments = 1 << SEGMENT_BITS
+    table = [min(LUX_MAX, int(round(lux_at(points, i * step))))
+             for i in range(segments + 1)]
+
+    values = ['%6d' % v for v in table]
+    rows = []
+    for i in range(0, len(values), 8):
+        row = '  ' + ','.join(values[i:i + 8])
+        if i + 8 < len(values):
+            row += ','
+        rows.append(row.ljust(72) + '\\')
+    source = '\n'.join(' *                      %6d counts %10.1f lux' % p for p in points)
+
+    sys.stdout.write(HEADER % (source, segments, segments, segments, segments,
+                               '\n'.join(rows)))
+    return 0
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 2:
+        print(__doc__)
+        sys.exit(2)
+    sys.exit(main(sys.argv[1]))